@@ -9,7 +9,7 @@
 # =============================================================================
 
 # set which plots to generate
-plots = [0, 1, 2, 3, 4, 5]
+plots = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]
 
 # run macro for each option
 plots.each { |plot|
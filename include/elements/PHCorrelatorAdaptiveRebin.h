@@ -0,0 +1,200 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorAdaptiveRebin.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Adaptive rebinning to a target relative
+ *  uncertainty.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORADAPTIVEREBIN_H
+#define PHCORRELATORADAPTIVEREBIN_H
+
+// c++ utilities
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHist.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Adaptive rebinning
+  // ==========================================================================
+  /*! Rather than merging a fixed number of bins, merges
+   *  adjacent bins until each merged bin reaches a target
+   *  relative uncertainty (sqrt(sumw2) / |content|).
+   *
+   *  Edges are found in one pass over the bins: a merged
+   *  bin is closed as soon as it meets the target (or holds
+   *  the maximum number of bins), and a trailing remainder
+   *  which doesn't is folded into the last merged bin. When
+   *  several histograms are compared, the pass tracks all
+   *  of them at once and only closes a bin once every one
+   *  meets the target, so they all get the same binning.
+   *  Bins without any entries in a histogram don't hold up
+   *  the others. Histograms with different binnings can't
+   *  share edges, so they're left as is (with a warning).
+   *
+   *  Merged bins hold the sum of the bins that went into
+   *  them (see `Hist1D::Rebin(...)`), so spectra which were
+   *  normalized before merging need to be normalized again
+   *  (see `BaseRoutine::RebinCommon(...)`).
+   *
+   *  The shared instance (AdaptiveRebin::Global()) sets the
+   *  target used in the sweep; a target of 0 turns adaptive
+   *  rebinning off (see `BaseOutput::GetRebin(...)`).
+   */
+  class AdaptiveRebin {
+
+    private:
+
+      // data members
+      double m_target;    ///!< target relative uncertainty
+      int    m_maxMerge;  ///!< max no. of bins to merge (0 for no max)
+
+      // ----------------------------------------------------------------------
+      //! Check if a merged bin of every histogram meets the target
+      // ----------------------------------------------------------------------
+      bool MeetsTarget(
+        const std::vector<double>& sums,
+        const std::vector<double>& sumw2s,
+        const double target
+      ) const {
+
+        for (std::size_t ihst = 0; ihst < sums.size(); ++ihst) {
+          if (sumw2s[ihst] <= 0.) continue;
+          if (std::sqrt(sumw2s[ihst]) > target * std::fabs(sums[ihst])) return false;
+        }
+        return true;
+
+      }  // end 'MeetsTarget(std::vector<double>& x 2, double)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      double GetTarget()   const {return m_target;}
+      int    GetMaxMerge() const {return m_maxMerge;}
+      bool   IsOn()        const {return (m_target > 0.);}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetTarget(const double target) {m_target   = target;}
+      void SetMaxMerge(const int nmax)    {m_maxMerge = nmax;}
+
+      // ----------------------------------------------------------------------
+      //! Find common edges for a set of histograms
+      // ----------------------------------------------------------------------
+      /*! All histograms must share the same binning; if they
+       *  don't, no edges are returned.
+       *
+       *  \param hists  histograms to find edges for
+       *  \param target target relative uncertainty
+       */
+      Binning::Edges FindEdges(const std::vector<const Hist1D*>& hists, const double target) const {
+
+        if (hists.empty()) return Binning::Edges();
+        for (std::size_t ihst = 1; ihst < hists.size(); ++ihst) {
+          if (!hists[ihst] -> IsCompatible(*hists[0])) {
+            std::cerr << "WARNING: can't find common adaptive binning of " << hists[0] -> GetName()
+                      << " and " << hists[ihst] -> GetName() << ", binnings differ! Skipping."
+                      << std::endl;
+            return Binning::Edges();
+          }
+        }
+
+        const Binning::Edges& old   = hists[0] -> GetEdges();
+        const int             nbins = hists[0] -> GetNbins();
+
+        Binning::Edges      edges(1, old[0]);
+        std::vector<double> sums(hists.size(), 0.);
+        std::vector<double> sumw2s(hists.size(), 0.);
+        int                 nmerged = 0;
+        for (int ibin = 1; ibin <= nbins; ++ibin) {
+
+          for (std::size_t ihst = 0; ihst < hists.size(); ++ihst) {
+            sums[ihst]   += hists[ihst] -> Content()[ibin];
+            sumw2s[ihst] += hists[ihst] -> Sumw2()[ibin];
+          }
+          ++nmerged;
+
+          // close merged bin if it's good enough (or as big as allowed)
+          const bool full = (m_maxMerge > 0) && (nmerged >= m_maxMerge);
+          if (full || MeetsTarget(sums, sumw2s, target)) {
+            edges.push_back( old[ibin] );
+            sums.assign(hists.size(), 0.);
+            sumw2s.assign(hists.size(), 0.);
+            nmerged = 0;
+          }
+        }
+
+        // fold any remainder into last merged bin
+        if (nmerged > 0) {
+          if (edges.size() > 1) edges.pop_back();
+          edges.push_back( old[nbins] );
+        }
+        return edges;
+
+      }  // end 'FindEdges(std::vector<Hist1D*>&, double)'
+
+      // ----------------------------------------------------------------------
+      //! Rebin a set of histograms to common edges
+      // ----------------------------------------------------------------------
+      /*! \return false if no common edges were found (in which
+       *          case histograms are left as is)
+       */
+      bool Apply(std::vector<Hist1D*>& hists, const double target) const {
+
+        const std::vector<const Hist1D*> chists(hists.begin(), hists.end());
+        const Binning::Edges             edges = FindEdges(chists, target);
+        if (edges.empty()) return false;
+
+        for (std::size_t ihst = 0; ihst < hists.size(); ++ihst) {
+          hists[ihst] -> Rebin(edges);
+        }
+        return true;
+
+      }  // end 'Apply(std::vector<Hist1D*>&, double)'
+
+      // ----------------------------------------------------------------------
+      //! Rebin one histogram
+      // ----------------------------------------------------------------------
+      bool Apply(Hist1D& hist, const double target) const {
+
+        std::vector<Hist1D*> hists(1, &hist);
+        return Apply(hists, target);
+
+      }  // end 'Apply(Hist1D&, double)'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared rebinner
+      // ----------------------------------------------------------------------
+      static AdaptiveRebin& Global() {
+
+        static AdaptiveRebin rebin;
+        return rebin;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      AdaptiveRebin() : m_target(0.), m_maxMerge(0) {};
+      ~AdaptiveRebin() {};
+
+  };  // end AdaptiveRebin
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
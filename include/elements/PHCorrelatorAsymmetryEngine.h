@@ -0,0 +1,399 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorAsymmetryEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Single- and double-spin asymmetries of
+ *  spin-sorted spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORASYMMETRYENGINE_H
+#define PHCORRELATORASYMMETRYENGINE_H
+
+// c++ utilities
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotTools.h"
+#include "PHCorrelatorTable.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Spin asymmetry engine
+  // ==========================================================================
+  /*! Computes luminosity-weighted spin asymmetries,
+   *
+   *    A = (1 / P) (N+ - R N-) / (N+ + R N-),
+   *
+   *  of spin-sorted spectra. For single-spin asymmetries N+
+   *  and N- are the spectra with one beam polarized up and
+   *  down; for double-spin asymmetries they're the sums of
+   *  like-sign (++, --) and unlike-sign (+-, -+) spectra and
+   *  P is the product of the two beam polarizations. Errors
+   *  on the spectra and polarizations are propagated.
+   *
+   *  Asymmetries are queued (`AddSingle`, `AddDouble`) and
+   *  then computed together (`Compute`), each as a single
+   *  vectorized pass over its bins (see HistMath::Asymmetry).
+   *  Relative luminosities and polarizations are looked up
+   *  per fill group; groups without a calibration use R = 1
+   *  and P = 1. Every computed asymmetry is also recorded in
+   *  a columnar table (one row per bin).
+   */
+  class AsymmetryEngine {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Kinds of asymmetry
+      // ----------------------------------------------------------------------
+      enum Kind {Blue, Yellow, Double};
+
+      // ======================================================================
+      //! Relative luminosity and polarization of a fill group
+      // ======================================================================
+      struct Calibration {
+
+        // members
+        double lumi_blue;    ///!< R for blue single-spin asymmetries
+        double lumi_yell;    ///!< R for yellow single-spin asymmetries
+        double lumi_double;  ///!< R for double-spin asymmetries
+        double pol_blue;     ///!< blue beam polarization
+        double dpol_blue;    ///!< uncertainty on blue beam polarization
+        double pol_yell;     ///!< yellow beam polarization
+        double dpol_yell;    ///!< uncertainty on yellow beam polarization
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Calibration() {
+          lumi_blue   = 1.0;
+          lumi_yell   = 1.0;
+          lumi_double = 1.0;
+          pol_blue    = 1.0;
+          dpol_blue   = 0.0;
+          pol_yell    = 1.0;
+          dpol_yell   = 0.0;
+        };
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Calibration(
+          const double lumi_blue_arg,
+          const double lumi_yell_arg,
+          const double lumi_double_arg,
+          const double pol_blue_arg,
+          const double dpol_blue_arg,
+          const double pol_yell_arg,
+          const double dpol_yell_arg
+        ) {
+          lumi_blue   = lumi_blue_arg;
+          lumi_yell   = lumi_yell_arg;
+          lumi_double = lumi_double_arg;
+          pol_blue    = pol_blue_arg;
+          dpol_blue   = dpol_blue_arg;
+          pol_yell    = pol_yell_arg;
+          dpol_yell   = dpol_yell_arg;
+        }  // end ctor(double x 7)
+
+      };  // end Calibration
+
+    private:
+
+      // ======================================================================
+      //! A queued asymmetry
+      // ======================================================================
+      struct Request {
+        std::string name;   ///!< name of resulting histogram
+        Kind        kind;   ///!< kind of asymmetry
+        int         group;  ///!< fill group
+        Hist1D      plus;   ///!< N+ (or like-sign sum)
+        Hist1D      minus;  ///!< N- (or unlike-sign sum)
+      };
+
+      // data members
+      std::map<int, Calibration> m_calibs;   ///!< calibration of each fill group
+      std::vector<Request>       m_queue;    ///!< asymmetries left to compute
+      std::vector<Hist1D>        m_results;  ///!< computed asymmetries
+      Table                      m_table;    ///!< computed asymmetries, bin-by-bin
+
+      // ----------------------------------------------------------------------
+      //! Columns of results table
+      // ----------------------------------------------------------------------
+      static std::vector<std::string> Columns() {
+
+        std::vector<std::string> columns;
+        columns.push_back("kind");
+        columns.push_back("group");
+        columns.push_back("bin");
+        columns.push_back("xlow");
+        columns.push_back("xhigh");
+        columns.push_back("value");
+        columns.push_back("error");
+        return columns;
+
+      }  // end 'Columns()'
+
+      // ----------------------------------------------------------------------
+      //! Get luminosity, polarization, and its uncertainty for a request
+      // ----------------------------------------------------------------------
+      void GetFactors(const Request& request, double& lumi, double& pol, double& dpol) const {
+
+        const Calibration calib = GetCalibration(request.group);
+        switch (request.kind) {
+          case Yellow:
+            lumi = calib.lumi_yell;
+            pol  = calib.pol_yell;
+            dpol = calib.dpol_yell;
+            break;
+          case Double:
+            lumi = calib.lumi_double;
+            pol  = calib.pol_blue * calib.pol_yell;
+            dpol = std::sqrt(
+              (calib.dpol_blue * calib.pol_yell * calib.dpol_blue * calib.pol_yell) +
+              (calib.dpol_yell * calib.pol_blue * calib.dpol_yell * calib.pol_blue)
+            );
+            break;
+          default:
+            lumi = calib.lumi_blue;
+            pol  = calib.pol_blue;
+            dpol = calib.dpol_blue;
+            break;
+        }
+        return;
+
+      }  // end 'GetFactors(Request&, double& x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Check that spectra can be combined
+      // ----------------------------------------------------------------------
+      static void CheckBinning(const std::string& name, const Hist1D& lhs, const Hist1D& rhs) {
+
+        if (!lhs.IsCompatible(rhs)) {
+          std::cerr << "PANIC: spin states of " << name << " have different binning!\n"
+                    << "       " << lhs.GetName() << " vs. " << rhs.GetName()
+                    << std::endl;
+          Error::Raise("spin states of " + name + " have different binning");
+          assert(lhs.IsCompatible(rhs));
+        }
+        return;
+
+      }  // end 'CheckBinning(std::string&, Hist1D& x 2)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t  GetNQueued()                         const {return m_queue.size();}
+      std::size_t  GetNResults()                        const {return m_results.size();}
+      const Table& GetTable()                           const {return m_table;}
+      const Hist1D& GetResult(const std::size_t result) const {return m_results.at(result);}
+
+      // ----------------------------------------------------------------------
+      //! Set calibration of a fill group
+      // ----------------------------------------------------------------------
+      void SetCalibration(const int group, const Calibration& calib) {m_calibs[group] = calib;}
+
+      // ----------------------------------------------------------------------
+      //! Get calibration of a fill group
+      // ----------------------------------------------------------------------
+      Calibration GetCalibration(const int group) const {
+
+        std::map<int, Calibration>::const_iterator calib = m_calibs.find(group);
+        return (calib != m_calibs.end()) ? calib -> second : Calibration();
+
+      }  // end 'GetCalibration(int)'
+
+      // ----------------------------------------------------------------------
+      //! Queue a single-spin asymmetry
+      // ----------------------------------------------------------------------
+      /*! \param name  name of resulting histogram
+       *  \param kind  which beam (Blue or Yellow)
+       *  \param up    spectrum with that beam polarized up
+       *  \param down  spectrum with that beam polarized down
+       *  \param group fill group to take calibration from
+       */
+      void AddSingle(
+        const std::string& name,
+        const Kind kind,
+        const Hist1D& up,
+        const Hist1D& down,
+        const int group = 0
+      ) {
+
+        CheckBinning(name, up, down);
+
+        Request request;
+        request.name  = name;
+        request.kind  = kind;
+        request.group = group;
+        request.plus  = up;
+        request.minus = down;
+        m_queue.push_back(request);
+        return;
+
+      }  // end 'AddSingle(std::string&, Kind, Hist1D& x 2, int)'
+
+      // ----------------------------------------------------------------------
+      //! Queue a double-spin asymmetry
+      // ----------------------------------------------------------------------
+      /*! \param name  name of resulting histogram
+       *  \param upup  spectrum w/ blue up, yellow up
+       *  \param dndn  spectrum w/ blue down, yellow down
+       *  \param updn  spectrum w/ blue up, yellow down
+       *  \param dnup  spectrum w/ blue down, yellow up
+       *  \param group fill group to take calibration from
+       */
+      void AddDouble(
+        const std::string& name,
+        const Hist1D& upup,
+        const Hist1D& dndn,
+        const Hist1D& updn,
+        const Hist1D& dnup,
+        const int group = 0
+      ) {
+
+        CheckBinning(name, upup, dndn);
+        CheckBinning(name, upup, updn);
+        CheckBinning(name, upup, dnup);
+
+        Request request;
+        request.name  = name;
+        request.kind  = Double;
+        request.group = group;
+        request.plus  = Tools::AddHist1D(upup, dndn);
+        request.minus = Tools::AddHist1D(updn, dnup);
+        m_queue.push_back(request);
+        return;
+
+      }  // end 'AddDouble(std::string&, Hist1D& x 4, int)'
+
+      // ----------------------------------------------------------------------
+      //! Compute all queued asymmetries
+      // ----------------------------------------------------------------------
+      /*! Returns the index of the first new result; results
+       *  from earlier calls are kept until `ClearResults()`.
+       */
+      std::size_t Compute() {
+
+        const std::size_t first = m_results.size();
+        for (std::size_t ireq = 0; ireq < m_queue.size(); ++ireq) {
+
+          const Request& request = m_queue[ireq];
+
+          double lumi = 1.0;
+          double pol  = 1.0;
+          double dpol = 0.0;
+          GetFactors(request, lumi, pol, dpol);
+
+          // one pass over all bins (incl. under/overflow)
+          Hist1D asym(request.name, request.plus.GetTitle(), request.plus.GetEdges());
+          asym.SetXTitle( request.plus.GetXTitle() );
+          asym.SetYTitle("A");
+          HistMath::Asymmetry(
+            request.plus.Content(),
+            request.plus.Sumw2(),
+            request.minus.Content(),
+            request.minus.Sumw2(),
+            asym.Content(),
+            asym.Sumw2(),
+            request.plus.GetNbins() + 2,
+            lumi,
+            pol,
+            dpol
+          );
+
+          // record bin-by-bin
+          for (int ibin = 1; ibin <= asym.GetNbins(); ++ibin) {
+            std::vector<double> row;
+            row.push_back( (double) request.kind );
+            row.push_back( (double) request.group );
+            row.push_back( (double) ibin );
+            row.push_back( asym.GetBinning() -> GetBinLowEdge(ibin) );
+            row.push_back( asym.GetBinning() -> GetBinUpEdge(ibin) );
+            row.push_back( asym.GetBinContent(ibin) );
+            row.push_back( asym.GetBinError(ibin) );
+            m_table.AddRow(request.name, row);
+          }
+          m_results.push_back(asym);
+        }
+        m_queue.clear();
+        return first;
+
+      }  // end 'Compute()'
+
+      // ----------------------------------------------------------------------
+      //! Clear computed asymmetries (table is kept)
+      // ----------------------------------------------------------------------
+      /*! Wirings call this once they've written their results,
+       *  so results don't pile up over a sweep.
+       */
+      void ClearResults() {
+
+        m_results.clear();
+        return;
+
+      }  // end 'ClearResults()'
+
+      // ----------------------------------------------------------------------
+      //! Drop queued asymmetries which haven't been computed
+      // ----------------------------------------------------------------------
+      /*! Wirings call this before queueing, so that requests
+       *  left behind by a call which failed part way (see
+       *  `Error::Collect`) aren't computed with the next one.
+       */
+      void ClearQueue() {
+
+        m_queue.clear();
+        return;
+
+      }  // end 'ClearQueue()'
+
+      // ----------------------------------------------------------------------
+      //! Drop all queued and computed asymmetries
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_queue.clear();
+        m_results.clear();
+        m_table.Clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared engine
+      // ----------------------------------------------------------------------
+      static AsymmetryEngine& Global() {
+
+        static AsymmetryEngine engine;
+        return engine;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      AsymmetryEngine() : m_table(Columns()) {};
+      ~AsymmetryEngine() {};
+
+  };  // end AsymmetryEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
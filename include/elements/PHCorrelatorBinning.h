@@ -0,0 +1,389 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorBinning.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Interned axis binning descriptors.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORBINNING_H
+#define PHCORRELATORBINNING_H
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorParallel.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Axis binning
+  // ==========================================================================
+  /*! An immutable set of bin edges. Binnings are interned:
+   *  `Binning::Intern(...)` returns the same descriptor for
+   *  any two sets of edges that agree (to a relative 1e-10),
+   *  so checking whether two histograms have the same binning
+   *  is just a pointer compare.
+   *
+   *  Mappings between bins of two different binnings are also
+   *  cached (see `Binning::Map(...)`) so operations like ratios
+   *  of differently-binned histograms don't repeat per-bin
+   *  searches.
+   *
+   *  Descriptors live for the rest of the session. The registry
+   *  and the mapping cache are guarded by a mutex, so binnings
+   *  can be interned and mapped from any thread; descriptors
+   *  and cached maps never change once made, so they can be
+   *  read without it.
+   */
+  class Binning {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Convenient types
+      // ----------------------------------------------------------------------
+      typedef std::vector<double>                                        Edges;
+      typedef std::vector<int>                                           BinMap;
+      typedef std::map<int, std::vector<const Binning*> >                Registry;
+      typedef std::map<std::pair<const Binning*, const Binning*>, BinMap> MapCache;
+
+      // kinds of edge spacing
+      enum Spacing {Variable, Uniform, Log};
+
+    private:
+
+      // data members
+      Edges         m_edges;    ///!< bin edges (nbins + 1)
+      unsigned long m_hash;     ///!< hash of exact edge values
+      Spacing       m_spacing;  ///!< how edges are spaced
+      double        m_origin;   ///!< lower edge (or its log) for regular spacings
+      double        m_inverse;  ///!< inverse bin width (in log if log-spaced)
+
+      // ----------------------------------------------------------------------
+      //! Hash a set of edges
+      // ----------------------------------------------------------------------
+      /*! FNV-1a over the bytes of the edges. Used as a fast path
+       *  when interning; edges that only agree within tolerance
+       *  hash differently and fall back to a full comparison.
+       */
+      static unsigned long Hash(const Edges& edges) {
+
+        unsigned long hash = 2166136261UL;
+        for (std::size_t iedge = 0; iedge < edges.size(); ++iedge) {
+          unsigned char bytes[sizeof(double)];
+          std::memcpy(bytes, &edges[iedge], sizeof(double));
+          for (std::size_t ibyte = 0; ibyte < sizeof(double); ++ibyte) {
+            hash ^= bytes[ibyte];
+            hash *= 16777619UL;
+          }
+        }
+        return hash;
+
+      }  // end 'Hash(Edges&)'
+
+      // ----------------------------------------------------------------------
+      //! Check if edges agree within tolerance
+      // ----------------------------------------------------------------------
+      bool Matches(const Edges& edges) const {
+
+        if (edges.size() != m_edges.size()) return false;
+        for (std::size_t iedge = 0; iedge < m_edges.size(); ++iedge) {
+          const double diff  = std::fabs(edges[iedge] - m_edges[iedge]);
+          const double scale = std::max(std::fabs(m_edges[iedge]), 1.);
+          if (diff > (1.0e-10 * scale)) return false;
+        }
+        return true;
+
+      }  // end 'Matches(Edges&)'
+
+      // ----------------------------------------------------------------------
+      //! Access registry of interned binnings (keyed by no. of bins)
+      // ----------------------------------------------------------------------
+      static Registry& GetRegistry() {
+
+        static Registry registry;
+        return registry;
+
+      }  // end 'GetRegistry()'
+
+      // ----------------------------------------------------------------------
+      //! Access cache of bin mappings
+      // ----------------------------------------------------------------------
+      static MapCache& GetMapCache() {
+
+        static MapCache cache;
+        return cache;
+
+      }  // end 'GetMapCache()'
+
+      // ----------------------------------------------------------------------
+      //! Access mutex guarding registry and mapping cache
+      // ----------------------------------------------------------------------
+      static Parallel::Mutex& GetMutex() {
+
+        static Parallel::Mutex mutex;
+        return mutex;
+
+      }  // end 'GetMutex()'
+
+      // ----------------------------------------------------------------------
+      //! private ctor (use Intern)
+      // ----------------------------------------------------------------------
+      explicit Binning(const Edges& edges)
+        : m_edges(edges)
+        , m_hash(Hash(edges))
+        , m_spacing(Variable)
+        , m_origin(0.)
+        , m_inverse(0.)
+      {
+        DetectSpacing();
+      };
+
+      // ----------------------------------------------------------------------
+      //! Check if edges are uniformly spaced in x or log(x)
+      // ----------------------------------------------------------------------
+      void DetectSpacing() {
+
+        const int nbins = GetNbins();
+        if (nbins < 1) return;
+
+        // uniform in x?
+        const double width = (m_edges.back() - m_edges.front()) / nbins;
+        bool uniform = (width > 0.);
+        for (int iedge = 1; uniform && (iedge <= nbins); ++iedge) {
+          const double expect = m_edges.front() + (iedge * width);
+          uniform = (std::fabs(m_edges[iedge] - expect) <= (1.0e-9 * std::max(std::fabs(expect), width)));
+        }
+        if (uniform) {
+          m_spacing = Uniform;
+          m_origin  = m_edges.front();
+          m_inverse = 1. / width;
+          return;
+        }
+
+        // or uniform in log(x)?
+        if (m_edges.front() <= 0.) return;
+        const double lwidth = (std::log(m_edges.back()) - std::log(m_edges.front())) / nbins;
+        bool logarithmic = (lwidth > 0.);
+        for (int iedge = 1; logarithmic && (iedge <= nbins); ++iedge) {
+          const double expect = std::log(m_edges.front()) + (iedge * lwidth);
+          logarithmic = (std::fabs(std::log(m_edges[iedge]) - expect) <= (1.0e-9 * std::max(std::fabs(expect), lwidth)));
+        }
+        if (logarithmic) {
+          m_spacing = Log;
+          m_origin  = std::log(m_edges.front());
+          m_inverse = 1. / lwidth;
+        }
+        return;
+
+      }  // end 'DetectSpacing()'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      const Edges&  GetEdges()   const {return m_edges;}
+      unsigned long GetHash()    const {return m_hash;}
+      Spacing       GetSpacing() const {return m_spacing;}
+      int           GetNbins() const {return m_edges.empty() ? 0 : (int) m_edges.size() - 1;}
+
+      // ----------------------------------------------------------------------
+      //! Bin accessors
+      // ----------------------------------------------------------------------
+      double GetBinLowEdge(const int bin) const {return m_edges[bin - 1];}
+      double GetBinUpEdge(const int bin)  const {return m_edges[bin];}
+      double GetBinWidth(const int bin)   const {return m_edges[bin] - m_edges[bin - 1];}
+      double GetBinCenter(const int bin)  const {return 0.5 * (m_edges[bin] + m_edges[bin - 1]);}
+
+      // ----------------------------------------------------------------------
+      //! Find bin corresponding to a value
+      // ----------------------------------------------------------------------
+      /*! Returns 0 if below the axis and nbins + 1 if at or
+       *  above the upper edge, same as ROOT.
+       */
+      int FindBin(const double val) const {
+
+        if (m_edges.empty() || val < m_edges.front()) return 0;
+        if (val >= m_edges.back()) return GetNbins() + 1;
+        return (int) (std::upper_bound(m_edges.begin(), m_edges.end(), val) - m_edges.begin());
+
+      }  // end 'FindBin(double)'
+
+      // ----------------------------------------------------------------------
+      //! Find bins corresponding to a batch of values
+      // ----------------------------------------------------------------------
+      /*! Same result as `FindBin(...)` for each value (NaNs
+       *  go to the underflow for regular spacings). For
+       *  edges uniform in x or log(x), the bin is first
+       *  estimated arithmetically in a loop without branches
+       *  (so it vectorizes), then nudged by at most one bin
+       *  against the exact edges to undo rounding.
+       *
+       *  \param vals      values to look up
+       *  \param[out] bins bin of each value
+       *  \param nvals     no. of values
+       *  \param work      scratch space of at least nvals doubles
+       */
+      void FindBins(const double* vals, int* bins, const std::size_t nvals, double* work) const {
+
+        const int nbins = GetNbins();
+        if (m_spacing == Variable) {
+          for (std::size_t ival = 0; ival < nvals; ++ival) {
+            bins[ival] = FindBin(vals[ival]);
+          }
+          return;
+        }
+
+        // estimate (in units of bins from the lower edge)
+        if (m_spacing == Log) {
+          const double tiny = m_edges.front() * 0.5;
+          for (std::size_t ival = 0; ival < nvals; ++ival) {
+            work[ival] = (std::log(std::max(vals[ival], tiny)) - m_origin) * m_inverse;
+          }
+        } else {
+          for (std::size_t ival = 0; ival < nvals; ++ival) {
+            work[ival] = (vals[ival] - m_origin) * m_inverse;
+          }
+        }
+
+        // clamp into [0, nbins + 1] (NaN goes to 0), then
+        // correct against edges
+        const double upper = nbins + 1;
+        for (std::size_t ival = 0; ival < nvals; ++ival) {
+          const double est = (work[ival] >= 0.) ? std::min(work[ival] + 1., upper) : 0.;
+          bins[ival] = (int) est;
+        }
+        for (std::size_t ival = 0; ival < nvals; ++ival) {
+          int&         bin = bins[ival];
+          const double val = vals[ival];
+          if ((val < m_edges.front()) || (val != val)) {
+            bin = 0;
+          } else if (val >= m_edges.back()) {
+            bin = nbins + 1;
+          } else {
+            if (bin < 1)     bin = 1;
+            if (bin > nbins) bin = nbins;
+            if (val < m_edges[bin - 1]) --bin;
+            else if (val >= m_edges[bin]) ++bin;
+          }
+        }
+        return;
+
+      }  // end 'FindBins(double*, int*, std::size_t, double*)'
+
+      // ----------------------------------------------------------------------
+      //! Make uniformly-spaced edges
+      // ----------------------------------------------------------------------
+      static Edges MakeUniform(const int nbins, const double low, const double high) {
+
+        Edges edges(nbins + 1);
+        for (int iedge = 0; iedge <= nbins; ++iedge) {
+          edges[iedge] = low + (iedge * (high - low) / nbins);
+        }
+        return edges;
+
+      }  // end 'MakeUniform(int, double, double)'
+
+      // ----------------------------------------------------------------------
+      //! Make log-spaced edges
+      // ----------------------------------------------------------------------
+      static Edges MakeLog(const int nbins, const double low, const double high) {
+
+        Edges edges(nbins + 1);
+        const double step = (std::log10(high) - std::log10(low)) / nbins;
+        for (int iedge = 0; iedge <= nbins; ++iedge) {
+          edges[iedge] = std::pow(10., std::log10(low) + (iedge * step));
+        }
+        edges.back() = high;
+        return edges;
+
+      }  // end 'MakeLog(int, double, double)'
+
+      // ----------------------------------------------------------------------
+      //! Get interned descriptor for a set of edges
+      // ----------------------------------------------------------------------
+      static const Binning* Intern(const Edges& edges) {
+
+        Parallel::Lock              lock(GetMutex());
+        std::vector<const Binning*>& bucket = GetRegistry()[(int) edges.size()];
+
+        // check exact hashes first, then fall back to tolerance
+        const unsigned long hash = Hash(edges);
+        for (std::size_t ibin = 0; ibin < bucket.size(); ++ibin) {
+          if ((bucket[ibin] -> m_hash == hash) && (bucket[ibin] -> m_edges == edges)) {
+            return bucket[ibin];
+          }
+        }
+        for (std::size_t ibin = 0; ibin < bucket.size(); ++ibin) {
+          if (bucket[ibin] -> Matches(edges)) return bucket[ibin];
+        }
+
+        // otherwise register a new one
+        bucket.push_back( new Binning(edges) );
+        return bucket.back();
+
+      }  // end 'Intern(Edges&)'
+
+      // ----------------------------------------------------------------------
+      //! Get (cached) mapping from bins of one binning onto another
+      // ----------------------------------------------------------------------
+      /*! Entry i of the returned map is the bin of `to` that
+       *  contains the center of bin i of `from`. Under/overflow
+       *  map onto under/overflow.
+       */
+      static const BinMap& Map(const Binning* from, const Binning* to) {
+
+        Parallel::Lock lock(GetMutex());
+        MapCache&      cache = GetMapCache();
+        const std::pair<const Binning*, const Binning*> key = std::make_pair(from, to);
+
+        MapCache::iterator found = cache.find(key);
+        if (found != cache.end()) return found -> second;
+
+        BinMap& map = cache[key];
+        map.resize(from -> GetNbins() + 2);
+        map.front() = 0;
+        map.back()  = to -> GetNbins() + 1;
+        for (int ibin = 1; ibin <= from -> GetNbins(); ++ibin) {
+          map[ibin] = to -> FindBin( from -> GetBinCenter(ibin) );
+        }
+        return map;
+
+      }  // end 'Map(Binning*, Binning*)'
+
+      // ----------------------------------------------------------------------
+      //! Get no. of interned binnings
+      // ----------------------------------------------------------------------
+      static std::size_t GetNInterned() {
+
+        Parallel::Lock lock(GetMutex());
+        std::size_t    ninterned = 0;
+        for (Registry::const_iterator it = GetRegistry().begin(); it != GetRegistry().end(); ++it) {
+          ninterned += it -> second.size();
+        }
+        return ninterned;
+
+      }  // end 'GetNInterned()'
+
+      // ----------------------------------------------------------------------
+      //! default dtor
+      // ----------------------------------------------------------------------
+      ~Binning() {};
+
+  };  // end Binning
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,487 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorClosureEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Monte Carlo closure tests of the bin-by-bin
+ *  corrections.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCLOSUREENGINE_H
+#define PHCORRELATORCLOSUREENGINE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotOpts.h"
+#include "PHCorrelatorRandom.h"
+#include "PHCorrelatorReplicaEngine.h"
+#include "PHCorrelatorTable.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! A (sub)sample of simulation
+  // ==========================================================================
+  struct ClosureSample {
+
+    // members
+    Hist1D reco;   ///!< reco-level spectrum
+    Hist1D truth;  ///!< truth-level spectrum
+
+    // ------------------------------------------------------------------------
+    //! default ctor
+    // ------------------------------------------------------------------------
+    ClosureSample() {};
+
+    // ------------------------------------------------------------------------
+    //! ctor accepting arguments
+    // ------------------------------------------------------------------------
+    ClosureSample(const Hist1D& reco_arg, const Hist1D& truth_arg)
+      : reco(reco_arg), truth(truth_arg) {};
+
+  };  // end ClosureSample
+
+
+
+  // ==========================================================================
+  //! Non-closure from a set of trials
+  // ==========================================================================
+  struct ClosureResult {
+
+    // members
+    Hist1D      mean;     ///!< mean non-closure, with spread as its error
+    Hist1D      spread;   ///!< spread (RMS) of non-closure across trials
+    std::size_t ntrials;  ///!< no. of trials run
+
+    // ------------------------------------------------------------------------
+    //! default ctor
+    // ------------------------------------------------------------------------
+    ClosureResult() : ntrials(0) {};
+
+  };  // end ClosureResult
+
+
+
+  // ==========================================================================
+  //! Closure-test engine
+  // ==========================================================================
+  /*! Each trial derives correction factors from one half
+   *  of the simulation ("training") and applies them to the
+   *  reco-level spectrum of an independent half ("test"),
+   *  with the same chain as CorrectSpectra1D (see
+   *  CorrectionChain). The non-closure of a trial is then
+   *
+   *      (corrected test reco) / (test truth) - 1
+   *
+   *  after normalizing both. Halves are either
+   *    - pre-split: every ordered pair of independent
+   *      subsamples is a trial; or
+   *    - sub-sampled: the full sample is split into two
+   *      independent halves by Poisson thinning of each bin's
+   *      effective entries. Reco and truth are thinned with
+   *      their own random numbers: bin i of reco and bin i of
+   *      truth aren't the same events, so sharing draws would
+   *      only add a spurious correlation between them.
+   *
+   *  Trials run in parallel. Trial k always draws from random
+   *  stream (seed, k), so results don't depend on the number
+   *  of threads. Every run adds its per-bin summary to a table.
+   */
+  class ClosureEngine {
+
+    private:
+
+      // data members
+      PlotOpts      m_options;   ///!< normalization options
+      std::size_t   m_nTrials;   ///!< no. of trials when sub-sampling
+      std::size_t   m_nSplits;   ///!< no. of pre-split subsamples inputs come in (0 if sub-sampling)
+      unsigned long m_seed;      ///!< global seed
+      double        m_fraction;  ///!< fraction of sample used for training
+      Table         m_table;     ///!< non-closure of each run, bin-by-bin
+
+      // ======================================================================
+      //! Runs closure trials
+      // ======================================================================
+      class TrialTask : public Parallel::Task {
+
+        private:
+
+          const ClosureEngine*              m_engine;
+          const std::vector<ClosureSample>* m_samples;
+          bool                              m_split;
+          std::vector<double>*              m_values;
+          std::size_t                       m_ncells;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+
+            ClosureSample train;
+            ClosureSample test;
+            if (m_split) {
+              m_engine -> SubSample((*m_samples)[0], item, train, test);
+            } else {
+              m_engine -> PickPair(*m_samples, item, train, test);
+            }
+            m_engine -> Close(train, test, &(*m_values)[item * m_ncells]);
+
+          }  // end 'Run(std::size_t, std::size_t)'
+
+          TrialTask(
+            const ClosureEngine* engine,
+            const std::vector<ClosureSample>* samples,
+            const bool split,
+            std::vector<double>* values,
+            const std::size_t ncells
+          ) : m_engine(engine), m_samples(samples), m_split(split), m_values(values), m_ncells(ncells) {};
+
+      };  // end TrialTask
+      friend class TrialTask;
+
+      // ======================================================================
+      //! Runs every trial but the first
+      // ======================================================================
+      class SkipFirst : public Parallel::Task {
+
+        private:
+
+          TrialTask* m_task;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t thread) {
+            m_task -> Run(item + 1, thread);
+          }
+
+          explicit SkipFirst(TrialTask* task) : m_task(task) {};
+
+      };  // end SkipFirst
+
+      // ----------------------------------------------------------------------
+      //! Columns of results table
+      // ----------------------------------------------------------------------
+      static std::vector<std::string> Columns() {
+
+        std::vector<std::string> columns;
+        columns.push_back("ntrials");
+        columns.push_back("bin");
+        columns.push_back("xlow");
+        columns.push_back("xhigh");
+        columns.push_back("mean");
+        columns.push_back("spread");
+        columns.push_back("min");
+        columns.push_back("max");
+        return columns;
+
+      }  // end 'Columns()'
+
+      // ----------------------------------------------------------------------
+      //! Pick (training, test) halves of a pre-split trial
+      // ----------------------------------------------------------------------
+      /*! Trial k runs over ordered pairs (i, j) with i != j. */
+      void PickPair(
+        const std::vector<ClosureSample>& samples,
+        const std::size_t trial,
+        ClosureSample& train,
+        ClosureSample& test
+      ) const {
+
+        const std::size_t nsamples = samples.size();
+        const std::size_t itrain   = trial / (nsamples - 1);
+        const std::size_t offset   = (trial % (nsamples - 1)) + 1;
+        train = samples[itrain];
+        test  = samples[(itrain + offset) % nsamples];
+        return;
+
+      }  // end 'PickPair(std::vector<ClosureSample>&, std::size_t, ClosureSample& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Thin one spectrum into two independent halves
+      // ----------------------------------------------------------------------
+      void Thin(
+        const Hist1D& full,
+        const std::vector<double>& uniforms,
+        Hist1D& first,
+        Hist1D& second
+      ) const {
+
+        const std::size_t ncells = full.GetNcells();
+
+        first  = full;
+        second = full;
+        for (std::size_t icell = 0; icell < ncells; ++icell) {
+
+          const double content = full.GetBinContent(icell);
+          const double sumw2   = full.GetBinSumw2(icell);
+          if ((content <= 0.) || (sumw2 <= 0.)) continue;
+
+          const double neff   = (content * content) / sumw2;
+          const double weight = content / neff;
+          const double nfirst = Random::InversePoisson(uniforms[icell], neff * m_fraction);
+          const double nsecnd = Random::InversePoisson(uniforms[ncells + icell], neff * (1. - m_fraction));
+          first.SetBinContent(icell, nfirst * weight);
+          first.SetBinSumw2(icell, nfirst * weight * weight);
+          second.SetBinContent(icell, nsecnd * weight);
+          second.SetBinSumw2(icell, nsecnd * weight * weight);
+        }
+        return;
+
+      }  // end 'Thin(Hist1D&, std::vector<double>&, Hist1D& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Split the full sample into (training, test) halves
+      // ----------------------------------------------------------------------
+      void SubSample(
+        const ClosureSample& full,
+        const std::size_t trial,
+        ClosureSample& train,
+        ClosureSample& test
+      ) const {
+
+        RandomStream stream(m_seed, trial);
+
+        // reco & truth each get their own draws
+        std::vector<double> recoUniforms(2 * full.reco.GetNcells());
+        std::vector<double> trueUniforms(2 * full.truth.GetNcells());
+        stream.FillUniform(&recoUniforms[0], recoUniforms.size());
+        stream.FillUniform(&trueUniforms[0], trueUniforms.size());
+
+        Thin(full.reco, recoUniforms, train.reco, test.reco);
+        Thin(full.truth, trueUniforms, train.truth, test.truth);
+        return;
+
+      }  // end 'SubSample(ClosureSample&, std::size_t, ClosureSample& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Run one trial, writing non-closure of each cell to out
+      // ----------------------------------------------------------------------
+      /*! Cells without test truth are set to NaN. */
+      void Close(const ClosureSample& train, const ClosureSample& test, double* out) const {
+
+        const CorrectionChain correct(m_options);
+        const RatioChain      compare(m_options);
+
+        std::vector<Hist1D> inputs;
+        inputs.push_back(test.reco);
+        inputs.push_back(train.reco);
+        inputs.push_back(train.truth);
+
+        std::vector<Hist1D> pair;
+        pair.push_back( correct.Evaluate(inputs) );
+        pair.push_back(test.truth);
+
+        const Hist1D ratio = compare.Evaluate(pair);
+        for (int icell = 0; icell < ratio.GetNcells(); ++icell) {
+          out[icell] = (test.truth.GetBinContent(icell) > 0.)
+                     ? ratio.GetBinContent(icell) - 1.
+                     : std::numeric_limits<double>::quiet_NaN();
+        }
+        return;
+
+      }  // end 'Close(ClosureSample& x 2, double*)'
+
+      // ----------------------------------------------------------------------
+      //! Run trials and summarize them
+      // ----------------------------------------------------------------------
+      ClosureResult Run(
+        const std::string& name,
+        const std::vector<ClosureSample>& samples,
+        const bool split,
+        const std::size_t ntrials,
+        const std::size_t nthreads
+      ) {
+
+        for (std::size_t isam = 0; isam < samples.size(); ++isam) {
+          if ((samples[isam].reco.GetNcells() != samples[0].reco.GetNcells()) ||
+              (samples[isam].truth.GetNcells() != samples[0].reco.GetNcells())) {
+            std::cerr << "PANIC: closure samples of " << name << " have different no. of bins!" << std::endl;
+            Error::Raise("closure samples of '" + name + "' have different no. of bins");
+            assert(false);
+          }
+        }
+
+        // run first trial on calling thread (which fills any
+        // caches the chains rely on), then the rest in parallel
+        const std::size_t   ncells = samples[0].truth.GetNcells();
+        std::vector<double> values(ntrials * ncells, 0.);
+
+        TrialTask task(this, &samples, split, &values, ncells);
+        task.Run(0, 0);
+        if (ntrials > 1) {
+          SkipFirst skip(&task);
+          Parallel::For(skip, ntrials - 1, nthreads);
+        }
+
+        // summarize trials bin-by-bin
+        ClosureResult result;
+        result.ntrials = ntrials;
+        result.mean    = samples[0].truth;
+        result.spread  = samples[0].truth;
+        result.mean.Reset();
+        result.spread.Reset();
+        result.mean.SetName(name + "_NonClosure");
+        result.spread.SetName(name + "_NonClosureSpread");
+        result.mean.SetYTitle("non-closure");
+        result.spread.SetYTitle("spread of non-closure");
+
+        for (std::size_t icell = 0; icell < ncells; ++icell) {
+
+          double sum  = 0.;
+          double sum2 = 0.;
+          double low  = std::numeric_limits<double>::max();
+          double high = -std::numeric_limits<double>::max();
+          std::size_t nused = 0;
+          for (std::size_t itrial = 0; itrial < ntrials; ++itrial) {
+            const double value = values[(itrial * ncells) + icell];
+            if (value != value) continue;
+            sum  += value;
+            sum2 += value * value;
+            low   = std::min(low, value);
+            high  = std::max(high, value);
+            ++nused;
+          }
+          if (nused == 0) continue;
+
+          const double mean = sum / nused;
+          const double rms  = std::sqrt( std::max(0., (sum2 / nused) - (mean * mean)) );
+          result.mean.SetBinContent(icell, mean);
+          result.mean.SetBinError(icell, rms);
+          result.spread.SetBinContent(icell, rms);
+
+          // record bin-by-bin (skipping under/overflow)
+          if ((icell == 0) || (icell == ncells - 1)) continue;
+
+          std::vector<double> row;
+          row.push_back( (double) nused );
+          row.push_back( (double) icell );
+          row.push_back( result.mean.GetBinLowEdge(icell) );
+          row.push_back( result.mean.GetBinUpEdge(icell) );
+          row.push_back(mean);
+          row.push_back(rms);
+          row.push_back(low);
+          row.push_back(high);
+          m_table.AddRow(name, row);
+        }
+        return result;
+
+      }  // end 'Run(std::string&, std::vector<ClosureSample>&, bool, std::size_t x 2)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      const PlotOpts& GetOptions()  const {return m_options;}
+      std::size_t     GetNTrials()  const {return m_nTrials;}
+      std::size_t     GetNSplits()  const {return m_nSplits;}
+      unsigned long   GetSeed()     const {return m_seed;}
+      double          GetFraction() const {return m_fraction;}
+      const Table&    GetTable()    const {return m_table;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetOptions(const PlotOpts& options)    {m_options  = options;}
+      void SetNTrials(const std::size_t ntrials)  {m_nTrials  = ntrials;}
+      void SetNSplits(const std::size_t nsplits)  {m_nSplits  = nsplits;}
+      void SetSeed(const unsigned long seed)      {m_seed     = seed;}
+      void SetFraction(const double fraction)     {m_fraction = fraction;}
+
+      // ----------------------------------------------------------------------
+      //! Run closure trials on pre-split subsamples
+      // ----------------------------------------------------------------------
+      /*! Runs n (n - 1) trials for n subsamples.
+       *
+       *  \param name     name of outputs (and rows of table)
+       *  \param samples  statistically independent subsamples
+       *  \param nthreads maximum number of threads to use
+       */
+      ClosureResult RunPreSplit(
+        const std::string& name,
+        const std::vector<ClosureSample>& samples,
+        const std::size_t nthreads = Parallel::DefaultNThreads()
+      ) {
+
+        if (samples.size() < 2) {
+          std::cerr << "PANIC: closure test " << name << " needs at least 2 subsamples, got " << samples.size() << "!" << std::endl;
+          Error::Raise("closure test '" + name + "' needs at least 2 subsamples");
+          assert(samples.size() >= 2);
+        }
+        return Run(name, samples, false, samples.size() * (samples.size() - 1), nthreads);
+
+      }  // end 'RunPreSplit(std::string&, std::vector<ClosureSample>&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Run closure trials on random splits of a full sample
+      // ----------------------------------------------------------------------
+      /*! \param name     name of outputs (and rows of table)
+       *  \param full     full simulation sample
+       *  \param nthreads maximum number of threads to use
+       */
+      ClosureResult RunSubSampled(
+        const std::string& name,
+        const ClosureSample& full,
+        const std::size_t nthreads = Parallel::DefaultNThreads()
+      ) {
+
+        if (m_nTrials == 0) {
+          std::cerr << "PANIC: closure test " << name << " needs at least 1 trial!" << std::endl;
+          Error::Raise("closure test '" + name + "' needs at least 1 trial");
+          assert(m_nTrials > 0);
+        }
+        return Run(name, std::vector<ClosureSample>(1, full), true, m_nTrials, nthreads);
+
+      }  // end 'RunSubSampled(std::string&, ClosureSample&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Clear table of results
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_table.Clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared engine
+      // ----------------------------------------------------------------------
+      static ClosureEngine& Global() {
+
+        static ClosureEngine engine;
+        return engine;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ClosureEngine()
+        : m_nTrials(100)
+        , m_nSplits(0)
+        , m_seed(24680)
+        , m_fraction(0.5)
+        , m_table(Columns()) {};
+      ~ClosureEngine() {};
+
+  };  // end ClosureEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
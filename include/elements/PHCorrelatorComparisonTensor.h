@@ -0,0 +1,370 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorComparisonTensor.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Block of spectra over species, level, and jet pt
+ *  and batched ratios between them.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCOMPARISONTENSOR_H
+#define PHCORRELATORCOMPARISONTENSOR_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+// root libraries
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorLoadTools.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotInput.h"
+#include "PHCorrelatorPlotOpts.h"
+#include "PHCorrelatorPlotTools.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Comparison tensor
+  // ==========================================================================
+  /*! The sim vs. data, reco vs. data, vs. jet pt, and pp vs.
+   *  pAu comparisons are all ratios between spectra of one
+   *  variable at different (species, level, jet pt) for an
+   *  otherwise fixed index. This holds that whole block:
+   *  each slot is loaded (and rebinned and normalized) once,
+   *  then the block is packed into one contiguous
+   *  (slot x cell) tensor and every requested ratio is taken
+   *  in one batched pass with the HistMath kernels.
+   *
+   *  Plotting routines look up their inputs (and ratios)
+   *  here first via `Find(...)` and `FindRatio(...)`, so
+   *  wirings run after the block is filled pull their
+   *  canvases from the shared results instead of reloading.
+   *  Lookups match on file, object, rebinning, and
+   *  normalization, so anything else falls through to the
+   *  routine's own loading.
+   */
+  class ComparisonTensor {
+
+    public:
+
+      // ======================================================================
+      //! A slot of the block
+      // ======================================================================
+      struct Slot {
+
+        // members
+        int species;  ///!< species index
+        int level;    ///!< level index
+        int pt;       ///!< jet pt index
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Slot() : species(-1), level(-1), pt(-1) {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Slot(const int species_arg, const int level_arg, const int pt_arg)
+          : species(species_arg), level(level_arg), pt(pt_arg) {};
+
+        // --------------------------------------------------------------------
+        //! less-than operator (for use as a map key)
+        // --------------------------------------------------------------------
+        bool operator<(const Slot& rhs) const {
+
+          if (species != rhs.species) return (species < rhs.species);
+          if (level != rhs.level)     return (level < rhs.level);
+          return (pt < rhs.pt);
+
+        }  // end 'operator<(Slot&)'
+
+      };  // end Slot
+
+      // ----------------------------------------------------------------------
+      //! Convenient types
+      // ----------------------------------------------------------------------
+      typedef std::pair<std::size_t, std::size_t> Pair;  ///!< (numerator, denominator) positions
+
+    private:
+
+      // data members
+      PlotOpts                           m_options;  ///!< normalization used for every slot
+      std::map<Slot, std::size_t>        m_index;    ///!< position of each slot
+      std::map<std::string, std::size_t> m_keys;     ///!< position of each (file, object, rebin)
+      std::vector<Hist1D>                m_spectra;  ///!< spectrum of each slot
+      std::vector<Pair>                  m_pairs;    ///!< requested (numerator, denominator) positions
+      std::vector<Hist1D>                m_ratios;   ///!< ratio of each computed pair
+      std::size_t                        m_nLoads;   ///!< no. of spectra loaded from file
+
+      // ----------------------------------------------------------------------
+      //! Make lookup key of an input
+      // ----------------------------------------------------------------------
+      static std::string MakeKey(const PlotInput& input) {
+
+        const bool        fixed  = input.rebin.GetRebin() && !input.rebin.IsAdaptive();
+        const std::size_t nrebin = fixed ? input.rebin.GetNum() : 1;
+        return input.file + ":" + input.object + ":" + Tools::StringifyIndex(nrebin);
+
+      }  // end 'MakeKey(PlotInput&)'
+
+      // ----------------------------------------------------------------------
+      //! Check if normalization options match those of the block
+      // ----------------------------------------------------------------------
+      bool MatchesOptions(const PlotOpts& options) const {
+
+        if (options.do_norm != m_options.do_norm) return false;
+        if (!options.do_norm) return true;
+        return (options.norm_to == m_options.norm_to) &&
+               (options.norm_range.GetX() == m_options.norm_range.GetX());
+
+      }  // end 'MatchesOptions(PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Get position of a slot
+      // ----------------------------------------------------------------------
+      std::size_t GetPosition(const Slot& slot) const {
+
+        std::map<Slot, std::size_t>::const_iterator found = m_index.find(slot);
+        if (found == m_index.end()) {
+          std::cerr << "PANIC: slot (species " << slot.species << ", level " << slot.level
+                    << ", pt " << slot.pt << ") hasn't been loaded!"
+                    << std::endl;
+          Error::Raise("comparison slot hasn't been loaded");
+          assert(found != m_index.end());
+        }
+        return found -> second;
+
+      }  // end 'GetPosition(Slot&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t     GetNSlots()  const {return m_spectra.size();}
+      std::size_t     GetNRatios() const {return m_ratios.size();}
+      std::size_t     GetNLoads()  const {return m_nLoads;}
+      const PlotOpts& GetOptions() const {return m_options;}
+
+      // ----------------------------------------------------------------------
+      //! Start a new block
+      // ----------------------------------------------------------------------
+      /*! \param options normalization options every slot is loaded with */
+      void Reset(const PlotOpts& options) {
+
+        m_options = options;
+        m_index.clear();
+        m_keys.clear();
+        m_spectra.clear();
+        m_pairs.clear();
+        m_ratios.clear();
+        return;
+
+      }  // end 'Reset(PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Check if a slot has been loaded
+      // ----------------------------------------------------------------------
+      bool HasSlot(const Slot& slot) const {
+
+        return (m_index.find(slot) != m_index.end());
+
+      }  // end 'HasSlot(Slot&)'
+
+      // ----------------------------------------------------------------------
+      //! Load a slot (if not already loaded)
+      // ----------------------------------------------------------------------
+      void Load(const Slot& slot, const PlotInput& input) {
+
+        if (HasSlot(slot)) return;
+
+        // grab spectrum from shared memory or file
+        Hist1D native = Tools::LoadHist1D(
+          input.file,
+          input.object,
+          1,
+          "slot " + Tools::StringifyIndex(m_spectra.size())
+        );
+        native.SetName(input.rename);
+
+        // rebin & normalize if need be (adaptive rebinning
+        // is left to the routines, see BaseRoutine)
+        if (input.rebin.GetRebin() && !input.rebin.IsAdaptive()) {
+          input.rebin.Apply(native);
+        }
+        if (m_options.do_norm) {
+          Tools::NormalizeByIntegral(
+            native,
+            m_options.norm_to,
+            m_options.norm_range.GetX().first,
+            m_options.norm_range.GetX().second
+          );
+        }
+
+        m_index[slot]          = m_spectra.size();
+        m_keys[MakeKey(input)] = m_spectra.size();
+        m_spectra.push_back(native);
+        ++m_nLoads;
+        return;
+
+      }  // end 'Load(Slot&, PlotInput&)'
+
+      // ----------------------------------------------------------------------
+      //! Request a ratio of two slots
+      // ----------------------------------------------------------------------
+      void Request(const Slot& numer, const Slot& denom) {
+
+        m_pairs.push_back( std::make_pair(GetPosition(numer), GetPosition(denom)) );
+        return;
+
+      }  // end 'Request(Slot& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Compute all requested ratios
+      // ----------------------------------------------------------------------
+      /*! Slots sharing a binning are packed into one
+       *  contiguous (slot x cell) tensor and ratios of them are
+       *  written into a (pair x cell) tensor, so the whole set
+       *  is one sweep of the division kernel over contiguous
+       *  rows. Pairs with different binnings fall back to
+       *  `Tools::DivideHist1D(...)`.
+       */
+      void Compute() {
+
+        m_ratios.clear();
+        if (m_pairs.empty()) return;
+
+        // pack spectra sharing the binning of the first slot
+        const Hist1D&     first  = m_spectra[ m_pairs.front().second ];
+        const std::size_t ncells = first.GetNcells();
+
+        std::vector<bool>   packed(m_spectra.size(), false);
+        std::vector<double> content(m_spectra.size() * ncells, 0.);
+        std::vector<double> sumw2(m_spectra.size() * ncells, 0.);
+        for (std::size_t ispec = 0; ispec < m_spectra.size(); ++ispec) {
+          if (!m_spectra[ispec].IsCompatible(first)) continue;
+          std::copy(m_spectra[ispec].Content(), m_spectra[ispec].Content() + ncells, content.begin() + (ispec * ncells));
+          std::copy(m_spectra[ispec].Sumw2(), m_spectra[ispec].Sumw2() + ncells, sumw2.begin() + (ispec * ncells));
+          packed[ispec] = true;
+        }
+
+        // batched ratios
+        std::vector<double> rcontent(m_pairs.size() * ncells, 0.);
+        std::vector<double> rsumw2(m_pairs.size() * ncells, 0.);
+        for (std::size_t ipair = 0; ipair < m_pairs.size(); ++ipair) {
+          const std::size_t inum = m_pairs[ipair].first;
+          const std::size_t iden = m_pairs[ipair].second;
+          if (!packed[inum] || !packed[iden]) continue;
+          HistMath::Divide(
+            &content[inum * ncells], &sumw2[inum * ncells],
+            &content[iden * ncells], &sumw2[iden * ncells],
+            &rcontent[ipair * ncells], &rsumw2[ipair * ncells],
+            ncells
+          );
+        }
+
+        // unpack into histograms
+        for (std::size_t ipair = 0; ipair < m_pairs.size(); ++ipair) {
+
+          const Hist1D& numer = m_spectra[ m_pairs[ipair].first ];
+          const Hist1D& denom = m_spectra[ m_pairs[ipair].second ];
+
+          Hist1D ratio = denom;
+          if (packed[m_pairs[ipair].first] && packed[m_pairs[ipair].second]) {
+            std::copy(rcontent.begin() + (ipair * ncells), rcontent.begin() + ((ipair + 1) * ncells), ratio.Content());
+            std::copy(rsumw2.begin() + (ipair * ncells), rsumw2.begin() + ((ipair + 1) * ncells), ratio.Sumw2());
+          } else {
+            ratio = Tools::DivideHist1D(numer, denom);
+          }
+          ratio.SetName( numer.GetName() + "_Ratio" );
+          m_ratios.push_back(ratio);
+        }
+        std::cout << "    Computed " << m_ratios.size() << " ratios over " << m_spectra.size() << " slots." << std::endl;
+        return;
+
+      }  // end 'Compute()'
+
+      // ----------------------------------------------------------------------
+      //! Get spectrum of a slot
+      // ----------------------------------------------------------------------
+      const Hist1D& GetSpectrum(const Slot& slot) const {
+
+        return m_spectra[GetPosition(slot)];
+
+      }  // end 'GetSpectrum(Slot&)'
+
+      // ----------------------------------------------------------------------
+      //! Look up a loaded spectrum
+      // ----------------------------------------------------------------------
+      /*! \return spectrum loaded from the same input with the
+       *          same normalization, or NULL if there isn't one
+       */
+      const Hist1D* Find(const PlotInput& input, const PlotOpts& options) const {
+
+        if (!MatchesOptions(options)) return NULL;
+
+        std::map<std::string, std::size_t>::const_iterator found = m_keys.find( MakeKey(input) );
+        return (found != m_keys.end()) ? &m_spectra[found -> second] : NULL;
+
+      }  // end 'Find(PlotInput&, PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Look up a computed ratio
+      // ----------------------------------------------------------------------
+      /*! \return ratio of the spectra loaded from the inputs
+       *          with the same normalization, or NULL if it
+       *          wasn't computed
+       */
+      const Hist1D* FindRatio(const PlotInput& numer, const PlotInput& denom, const PlotOpts& options) const {
+
+        if (!MatchesOptions(options)) return NULL;
+
+        std::map<std::string, std::size_t>::const_iterator inum = m_keys.find( MakeKey(numer) );
+        std::map<std::string, std::size_t>::const_iterator iden = m_keys.find( MakeKey(denom) );
+        if ((inum == m_keys.end()) || (iden == m_keys.end())) return NULL;
+
+        for (std::size_t ipair = 0; ipair < m_ratios.size(); ++ipair) {
+          if ((m_pairs[ipair].first == inum -> second) && (m_pairs[ipair].second == iden -> second)) {
+            return &m_ratios[ipair];
+          }
+        }
+        return NULL;
+
+      }  // end 'FindRatio(PlotInput& x 2, PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared tensor
+      // ----------------------------------------------------------------------
+      static ComparisonTensor& Global() {
+
+        static ComparisonTensor tensor;
+        return tensor;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ComparisonTensor()  : m_nLoads(0) {};
+      ~ComparisonTensor() {};
+
+  };  // end ComparisonTensor
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,313 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorCorrectionStore.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Cache of bin-by-bin correction factors to reuse
+ *  across a sweep.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCORRECTIONSTORE_H
+#define PHCORRELATORCORRECTIONSTORE_H
+
+// c++ utilities
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotInput.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Correction factor store
+  // ==========================================================================
+  /*! Correcting a spectrum needs the (normalized) reco- and
+   *  truth-level spectra and their ratio, which only depend
+   *  on the species, jet pt, cf and charge bins, variable,
+   *  which spin state of the simulation is used, and which
+   *  reco/truth inputs they're made from. Sweeping over spin
+   *  states would otherwise recompute the same factors for
+   *  every state, so routines can look them up here instead.
+   *
+   *  Which spin goes into the key is set by the key policy:
+   *    - SpinIndependent: all spin states share the factors
+   *      computed from one chosen correction spin;
+   *    - SpinDependent: each spin state gets its own factors
+   *      (default).
+   *
+   *  Entries are assumed to have been computed with the same
+   *  normalization options. Like the histogram pool, the store
+   *  isn't meant to be shared between threads.
+   */
+  class CorrectionStore {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Key policies
+      // ----------------------------------------------------------------------
+      enum Policy {SpinIndependent, SpinDependent};
+
+      // ======================================================================
+      //! Key for a set of correction factors
+      // ======================================================================
+      struct Key {
+
+        // members
+        int         species;   ///!< species index
+        int         pt;        ///!< jet pt index
+        int         cf;        ///!< cf index
+        int         chrg;      ///!< charge index
+        int         spin;      ///!< spin index used for correction
+        int         nrebin;    ///!< no. of bins merged (1 if not rebinned)
+        std::string variable;  ///!< variable being corrected
+        std::string recon;     ///!< reco-level input ("file:object")
+        std::string truth;     ///!< truth-level input ("file:object")
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Key() {
+          species  = -1;
+          pt       = -1;
+          cf       = -1;
+          chrg     = -1;
+          spin     = -1;
+          nrebin   = 1;
+          variable = "";
+          recon    = "";
+          truth    = "";
+        };
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Key(
+          const int species_arg,
+          const int pt_arg,
+          const int cf_arg,
+          const int chrg_arg,
+          const int spin_arg,
+          const std::string& variable_arg,
+          const std::string& recon_arg,
+          const std::string& truth_arg,
+          const int nrebin_arg = 1
+        ) {
+          species  = species_arg;
+          pt       = pt_arg;
+          cf       = cf_arg;
+          chrg     = chrg_arg;
+          spin     = spin_arg;
+          nrebin   = nrebin_arg;
+          variable = variable_arg;
+          recon    = recon_arg;
+          truth    = truth_arg;
+        }  // end ctor(int x 5, std::string& x 3, int)
+
+        // --------------------------------------------------------------------
+        //! Ordering for use as a map key
+        // --------------------------------------------------------------------
+        bool operator<(const Key& rhs) const {
+
+          if (species  != rhs.species)  return species  < rhs.species;
+          if (pt       != rhs.pt)       return pt       < rhs.pt;
+          if (cf       != rhs.cf)       return cf       < rhs.cf;
+          if (chrg     != rhs.chrg)     return chrg     < rhs.chrg;
+          if (spin     != rhs.spin)     return spin     < rhs.spin;
+          if (nrebin   != rhs.nrebin)   return nrebin   < rhs.nrebin;
+          if (variable != rhs.variable) return variable < rhs.variable;
+          if (recon    != rhs.recon)    return recon    < rhs.recon;
+          return truth < rhs.truth;
+
+        }  // end 'operator<(Key&)'
+
+      };  // end Key
+
+      // ======================================================================
+      //! Cached reco, truth, and correction factor
+      // ======================================================================
+      struct Entry {
+
+        // members
+        Hist1D recon;   ///!< normalized reco-level spectrum
+        Hist1D truth;   ///!< normalized truth-level spectrum
+        Hist1D factor;  ///!< correction factor (reco / truth)
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Entry() {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Entry(const Hist1D& recon_arg, const Hist1D& truth_arg, const Hist1D& factor_arg) {
+          recon  = recon_arg;
+          truth  = truth_arg;
+          factor = factor_arg;
+        }  // end ctor(Hist1D& x 3)
+
+      };  // end Entry
+
+    private:
+
+      // data members
+      Policy               m_policy;   ///!< which spin goes into keys
+      int                  m_spin;     ///!< spin to correct with if spin-independent
+      std::map<Key, Entry> m_entries;  ///!< cached corrections
+      std::size_t          m_nHits;    ///!< no. of lookups served from cache
+      std::size_t          m_nStored;  ///!< no. of corrections computed and stored
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      Policy      GetPolicy()         const {return m_policy;}
+      int         GetCorrectionSpin() const {return m_spin;}
+      std::size_t GetNHits()          const {return m_nHits;}
+      std::size_t GetNStored()        const {return m_nStored;}
+      std::size_t GetNEntries()       const {return m_entries.size();}
+
+      // ----------------------------------------------------------------------
+      //! Set key policy
+      // ----------------------------------------------------------------------
+      /*! Changing the policy clears the store.
+       *
+       *  \param policy which spin goes into keys
+       *  \param spin   spin to correct with if spin-independent
+       */
+      void SetPolicy(const Policy policy, const int spin = -1) {
+
+        if ((policy != m_policy) || (spin != m_spin)) {
+          m_entries.clear();
+        }
+        m_policy = policy;
+        m_spin   = spin;
+        return;
+
+      }  // end 'SetPolicy(Policy, int)'
+
+      // ----------------------------------------------------------------------
+      //! Get spin index to correct a given spin state with
+      // ----------------------------------------------------------------------
+      int ResolveSpin(const int spin) const {
+
+        return (m_policy == SpinIndependent) ? m_spin : spin;
+
+      }  // end 'ResolveSpin(int)'
+
+      // ----------------------------------------------------------------------
+      //! Make key for a given index according to the policy
+      // ----------------------------------------------------------------------
+      /*! \param species  species index
+       *  \param pt       jet pt index
+       *  \param cf       cf index
+       *  \param chrg     charge index
+       *  \param spin     spin index being corrected
+       *  \param variable variable being corrected
+       *  \param recon    reco-level input of correction
+       *  \param truth    truth-level input of correction
+       *  \param nrebin   no. of bins merged (1 if not rebinned)
+       */
+      Key MakeKey(
+        const int species,
+        const int pt,
+        const int cf,
+        const int chrg,
+        const int spin,
+        const std::string& variable,
+        const PlotInput& recon,
+        const PlotInput& truth,
+        const int nrebin = 1
+      ) const {
+
+        return Key(
+          species,
+          pt,
+          cf,
+          chrg,
+          ResolveSpin(spin),
+          variable,
+          recon.file + ":" + recon.object,
+          truth.file + ":" + truth.object,
+          nrebin
+        );
+
+      }  // end 'MakeKey(int x 5, std::string&, PlotInput& x 2, int)'
+
+      // ----------------------------------------------------------------------
+      //! Check if a correction has been stored
+      // ----------------------------------------------------------------------
+      bool Has(const Key& key) const {
+
+        return (m_entries.find(key) != m_entries.end());
+
+      }  // end 'Has(Key&)'
+
+      // ----------------------------------------------------------------------
+      //! Look up a stored correction
+      // ----------------------------------------------------------------------
+      /*! Returns NULL if nothing has been stored
+       *  under the key yet.
+       */
+      const Entry* Find(const Key& key) {
+
+        std::map<Key, Entry>::const_iterator found = m_entries.find(key);
+        if (found == m_entries.end()) return NULL;
+
+        ++m_nHits;
+        return &(found -> second);
+
+      }  // end 'Find(Key&)'
+
+      // ----------------------------------------------------------------------
+      //! Store a correction
+      // ----------------------------------------------------------------------
+      void Store(const Key& key, const Entry& entry) {
+
+        m_entries[key] = entry;
+        ++m_nStored;
+        return;
+
+      }  // end 'Store(Key&, Entry&)'
+
+      // ----------------------------------------------------------------------
+      //! Remove all stored corrections
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_entries.clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared store
+      // ----------------------------------------------------------------------
+      static CorrectionStore& Global() {
+
+        static CorrectionStore store;
+        return store;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      CorrectionStore() : m_policy(SpinDependent), m_spin(-1), m_nHits(0), m_nStored(0) {};
+      ~CorrectionStore() {};
+
+  };  // end CorrectionStore
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,436 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorCovariance.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Bin-to-bin covariance of spectra and its
+ *  propagation.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCOVARIANCE_H
+#define PHCORRELATORCOVARIANCE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotError.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Bin-to-bin covariance
+  // ==========================================================================
+  /*! Dense, row-major covariance over all cells of a 1D
+   *  spectrum (i.e. including under/overflow), so cell i of
+   *  a Hist1D is row/column i.
+   *
+   *  Pairs of one jet fill many R bins, so bins of an EEC
+   *  are correlated and propagating only the diagonal (as
+   *  DivideHist1D and NormalizeByIntegral do) misses that.
+   *  The methods here propagate the full matrix:
+   *    - element-wise operations (ratios, corrections) and
+   *      normalization are a diagonal scaling plus a rank-one
+   *      update, so they're done in O(n^2) directly;
+   *    - general linear maps and estimates from samples (e.g.
+   *      replicas) go through a blocked matrix product that
+   *      keeps tiles of both operands in cache.
+   */
+  class Covariance {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Tile size of blocked products (3 tiles of doubles fit in L1)
+      // ----------------------------------------------------------------------
+      enum {BlockSize = 32};
+
+    private:
+
+      // data members
+      std::size_t         m_size;    ///!< no. of rows/columns (cells)
+      std::vector<double> m_matrix;  ///!< row-major elements
+
+      // ----------------------------------------------------------------------
+      //! Blocked product: out (n x m) += left (n x k) * right^T (m x k)
+      // ----------------------------------------------------------------------
+      /*! Both operands are row-major and the right one is
+       *  taken transposed, so the innermost loop runs over
+       *  contiguous memory of both.
+       */
+      static void MultiplyTransposed(
+        const double* left,
+        const double* right,
+        double* out,
+        const std::size_t n,
+        const std::size_t m,
+        const std::size_t k
+      ) {
+
+        for (std::size_t i0 = 0; i0 < n; i0 += BlockSize) {
+          const std::size_t i1 = std::min(i0 + (std::size_t) BlockSize, n);
+          for (std::size_t j0 = 0; j0 < m; j0 += BlockSize) {
+            const std::size_t j1 = std::min(j0 + (std::size_t) BlockSize, m);
+            for (std::size_t k0 = 0; k0 < k; k0 += BlockSize) {
+              const std::size_t k1 = std::min(k0 + (std::size_t) BlockSize, k);
+
+              for (std::size_t i = i0; i < i1; ++i) {
+                const double* row = left + (i * k);
+                for (std::size_t j = j0; j < j1; ++j) {
+                  const double* col = right + (j * k);
+                  double sum = 0.;
+                  for (std::size_t l = k0; l < k1; ++l) {
+                    sum += row[l] * col[l];
+                  }
+                  out[(i * m) + j] += sum;
+                }
+              }
+            }
+          }
+        }
+        return;
+
+      }  // end 'MultiplyTransposed(double* x 3, std::size_t x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Check size against a spectrum
+      // ----------------------------------------------------------------------
+      void CheckSize(const Hist1D& hist) const {
+
+        if ((std::size_t) hist.GetNcells() != m_size) {
+          std::cerr << "PANIC: covariance has " << m_size << " cells but " << hist.GetName()
+                    << " has " << hist.GetNcells() << "!"
+                    << std::endl;
+          Error::Raise("covariance doesn't match " + hist.GetName());
+          assert((std::size_t) hist.GetNcells() == m_size);
+        }
+        return;
+
+      }  // end 'CheckSize(Hist1D&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetSize() const {return m_size;}
+      bool        IsEmpty() const {return (m_size == 0);}
+      double      Get(const std::size_t row, const std::size_t col) const {return m_matrix[(row * m_size) + col];}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void Set(const std::size_t row, const std::size_t col, const double value) {m_matrix[(row * m_size) + col] = value;}
+
+      // ----------------------------------------------------------------------
+      //! Add another (independent) covariance
+      // ----------------------------------------------------------------------
+      void Add(const Covariance& other) {
+
+        if (other.m_size != m_size) {
+          std::cerr << "PANIC: trying to add covariances of different sizes (" << m_size << " vs. " << other.m_size << ")!" << std::endl;
+          Error::Raise("trying to add covariances of different sizes");
+          assert(other.m_size == m_size);
+        }
+        for (std::size_t iel = 0; iel < m_matrix.size(); ++iel) {
+          m_matrix[iel] += other.m_matrix[iel];
+        }
+        return;
+
+      }  // end 'Add(Covariance&)'
+
+      // ----------------------------------------------------------------------
+      //! Scale by a diagonal Jacobian: C_ij -> d_i C_ij d_j
+      // ----------------------------------------------------------------------
+      void ScaleDiagonal(const std::vector<double>& diag) {
+
+        for (std::size_t row = 0; row < m_size; ++row) {
+          double* elements = &m_matrix[row * m_size];
+          for (std::size_t col = 0; col < m_size; ++col) {
+            elements[col] *= diag[row] * diag[col];
+          }
+        }
+        return;
+
+      }  // end 'ScaleDiagonal(std::vector<double>&)'
+
+      // ----------------------------------------------------------------------
+      //! Propagate through a general linear map
+      // ----------------------------------------------------------------------
+      /*! Returns J C J^T for a row-major Jacobian J with
+       *  `nout` rows (e.g. a rebinning or a projection).
+       */
+      Covariance Transform(const std::vector<double>& jacobian, const std::size_t nout) const {
+
+        if (jacobian.size() != nout * m_size) {
+          std::cerr << "PANIC: Jacobian has " << jacobian.size() << " elements, expected " << nout * m_size << "!" << std::endl;
+          Error::Raise("Jacobian doesn't match covariance");
+          assert(jacobian.size() == nout * m_size);
+        }
+
+        // C is symmetric, so (J C) = J C^T
+        std::vector<double> left(nout * m_size, 0.);
+        MultiplyTransposed(&jacobian[0], &m_matrix[0], &left[0], nout, m_size, m_size);
+
+        Covariance result(nout);
+        MultiplyTransposed(&left[0], &jacobian[0], &result.m_matrix[0], nout, nout, m_size);
+        return result;
+
+      }  // end 'Transform(std::vector<double>&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Propagate through Hist1D::Rebin
+      // ----------------------------------------------------------------------
+      /*! Merges cells exactly like Hist1D::Rebin (leftover
+       *  bins go to the overflow).
+       */
+      Covariance Rebin(const int ngroup) const {
+
+        const int nold = (int) m_size - 2;
+        if ((ngroup <= 1) || (ngroup > nold)) return *this;
+
+        const int nnew = nold / ngroup;
+        const std::size_t nout = nnew + 2;
+
+        std::vector<double> jacobian(nout * m_size, 0.);
+        jacobian[0] = 1.;
+        for (int iold = 1; iold <= nold + 1; ++iold) {
+          const int inew = std::min(((iold - 1) / ngroup) + 1, nnew + 1);
+          jacobian[(inew * m_size) + iold] = 1.;
+        }
+        return Transform(jacobian, nout);
+
+      }  // end 'Rebin(int)'
+
+      // ----------------------------------------------------------------------
+      //! Propagate through NormalizeByIntegral
+      // ----------------------------------------------------------------------
+      /*! With s = norm / I and I the sum of cells [istart,
+       *  istop] of the spectrum *before* normalizing, the
+       *  Jacobian is s (1 - u v^T) with u = h / I and v the
+       *  indicator of the range, i.e. a rank-one update:
+       *
+       *    C' = s^2 (C - u w^T - w u^T + (v^T w) u u^T),
+       *
+       *  with w = C v.
+       */
+      void Normalize(const Hist1D& hist, const double norm, const int istart, const int istop) {
+
+        CheckSize(hist);
+
+        const int    first    = std::max(istart, 0);
+        const int    last     = std::min(istop, (int) m_size - 1);
+        const double integral = hist.Integral(first, last);
+        if (integral <= 0.) return;
+
+        const double scale = norm / integral;
+
+        // w = C v and v^T w
+        std::vector<double> u(m_size, 0.);
+        std::vector<double> w(m_size, 0.);
+        double vw = 0.;
+        for (std::size_t row = 0; row < m_size; ++row) {
+          const double* elements = &m_matrix[row * m_size];
+          double sum = 0.;
+          for (int col = first; col <= last; ++col) {
+            sum += elements[col];
+          }
+          w[row] = sum;
+          u[row] = hist.GetBinContent(row) / integral;
+        }
+        for (int row = first; row <= last; ++row) {
+          vw += w[row];
+        }
+
+        for (std::size_t row = 0; row < m_size; ++row) {
+          double* elements = &m_matrix[row * m_size];
+          for (std::size_t col = 0; col < m_size; ++col) {
+            const double update = elements[col] - (u[row] * w[col]) - (w[row] * u[col]) + (vw * u[row] * u[col]);
+            elements[col] = scale * scale * update;
+          }
+        }
+        return;
+
+      }  // end 'Normalize(Hist1D&, double, int x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Set errors of a spectrum to the diagonal
+      // ----------------------------------------------------------------------
+      void ApplyErrors(Hist1D& hist) const {
+
+        CheckSize(hist);
+        for (std::size_t cell = 0; cell < m_size; ++cell) {
+          hist.SetBinSumw2(cell, Get(cell, cell));
+        }
+        return;
+
+      }  // end 'ApplyErrors(Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Make a 2D histogram of the matrix
+      // ----------------------------------------------------------------------
+      /*! Bins are those of the spectrum on both axes, so the
+       *  result can be written next to it (and read back in
+       *  with FromHist2D).
+       */
+      Hist2D MakeHist2D(const Hist1D& hist, const std::string& name) const {
+
+        CheckSize(hist);
+
+        Hist2D matrix(name, hist.GetTitle(), hist.GetEdges(), hist.GetEdges());
+        matrix.SetXTitle( hist.GetXTitle() );
+        matrix.SetYTitle( hist.GetXTitle() );
+        matrix.SetZTitle("covariance");
+        for (std::size_t row = 0; row < m_size; ++row) {
+          for (std::size_t col = 0; col < m_size; ++col) {
+            matrix.SetBinContent(col, row, Get(row, col));
+          }
+        }
+        return matrix;
+
+      }  // end 'MakeHist2D(Hist1D&, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Diagonal covariance from errors of a spectrum
+      // ----------------------------------------------------------------------
+      static Covariance Diagonal(const Hist1D& hist) {
+
+        Covariance cov(hist.GetNcells());
+        for (int cell = 0; cell < hist.GetNcells(); ++cell) {
+          cov.Set(cell, cell, hist.GetBinSumw2(cell));
+        }
+        return cov;
+
+      }  // end 'Diagonal(Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Covariance from a 2D histogram
+      // ----------------------------------------------------------------------
+      /*! Expects the same (square) binning on both axes,
+       *  i.e. the layout of MakeHist2D.
+       */
+      static Covariance FromHist2D(const Hist2D& matrix) {
+
+        if (matrix.GetNbinsX() != matrix.GetNbinsY()) {
+          std::cerr << "PANIC: covariance " << matrix.GetName() << " isn't square!" << std::endl;
+          Error::Raise("covariance " + matrix.GetName() + " isn't square");
+          assert(matrix.GetNbinsX() == matrix.GetNbinsY());
+        }
+
+        Covariance cov(matrix.GetNbinsX() + 2);
+        for (std::size_t row = 0; row < cov.m_size; ++row) {
+          for (std::size_t col = 0; col < cov.m_size; ++col) {
+            cov.Set(row, col, matrix.GetBinContent(col, row));
+          }
+        }
+        return cov;
+
+      }  // end 'FromHist2D(Hist2D&)'
+
+      // ----------------------------------------------------------------------
+      //! Sample covariance of a set of samples (e.g. replicas)
+      // ----------------------------------------------------------------------
+      /*! \param values   row-major (nsamples x size) values
+       *  \param nsamples no. of samples
+       *  \param size     no. of cells per sample
+       */
+      static Covariance FromSamples(const std::vector<double>& values, const std::size_t nsamples, const std::size_t size) {
+
+        Covariance cov(size);
+        if (nsamples < 2) return cov;
+
+        // center samples and transpose, so cells are rows
+        std::vector<double> mean(size, 0.);
+        for (std::size_t isam = 0; isam < nsamples; ++isam) {
+          for (std::size_t cell = 0; cell < size; ++cell) {
+            mean[cell] += values[(isam * size) + cell];
+          }
+        }
+        for (std::size_t cell = 0; cell < size; ++cell) {
+          mean[cell] /= (double) nsamples;
+        }
+
+        std::vector<double> centered(size * nsamples, 0.);
+        for (std::size_t isam = 0; isam < nsamples; ++isam) {
+          for (std::size_t cell = 0; cell < size; ++cell) {
+            centered[(cell * nsamples) + isam] = values[(isam * size) + cell] - mean[cell];
+          }
+        }
+
+        // C = X X^T / (N - 1)
+        MultiplyTransposed(&centered[0], &centered[0], &cov.m_matrix[0], size, size, nsamples);
+        for (std::size_t iel = 0; iel < cov.m_matrix.size(); ++iel) {
+          cov.m_matrix[iel] /= (double) (nsamples - 1);
+        }
+        return cov;
+
+      }  // end 'FromSamples(std::vector<double>&, std::size_t x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Propagate independent covariances through a ratio
+      // ----------------------------------------------------------------------
+      /*! For r = a / b bin-by-bin, C_r = D_a C_a D_a + D_b C_b D_b
+       *  with D_a = diag(1 / b) and D_b = diag(-a / b^2). Cells
+       *  with b = 0 get no covariance (like DivideHist1D).
+       *
+       *  This assumes a and b are INDEPENDENT, i.e. there is no
+       *  cross term D_a C_ab D_b. E.g. for reco / truth, which
+       *  share events, the result overestimates the covariance.
+       */
+      static Covariance Ratio(
+        const Hist1D& numer,
+        const Covariance& cnumer,
+        const Hist1D& denom,
+        const Covariance& cdenom
+      ) {
+
+        cnumer.CheckSize(numer);
+        cdenom.CheckSize(denom);
+        cnumer.CheckSize(denom);
+
+        const std::size_t size = cnumer.m_size;
+
+        std::vector<double> dnumer(size, 0.);
+        std::vector<double> ddenom(size, 0.);
+        for (std::size_t cell = 0; cell < size; ++cell) {
+          const double b = denom.GetBinContent(cell);
+          if (b == 0.) continue;
+          dnumer[cell] = 1. / b;
+          ddenom[cell] = -numer.GetBinContent(cell) / (b * b);
+        }
+
+        Covariance result = cnumer;
+        Covariance scaled = cdenom;
+        result.ScaleDiagonal(dnumer);
+        scaled.ScaleDiagonal(ddenom);
+        result.Add(scaled);
+        return result;
+
+      }  // end 'Ratio(Hist1D&, Covariance&, Hist1D&, Covariance&)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Covariance()  : m_size(0) {};
+      ~Covariance() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting size (zero matrix)
+      // ----------------------------------------------------------------------
+      explicit Covariance(const std::size_t size) : m_size(size), m_matrix(size * size, 0.) {};
+
+  };  // end Covariance
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
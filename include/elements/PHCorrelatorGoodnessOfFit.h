@@ -0,0 +1,211 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorGoodnessOfFit.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Goodness-of-fit metrics between two binned
+ *  spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORGOODNESSOFFIT_H
+#define PHCORRELATORGOODNESSOFFIT_H
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+
+
+
+namespace PHEnergyCorrelator {
+  namespace GoodnessOfFit {
+
+    // ------------------------------------------------------------------------
+    //! Result of a comparison
+    // ------------------------------------------------------------------------
+    /*! Metrics that aren't defined for a pair (e.g. KS
+     *  for spectra with negative bins) are NaN.
+     */
+    struct Result {
+
+      // members
+      double chi2;       ///!< sum of squared pulls
+      int    ndf;        ///!< no. of bins w/ a non-zero error
+      double chi2ndf;    ///!< chi2 / ndf
+      double ks;         ///!< Kolmogorov-Smirnov distance
+      double ks_prob;    ///!< Kolmogorov-Smirnov probability
+      double ad;         ///!< Anderson-Darling statistic
+      double max_pull;   ///!< largest absolute pull
+      int    worst_bin;  ///!< bin w/ largest absolute pull
+
+      // ----------------------------------------------------------------------
+      //! default ctor
+      // ----------------------------------------------------------------------
+      Result() {
+        chi2      = 0.;
+        ndf       = 0;
+        chi2ndf   = std::numeric_limits<double>::quiet_NaN();
+        ks        = std::numeric_limits<double>::quiet_NaN();
+        ks_prob   = std::numeric_limits<double>::quiet_NaN();
+        ad        = std::numeric_limits<double>::quiet_NaN();
+        max_pull  = 0.;
+        worst_bin = -1;
+      };
+
+    };  // end Result
+
+
+
+    // ------------------------------------------------------------------------
+    //! Kolmogorov probability
+    // ------------------------------------------------------------------------
+    /*! Asymptotic probability of a KS distance at least
+     *  as large as observed, for lambda = sqrt(n) * D
+     *  (with the usual small-n correction applied by the
+     *  caller).
+     */
+    double KolmogorovProb(const double lambda) {
+
+      if (lambda < 0.2) return 1.;
+
+      double prob = 0.;
+      double sign = 1.;
+      for (int k = 1; k <= 100; ++k) {
+        const double term = std::exp(-2. * k * k * lambda * lambda);
+        prob += 2. * sign * term;
+        sign  = -sign;
+        if (term < 1e-12) break;
+      }
+      return std::max(0., std::min(1., prob));
+
+    }  // end 'KolmogorovProb(double)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare two spectra on detached bin arrays
+    // ------------------------------------------------------------------------
+    /*! Pulls (and so chi2 and the max pull) use the
+     *  combined error of both spectra. KS and AD compare
+     *  the shapes: each spectrum is normalized to unit
+     *  area and the no. of effective entries, (sum w)^2 /
+     *  sum w^2, sets the sample sizes. AD is the binned
+     *  two-sample form, with the pooled CDF taken at bin
+     *  centers.
+     *
+     *  \param ca, sa contents, squared errors of reference
+     *  \param cb, sb contents, squared errors of test
+     *  \param nbins  no. of bins to compare
+     */
+    Result Compare(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      const std::size_t nbins
+    ) {
+
+      Result result;
+
+      // pulls & totals
+      double suma     = 0.;
+      double sumb     = 0.;
+      double sumw2a   = 0.;
+      double sumw2b   = 0.;
+      bool   positive = true;
+      for (std::size_t ibin = 0; ibin < nbins; ++ibin) {
+
+        const double var = sa[ibin] + sb[ibin];
+        if (var > 0.) {
+          const double pull = (ca[ibin] - cb[ibin]) / std::sqrt(var);
+          result.chi2 += pull * pull;
+          ++result.ndf;
+          if (std::fabs(pull) > result.max_pull) {
+            result.max_pull  = std::fabs(pull);
+            result.worst_bin = (int) ibin;
+          }
+        }
+        suma   += ca[ibin];
+        sumb   += cb[ibin];
+        sumw2a += sa[ibin];
+        sumw2b += sb[ibin];
+        if ((ca[ibin] < 0.) || (cb[ibin] < 0.)) positive = false;
+      }
+      if (result.ndf > 0) {
+        result.chi2ndf = result.chi2 / result.ndf;
+      }
+
+      // shape metrics need normalizable spectra
+      if (!positive || (suma <= 0.) || (sumb <= 0.)) {
+        return result;
+      }
+
+      const double na   = (sumw2a > 0.) ? (suma * suma) / sumw2a : suma;
+      const double nb   = (sumw2b > 0.) ? (sumb * sumb) / sumw2b : sumb;
+      const double neff = (na * nb) / (na + nb);
+
+      double cdfa = 0.;
+      double cdfb = 0.;
+      double cdfh = 0.;
+      double dist = 0.;
+      double area = 0.;
+      for (std::size_t ibin = 0; ibin < nbins; ++ibin) {
+
+        const double fa = ca[ibin] / suma;
+        const double fb = cb[ibin] / sumb;
+        const double fh = ((na * fa) + (nb * fb)) / (na + nb);
+
+        // AD integrand at bin center
+        const double mida = cdfa + (0.5 * fa);
+        const double midb = cdfb + (0.5 * fb);
+        const double midh = cdfh + (0.5 * fh);
+        if ((fh > 0.) && (midh > 0.) && (midh < 1.)) {
+          area += fh * (mida - midb) * (mida - midb) / (midh * (1. - midh));
+        }
+
+        cdfa += fa;
+        cdfb += fb;
+        cdfh += fh;
+        dist  = std::max(dist, std::fabs(cdfa - cdfb));
+      }
+
+      const double rootn = std::sqrt(neff);
+      result.ks      = dist;
+      result.ks_prob = KolmogorovProb( (rootn + 0.12 + (0.11 / rootn)) * dist );
+      result.ad      = neff * area;
+      return result;
+
+    }  // end 'Compare(double* x 4, std::size_t)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare two native histograms
+    // ------------------------------------------------------------------------
+    /*! Under/overflow are excluded, and the worst bin is
+     *  reported as a regular (1-based) bin number.
+     */
+    Result Compare(const Hist1D& ref, const Hist1D& test) {
+
+      if (!ref.IsCompatible(test)) {
+        return Result();
+      }
+
+      Result result = Compare(
+        ref.Content() + 1, ref.Sumw2() + 1,
+        test.Content() + 1, test.Sumw2() + 1,
+        ref.GetNbins()
+      );
+      if (result.worst_bin > -1) ++result.worst_bin;
+      return result;
+
+    }  // end 'Compare(Hist1D&, Hist1D&)'
+
+  }  // end GoodnessOfFit namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
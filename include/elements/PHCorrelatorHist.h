@@ -0,0 +1,724 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorHist.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Lightweight native histograms for internal
+ *  computation.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORHIST_H
+#define PHCORRELATORHIST_H
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+// root libraries
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorPlotTypes.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Native 1D histogram
+  // ==========================================================================
+  /*! A small 1D histogram with contiguous (structure-of-arrays)
+   *  storage for the bin edges, contents, and sum of squared
+   *  weights. Bins are numbered like ROOT's: bin 0 is the
+   *  underflow and bin nbins + 1 the overflow.
+   *
+   *  Unlike a TH1, a Hist1D doesn't register itself anywhere,
+   *  so it's safe to copy, fill, rebin, and combine from any
+   *  thread (the binning registry and its mapping cache are
+   *  locked, see Binning), as long as each histogram is only
+   *  modified by one thread at a time. Conversion to/from
+   *  ROOT only happens when loading inputs (`Hist1D(const
+   *  TH1*)`) and drawing/writing outputs (`MakeTH1()`), which
+   *  are main thread only.
+   *
+   *  Binning is held as an interned descriptor (see Binning),
+   *  so histograms with the same binning share their edges.
+   */
+  class Hist1D {
+
+    private:
+
+      // data members
+      std::string         m_name;     ///!< histogram name
+      std::string         m_title;    ///!< histogram title
+      std::string         m_xtitle;   ///!< x-axis title
+      std::string         m_ytitle;   ///!< y-axis title
+      const Binning*      m_binning;  ///!< interned binning
+      std::vector<double> m_content;  ///!< bin contents (nbins + 2)
+      std::vector<double> m_sumw2;    ///!< sum of squared weights (nbins + 2)
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::string                GetName()   const {return m_name;}
+      std::string                GetTitle()  const {return m_title;}
+      std::string                GetXTitle() const {return m_xtitle;}
+      std::string                GetYTitle() const {return m_ytitle;}
+      const Binning*             GetBinning() const {return m_binning;}
+      const std::vector<double>& GetEdges()   const {return m_binning -> GetEdges();}
+      int                        GetNbins()   const {return m_binning -> GetNbins();}
+      int                        GetNcells()  const {return (int) m_content.size();}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetName(const std::string& name)     {m_name   = name;}
+      void SetTitle(const std::string& title)   {m_title  = title;}
+      void SetXTitle(const std::string& xtitle) {m_xtitle = xtitle;}
+      void SetYTitle(const std::string& ytitle) {m_ytitle = ytitle;}
+
+      // ----------------------------------------------------------------------
+      //! Raw access to storage
+      // ----------------------------------------------------------------------
+      /*! Contents and squared weights are laid out contiguously
+       *  over all GetNcells() cells (including under/overflow)
+       *  so kernels can run straight over them.
+       */
+      double*       Content()       {return m_content.empty() ? 0 : &m_content[0];}
+      double*       Sumw2()         {return m_sumw2.empty() ? 0 : &m_sumw2[0];}
+      const double* Content() const {return m_content.empty() ? 0 : &m_content[0];}
+      const double* Sumw2()   const {return m_sumw2.empty() ? 0 : &m_sumw2[0];}
+
+      // ----------------------------------------------------------------------
+      //! Bin accessors
+      // ----------------------------------------------------------------------
+      double GetBinContent(const int bin) const {return m_content[bin];}
+      double GetBinSumw2(const int bin)   const {return m_sumw2[bin];}
+      double GetBinError(const int bin)   const {return std::sqrt(m_sumw2[bin]);}
+      double GetBinLowEdge(const int bin) const {return m_binning -> GetBinLowEdge(bin);}
+      double GetBinUpEdge(const int bin)  const {return m_binning -> GetBinUpEdge(bin);}
+      double GetBinWidth(const int bin)   const {return m_binning -> GetBinWidth(bin);}
+      double GetBinCenter(const int bin)  const {return m_binning -> GetBinCenter(bin);}
+
+      // ----------------------------------------------------------------------
+      //! Bin modifiers
+      // ----------------------------------------------------------------------
+      void SetBinContent(const int bin, const double val) {m_content[bin] = val;}
+      void SetBinSumw2(const int bin, const double sumw2) {m_sumw2[bin]   = sumw2;}
+      void SetBinError(const int bin, const double err)   {m_sumw2[bin]   = err * err;}
+
+      // ----------------------------------------------------------------------
+      //! Find bin corresponding to a value
+      // ----------------------------------------------------------------------
+      int FindBin(const double x) const {return m_binning -> FindBin(x);}
+
+      // ----------------------------------------------------------------------
+      //! Integrate contents over a range of bins
+      // ----------------------------------------------------------------------
+      double Integral(const int start, const int stop) const {
+
+        const int first = std::max(start, 0);
+        const int last  = std::min(stop, GetNcells() - 1);
+
+        double integral = 0.;
+        for (int ibin = first; ibin <= last; ++ibin) {
+          integral += m_content[ibin];
+        }
+        return integral;
+
+      }  // end 'Integral(int, int)'
+
+      // ----------------------------------------------------------------------
+      //! Scale contents (and errors)
+      // ----------------------------------------------------------------------
+      void Scale(const double scale) {
+
+        if (m_content.empty()) return;
+        HistMath::Scale(Content(), Sumw2(), m_content.size(), scale);
+        return;
+
+      }  // end 'Scale(double)'
+
+      // ----------------------------------------------------------------------
+      //! Zero contents and errors
+      // ----------------------------------------------------------------------
+      void Reset() {
+
+        std::fill(m_content.begin(), m_content.end(), 0.);
+        std::fill(m_sumw2.begin(), m_sumw2.end(), 0.);
+        return;
+
+      }  // end 'Reset()'
+
+      // ----------------------------------------------------------------------
+      //! Check if binning matches another histogram
+      // ----------------------------------------------------------------------
+      bool IsCompatible(const Hist1D& other) const {return m_binning == other.m_binning;}
+
+      // ----------------------------------------------------------------------
+      //! Merge groups of adjacent bins
+      // ----------------------------------------------------------------------
+      /*! Follows TH1::Rebin: if ngroup doesn't evenly divide
+       *  the number of bins, the leftover bins are added to
+       *  the overflow.
+       */
+      void Rebin(const int ngroup) {
+
+        const int nold = GetNbins();
+        if ((ngroup <= 1) || (ngroup > nold)) return;
+
+        // collect new edges
+        const int nnew = nold / ngroup;
+        std::vector<double> edges(nnew + 1);
+        for (int inew = 0; inew <= nnew; ++inew) {
+          edges[inew] = GetEdges()[inew * ngroup];
+        }
+
+        // merge contents
+        std::vector<double> content(nnew + 2, 0.);
+        std::vector<double> sumw2(nnew + 2, 0.);
+        content[0] = m_content[0];
+        sumw2[0]   = m_sumw2[0];
+        for (int iold = 1; iold <= nold + 1; ++iold) {
+          const int inew = std::min(((iold - 1) / ngroup) + 1, nnew + 1);
+          content[inew] += m_content[iold];
+          sumw2[inew]   += m_sumw2[iold];
+        }
+
+        m_binning = Binning::Intern(edges);
+        m_content.swap(content);
+        m_sumw2.swap(sumw2);
+        return;
+
+      }  // end 'Rebin(int)'
+
+      // ----------------------------------------------------------------------
+      //! Merge bins into a coarser, variable binning
+      // ----------------------------------------------------------------------
+      /*! Each old bin goes into the new bin containing its
+       *  center, so the new edges should be a subset of the
+       *  old ones. Like `Rebin(int)` (and TH1::Rebin), merged
+       *  bins hold the sum of the old ones, so divide by bin
+       *  width when drawing if a density is wanted, and
+       *  renormalize afterwards if the spectrum had been
+       *  normalized. Old bins falling outside of the new edges
+       *  are added to the under/overflow.
+       */
+      void Rebin(const std::vector<double>& edges) {
+
+        const int nold = GetNbins();
+        const int nnew = (int) edges.size() - 1;
+        if (nnew < 1) return;
+
+        // merge contents, walking through new bins
+        std::vector<double> content(nnew + 2, 0.);
+        std::vector<double> sumw2(nnew + 2, 0.);
+        content[0]        = m_content[0];
+        sumw2[0]          = m_sumw2[0];
+        content[nnew + 1] = m_content[nold + 1];
+        sumw2[nnew + 1]   = m_sumw2[nold + 1];
+
+        int inew = 0;
+        for (int iold = 1; iold <= nold; ++iold) {
+          const double center = 0.5 * (GetEdges()[iold - 1] + GetEdges()[iold]);
+          while ((inew <= nnew) && (center >= edges[inew])) ++inew;
+          content[inew] += m_content[iold];
+          sumw2[inew]   += m_sumw2[iold];
+        }
+
+        m_binning = Binning::Intern(edges);
+        m_content.swap(content);
+        m_sumw2.swap(sumw2);
+        return;
+
+      }  // end 'Rebin(std::vector<double>&)'
+
+      // ----------------------------------------------------------------------
+      //! Load from a ROOT histogram
+      // ----------------------------------------------------------------------
+      void Load(const TH1* hist) {
+
+        // grab names & titles
+        m_name   = hist -> GetName();
+        m_title  = hist -> GetTitle();
+        m_xtitle = hist -> GetXaxis() -> GetTitle();
+        m_ytitle = hist -> GetYaxis() -> GetTitle();
+
+        // grab binning
+        const int nbins = hist -> GetNbinsX();
+        std::vector<double> edges(nbins + 1);
+        for (int ibin = 1; ibin <= nbins + 1; ++ibin) {
+          edges[ibin - 1] = hist -> GetXaxis() -> GetBinLowEdge(ibin);
+        }
+        m_binning = Binning::Intern(edges);
+
+        // and grab contents, errors
+        m_content.assign(nbins + 2, 0.);
+        m_sumw2.assign(nbins + 2, 0.);
+        for (int ibin = 0; ibin <= nbins + 1; ++ibin) {
+          const double err = hist -> GetBinError(ibin);
+          m_content[ibin] = hist -> GetBinContent(ibin);
+          m_sumw2[ibin]   = err * err;
+        }
+        return;
+
+      }  // end 'Load(TH1*)'
+
+      // ----------------------------------------------------------------------
+      //! Copy contents into an existing ROOT histogram
+      // ----------------------------------------------------------------------
+      /*! Assumes the ROOT histogram has the same binning. */
+      void CopyTo(TH1* hist) const {
+
+        hist -> Sumw2();
+        for (int ibin = 0; ibin < GetNcells(); ++ibin) {
+          hist -> SetBinContent(ibin, m_content[ibin]);
+          hist -> SetBinError(ibin, std::sqrt(m_sumw2[ibin]));
+        }
+        return;
+
+      }  // end 'CopyTo(TH1*)'
+
+      // ----------------------------------------------------------------------
+      //! Create a ROOT histogram from this one
+      // ----------------------------------------------------------------------
+      /*! The returned histogram isn't attached to any
+       *  directory, so the caller owns it. Contents are
+       *  stored as a TH1F if `precision` is Type::Float,
+       *  otherwise as a TH1D.
+       */
+      TH1* MakeTH1(const Type::Precision precision = Type::Double) const {
+
+        TH1* hist = NULL;
+        if (precision == Type::Float) {
+          hist = new TH1F(m_name.data(), m_title.data(), GetNbins(), &GetEdges()[0]);
+        } else {
+          hist = new TH1D(m_name.data(), m_title.data(), GetNbins(), &GetEdges()[0]);
+        }
+        hist -> SetDirectory(0);
+        hist -> GetXaxis() -> SetTitle(m_xtitle.data());
+        hist -> GetYaxis() -> SetTitle(m_ytitle.data());
+        CopyTo(hist);
+        return hist;
+
+      }  // end 'MakeTH1(Type::Precision)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Hist1D() : m_binning(Binning::Intern(std::vector<double>())) {};
+      ~Hist1D() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting binning
+      // ----------------------------------------------------------------------
+      Hist1D(
+        const std::string& name,
+        const std::string& title,
+        const std::vector<double>& edges
+      ) {
+        m_name    = name;
+        m_title   = title;
+        m_binning = Binning::Intern(edges);
+        m_content.assign(edges.size() + 1, 0.);
+        m_sumw2.assign(edges.size() + 1, 0.);
+      }  // end ctor(std::string& x 2, std::vector<double>&)
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting an interned binning
+      // ----------------------------------------------------------------------
+      Hist1D(
+        const std::string& name,
+        const std::string& title,
+        const Binning* binning
+      ) {
+        m_name    = name;
+        m_title   = title;
+        m_binning = binning;
+        m_content.assign(binning -> GetNbins() + 2, 0.);
+        m_sumw2.assign(binning -> GetNbins() + 2, 0.);
+      }  // end ctor(std::string& x 2, Binning*)
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a ROOT histogram
+      // ----------------------------------------------------------------------
+      explicit Hist1D(const TH1* hist) {
+        Load(hist);
+      }  // end ctor(TH1*)
+
+  };  // end Hist1D
+
+
+
+  // ==========================================================================
+  //! Native 2D histogram
+  // ==========================================================================
+  /*! The 2D analog of Hist1D. Cells are stored with x
+   *  running fastest, i.e. cell = ix + (nx + 2) * iy,
+   *  which again follows ROOT's global bin numbering.
+   */
+  class Hist2D {
+
+    private:
+
+      // data members
+      std::string         m_name;     ///!< histogram name
+      std::string         m_title;    ///!< histogram title
+      std::string         m_xtitle;   ///!< x-axis title
+      std::string         m_ytitle;   ///!< y-axis title
+      std::string         m_ztitle;   ///!< z-axis title
+      const Binning*      m_xbinning; ///!< interned x binning
+      const Binning*      m_ybinning; ///!< interned y binning
+      std::vector<double> m_content;  ///!< bin contents ((nx + 2) * (ny + 2))
+      std::vector<double> m_sumw2;    ///!< sum of squared weights ((nx + 2) * (ny + 2))
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::string                GetName()   const {return m_name;}
+      std::string                GetTitle()  const {return m_title;}
+      std::string                GetXTitle() const {return m_xtitle;}
+      std::string                GetYTitle() const {return m_ytitle;}
+      std::string                GetZTitle() const {return m_ztitle;}
+      const Binning*             GetXBinning() const {return m_xbinning;}
+      const Binning*             GetYBinning() const {return m_ybinning;}
+      const std::vector<double>& GetXEdges()   const {return m_xbinning -> GetEdges();}
+      const std::vector<double>& GetYEdges()   const {return m_ybinning -> GetEdges();}
+      int                        GetNbinsX()   const {return m_xbinning -> GetNbins();}
+      int                        GetNbinsY()   const {return m_ybinning -> GetNbins();}
+      int                        GetNcells()   const {return (int) m_content.size();}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetName(const std::string& name)     {m_name   = name;}
+      void SetTitle(const std::string& title)   {m_title  = title;}
+      void SetXTitle(const std::string& xtitle) {m_xtitle = xtitle;}
+      void SetYTitle(const std::string& ytitle) {m_ytitle = ytitle;}
+      void SetZTitle(const std::string& ztitle) {m_ztitle = ztitle;}
+
+      // ----------------------------------------------------------------------
+      //! Raw access to storage
+      // ----------------------------------------------------------------------
+      double*       Content()       {return m_content.empty() ? 0 : &m_content[0];}
+      double*       Sumw2()         {return m_sumw2.empty() ? 0 : &m_sumw2[0];}
+      const double* Content() const {return m_content.empty() ? 0 : &m_content[0];}
+      const double* Sumw2()   const {return m_sumw2.empty() ? 0 : &m_sumw2[0];}
+
+      // ----------------------------------------------------------------------
+      //! Global cell index of an (x, y) bin
+      // ----------------------------------------------------------------------
+      int GetBin(const int ix, const int iy) const {return ix + ((GetNbinsX() + 2) * iy);}
+
+      // ----------------------------------------------------------------------
+      //! Bin accessors
+      // ----------------------------------------------------------------------
+      double GetBinContent(const int ix, const int iy) const {return m_content[GetBin(ix, iy)];}
+      double GetBinSumw2(const int ix, const int iy)   const {return m_sumw2[GetBin(ix, iy)];}
+      double GetBinError(const int ix, const int iy)   const {return std::sqrt(m_sumw2[GetBin(ix, iy)]);}
+      double GetXBinCenter(const int ix)               const {return m_xbinning -> GetBinCenter(ix);}
+      double GetYBinCenter(const int iy)               const {return m_ybinning -> GetBinCenter(iy);}
+
+      // ----------------------------------------------------------------------
+      //! Bin modifiers
+      // ----------------------------------------------------------------------
+      void SetBinContent(const int ix, const int iy, const double val) {m_content[GetBin(ix, iy)] = val;}
+      void SetBinSumw2(const int ix, const int iy, const double sumw2) {m_sumw2[GetBin(ix, iy)]   = sumw2;}
+      void SetBinError(const int ix, const int iy, const double err)   {m_sumw2[GetBin(ix, iy)]   = err * err;}
+
+      // ----------------------------------------------------------------------
+      //! Find bins corresponding to a value
+      // ----------------------------------------------------------------------
+      int FindXBin(const double x) const {return m_xbinning -> FindBin(x);}
+      int FindYBin(const double y) const {return m_ybinning -> FindBin(y);}
+
+      // ----------------------------------------------------------------------
+      //! Integrate contents over a range of bins
+      // ----------------------------------------------------------------------
+      double Integral(
+        const int startx,
+        const int stopx,
+        const int starty,
+        const int stopy
+      ) const {
+
+        const int firstx = std::max(startx, 0);
+        const int firsty = std::max(starty, 0);
+        const int lastx  = std::min(stopx, GetNbinsX() + 1);
+        const int lasty  = std::min(stopy, GetNbinsY() + 1);
+
+        double integral = 0.;
+        for (int iy = firsty; iy <= lasty; ++iy) {
+          for (int ix = firstx; ix <= lastx; ++ix) {
+            integral += m_content[GetBin(ix, iy)];
+          }
+        }
+        return integral;
+
+      }  // end 'Integral(int x 4)'
+
+      // ----------------------------------------------------------------------
+      //! Scale contents (and errors)
+      // ----------------------------------------------------------------------
+      void Scale(const double scale) {
+
+        if (m_content.empty()) return;
+        HistMath::Scale(Content(), Sumw2(), m_content.size(), scale);
+        return;
+
+      }  // end 'Scale(double)'
+
+      // ----------------------------------------------------------------------
+      //! Zero contents and errors
+      // ----------------------------------------------------------------------
+      void Reset() {
+
+        std::fill(m_content.begin(), m_content.end(), 0.);
+        std::fill(m_sumw2.begin(), m_sumw2.end(), 0.);
+        return;
+
+      }  // end 'Reset()'
+
+      // ----------------------------------------------------------------------
+      //! Check if binning matches another histogram
+      // ----------------------------------------------------------------------
+      bool IsCompatible(const Hist2D& other) const {
+
+        return (m_xbinning == other.m_xbinning) && (m_ybinning == other.m_ybinning);
+
+      }  // end 'IsCompatible(Hist2D&)'
+
+      // ----------------------------------------------------------------------
+      //! Merge groups of adjacent x and/or y bins
+      // ----------------------------------------------------------------------
+      /*! Leftover bins go to the overflow, as in TH2::Rebin2D. */
+      void Rebin(const int ngroupx, const int ngroupy) {
+
+        const int noldx = GetNbinsX();
+        const int noldy = GetNbinsY();
+        const int gx    = ((ngroupx > 1) && (ngroupx <= noldx)) ? ngroupx : 1;
+        const int gy    = ((ngroupy > 1) && (ngroupy <= noldy)) ? ngroupy : 1;
+        if ((gx == 1) && (gy == 1)) return;
+
+        // collect new edges
+        const int nnewx = noldx / gx;
+        const int nnewy = noldy / gy;
+        std::vector<double> xedges(nnewx + 1);
+        std::vector<double> yedges(nnewy + 1);
+        for (int ix = 0; ix <= nnewx; ++ix) xedges[ix] = GetXEdges()[ix * gx];
+        for (int iy = 0; iy <= nnewy; ++iy) yedges[iy] = GetYEdges()[iy * gy];
+
+        // merge contents
+        const int nnew = (nnewx + 2) * (nnewy + 2);
+        std::vector<double> content(nnew, 0.);
+        std::vector<double> sumw2(nnew, 0.);
+        for (int iy = 0; iy <= noldy + 1; ++iy) {
+          const int jy = (iy == 0) ? 0 : std::min(((iy - 1) / gy) + 1, nnewy + 1);
+          for (int ix = 0; ix <= noldx + 1; ++ix) {
+            const int jx   = (ix == 0) ? 0 : std::min(((ix - 1) / gx) + 1, nnewx + 1);
+            const int jbin = jx + ((nnewx + 2) * jy);
+            content[jbin] += m_content[GetBin(ix, iy)];
+            sumw2[jbin]   += m_sumw2[GetBin(ix, iy)];
+          }
+        }
+
+        m_xbinning = Binning::Intern(xedges);
+        m_ybinning = Binning::Intern(yedges);
+        m_content.swap(content);
+        m_sumw2.swap(sumw2);
+        return;
+
+      }  // end 'Rebin(int, int)'
+
+      // ----------------------------------------------------------------------
+      //! Project onto x axis over a range of y bins
+      // ----------------------------------------------------------------------
+      Hist1D ProjectionX(
+        const std::string& name,
+        const int starty,
+        const int stopy
+      ) const {
+
+        Hist1D proj(name, m_title, m_xbinning);
+        proj.SetXTitle(m_xtitle);
+        proj.SetYTitle(m_ztitle);
+
+        const int firsty = std::max(starty, 0);
+        const int lasty  = std::min(stopy, GetNbinsY() + 1);
+        for (int iy = firsty; iy <= lasty; ++iy) {
+          for (int ix = 0; ix <= GetNbinsX() + 1; ++ix) {
+            proj.Content()[ix] += m_content[GetBin(ix, iy)];
+            proj.Sumw2()[ix]   += m_sumw2[GetBin(ix, iy)];
+          }
+        }
+        return proj;
+
+      }  // end 'ProjectionX(std::string&, int, int)'
+
+      // ----------------------------------------------------------------------
+      //! Project onto y axis over a range of x bins
+      // ----------------------------------------------------------------------
+      Hist1D ProjectionY(
+        const std::string& name,
+        const int startx,
+        const int stopx
+      ) const {
+
+        Hist1D proj(name, m_title, m_ybinning);
+        proj.SetXTitle(m_ytitle);
+        proj.SetYTitle(m_ztitle);
+
+        const int firstx = std::max(startx, 0);
+        const int lastx  = std::min(stopx, GetNbinsX() + 1);
+        for (int iy = 0; iy <= GetNbinsY() + 1; ++iy) {
+          for (int ix = firstx; ix <= lastx; ++ix) {
+            proj.Content()[iy] += m_content[GetBin(ix, iy)];
+            proj.Sumw2()[iy]   += m_sumw2[GetBin(ix, iy)];
+          }
+        }
+        return proj;
+
+      }  // end 'ProjectionY(std::string&, int, int)'
+
+      // ----------------------------------------------------------------------
+      //! Load from a ROOT histogram
+      // ----------------------------------------------------------------------
+      void Load(const TH2* hist) {
+
+        // grab names & titles
+        m_name   = hist -> GetName();
+        m_title  = hist -> GetTitle();
+        m_xtitle = hist -> GetXaxis() -> GetTitle();
+        m_ytitle = hist -> GetYaxis() -> GetTitle();
+        m_ztitle = hist -> GetZaxis() -> GetTitle();
+
+        // grab binning
+        const int nx = hist -> GetNbinsX();
+        const int ny = hist -> GetNbinsY();
+        std::vector<double> xedges(nx + 1);
+        std::vector<double> yedges(ny + 1);
+        for (int ix = 1; ix <= nx + 1; ++ix) {
+          xedges[ix - 1] = hist -> GetXaxis() -> GetBinLowEdge(ix);
+        }
+        for (int iy = 1; iy <= ny + 1; ++iy) {
+          yedges[iy - 1] = hist -> GetYaxis() -> GetBinLowEdge(iy);
+        }
+        m_xbinning = Binning::Intern(xedges);
+        m_ybinning = Binning::Intern(yedges);
+
+        // and grab contents, errors
+        m_content.assign((nx + 2) * (ny + 2), 0.);
+        m_sumw2.assign((nx + 2) * (ny + 2), 0.);
+        for (int iy = 0; iy <= ny + 1; ++iy) {
+          for (int ix = 0; ix <= nx + 1; ++ix) {
+            const double err = hist -> GetBinError(ix, iy);
+            m_content[GetBin(ix, iy)] = hist -> GetBinContent(ix, iy);
+            m_sumw2[GetBin(ix, iy)]   = err * err;
+          }
+        }
+        return;
+
+      }  // end 'Load(TH2*)'
+
+      // ----------------------------------------------------------------------
+      //! Copy contents into an existing ROOT histogram
+      // ----------------------------------------------------------------------
+      /*! Assumes the ROOT histogram has the same binning. */
+      void CopyTo(TH2* hist) const {
+
+        hist -> Sumw2();
+        for (int iy = 0; iy <= GetNbinsY() + 1; ++iy) {
+          for (int ix = 0; ix <= GetNbinsX() + 1; ++ix) {
+            hist -> SetBinContent(ix, iy, m_content[GetBin(ix, iy)]);
+            hist -> SetBinError(ix, iy, std::sqrt(m_sumw2[GetBin(ix, iy)]));
+          }
+        }
+        return;
+
+      }  // end 'CopyTo(TH2*)'
+
+      // ----------------------------------------------------------------------
+      //! Create a ROOT histogram from this one
+      // ----------------------------------------------------------------------
+      /*! The returned histogram isn't attached to any
+       *  directory, so the caller owns it. Contents are
+       *  stored as a TH2F if `precision` is Type::Float,
+       *  otherwise as a TH2D.
+       */
+      TH2* MakeTH2(const Type::Precision precision = Type::Double) const {
+
+        TH2* hist = NULL;
+        if (precision == Type::Float) {
+          hist = new TH2F(
+            m_name.data(),
+            m_title.data(),
+            GetNbinsX(),
+            &GetXEdges()[0],
+            GetNbinsY(),
+            &GetYEdges()[0]
+          );
+        } else {
+          hist = new TH2D(
+            m_name.data(),
+            m_title.data(),
+            GetNbinsX(),
+            &GetXEdges()[0],
+            GetNbinsY(),
+            &GetYEdges()[0]
+          );
+        }
+        hist -> SetDirectory(0);
+        hist -> GetXaxis() -> SetTitle(m_xtitle.data());
+        hist -> GetYaxis() -> SetTitle(m_ytitle.data());
+        hist -> GetZaxis() -> SetTitle(m_ztitle.data());
+        CopyTo(hist);
+        return hist;
+
+      }  // end 'MakeTH2(Type::Precision)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Hist2D() : m_xbinning(Binning::Intern(std::vector<double>())), m_ybinning(Binning::Intern(std::vector<double>())) {};
+      ~Hist2D() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting binning
+      // ----------------------------------------------------------------------
+      Hist2D(
+        const std::string& name,
+        const std::string& title,
+        const std::vector<double>& xedges,
+        const std::vector<double>& yedges
+      ) {
+        m_name   = name;
+        m_title  = title;
+        m_xbinning = Binning::Intern(xedges);
+        m_ybinning = Binning::Intern(yedges);
+        m_content.assign((xedges.size() + 1) * (yedges.size() + 1), 0.);
+        m_sumw2.assign((xedges.size() + 1) * (yedges.size() + 1), 0.);
+      }  // end ctor(std::string& x 2, std::vector<double>& x 2)
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a ROOT histogram
+      // ----------------------------------------------------------------------
+      explicit Hist2D(const TH2* hist) {
+        Load(hist);
+      }  // end ctor(TH2*)
+
+  };  // end Hist2D
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,238 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorHistCompare.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Bin-by-bin comparison of histograms, e.g. to check
+ *  the accuracy of reduced-precision outputs.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORHISTCOMPARE_H
+#define PHCORRELATORHISTCOMPARE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+// root libraries
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+
+
+
+namespace PHEnergyCorrelator {
+  namespace HistCompare {
+
+    // ------------------------------------------------------------------------
+    //! Result of a comparison
+    // ------------------------------------------------------------------------
+    /*! Relative deviations are taken with respect to the
+     *  reference histogram; bins where the reference is
+     *  zero only contribute to the absolute deviations.
+     */
+    struct Result {
+
+      // members
+      bool   compatible;   ///!< false if the no. of bins differ
+      int    ncells;       ///!< no. of cells compared (incl. under/overflow)
+      int    worst_cell;   ///!< global bin w/ largest relative content deviation
+      double max_abs;      ///!< largest absolute deviation of contents
+      double max_rel;      ///!< largest relative deviation of contents
+      double max_abs_err;  ///!< largest absolute deviation of errors
+      double max_rel_err;  ///!< largest relative deviation of errors
+
+      // ----------------------------------------------------------------------
+      //! default ctor
+      // ----------------------------------------------------------------------
+      Result() {
+        compatible  = true;
+        ncells      = 0;
+        worst_cell  = -1;
+        max_abs     = 0.;
+        max_rel     = 0.;
+        max_abs_err = 0.;
+        max_rel_err = 0.;
+      };
+
+      // ----------------------------------------------------------------------
+      //! Check if all relative deviations are within a tolerance
+      // ----------------------------------------------------------------------
+      bool IsWithin(const double tolerance) const {
+
+        return compatible && (max_rel <= tolerance) && (max_rel_err <= tolerance);
+
+      }  // end 'IsWithin(double)'
+
+    };  // end Result
+
+
+
+    // ------------------------------------------------------------------------
+    //! Expected relative rounding of a storage precision
+    // ------------------------------------------------------------------------
+    /*! Half an ulp, i.e. the largest relative deviation
+     *  rounding a double into the given precision should
+     *  introduce.
+     */
+    double Tolerance(const Type::Precision precision) {
+
+      return (precision == Type::Float) ? std::pow(2., -24) : std::pow(2., -53);
+
+    }  // end 'Tolerance(Type::Precision)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Update deviations with one cell
+    // ------------------------------------------------------------------------
+    void Accumulate(
+      const int cell,
+      const double ref,
+      const double test,
+      const double ref_err,
+      const double test_err,
+      Result& result
+    ) {
+
+      const double diff     = std::fabs(test - ref);
+      const double diff_err = std::fabs(test_err - ref_err);
+      result.max_abs     = std::max(result.max_abs, diff);
+      result.max_abs_err = std::max(result.max_abs_err, diff_err);
+      if ((ref != 0.) && ((diff / std::fabs(ref)) > result.max_rel)) {
+        result.max_rel    = diff / std::fabs(ref);
+        result.worst_cell = cell;
+      }
+      if (ref_err != 0.) {
+        result.max_rel_err = std::max(result.max_rel_err, diff_err / std::fabs(ref_err));
+      }
+      ++result.ncells;
+      return;
+
+    }  // end 'Accumulate(int, double x 4, Result&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare two ROOT histograms bin-by-bin
+    // ------------------------------------------------------------------------
+    /*! Works for histograms of any dimension. Only the
+     *  no. of cells is checked, not the edges.
+     */
+    Result Compare(const TH1* ref, const TH1* test) {
+
+      Result result;
+
+      const int ncells = (ref -> GetNbinsX() + 2) * (ref -> GetNbinsY() + 2) * (ref -> GetNbinsZ() + 2);
+      const int ntest  = (test -> GetNbinsX() + 2) * (test -> GetNbinsY() + 2) * (test -> GetNbinsZ() + 2);
+      if (ncells != ntest) {
+        result.compatible = false;
+        return result;
+      }
+
+      for (int icell = 0; icell < ncells; ++icell) {
+        Accumulate(
+          icell,
+          ref -> GetBinContent(icell),
+          test -> GetBinContent(icell),
+          ref -> GetBinError(icell),
+          test -> GetBinError(icell),
+          result
+        );
+      }
+      return result;
+
+    }  // end 'Compare(TH1*, TH1*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare a native 1D histogram to a stored ROOT one
+    // ------------------------------------------------------------------------
+    /*! Useful for checking what's lost when a (double
+     *  precision) result is stored with reduced precision.
+     */
+    Result Compare(const Hist1D& ref, const TH1* test) {
+
+      Result result;
+      if ((ref.GetNbins() != test -> GetNbinsX()) || (test -> GetDimension() != 1)) {
+        result.compatible = false;
+        return result;
+      }
+
+      for (int ibin = 0; ibin <= ref.GetNbins() + 1; ++ibin) {
+        Accumulate(
+          ibin,
+          ref.GetBinContent(ibin),
+          test -> GetBinContent(ibin),
+          ref.GetBinError(ibin),
+          test -> GetBinError(ibin),
+          result
+        );
+      }
+      return result;
+
+    }  // end 'Compare(Hist1D&, TH1*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare a native 2D histogram to a stored ROOT one
+    // ------------------------------------------------------------------------
+    Result Compare(const Hist2D& ref, const TH1* test) {
+
+      Result result;
+      if (
+        (ref.GetNbinsX() != test -> GetNbinsX()) ||
+        (ref.GetNbinsY() != test -> GetNbinsY()) ||
+        (test -> GetDimension() != 2)
+      ) {
+        result.compatible = false;
+        return result;
+      }
+
+      for (int iy = 0; iy <= ref.GetNbinsY() + 1; ++iy) {
+        for (int ix = 0; ix <= ref.GetNbinsX() + 1; ++ix) {
+          Accumulate(
+            ref.GetBin(ix, iy),
+            ref.GetBinContent(ix, iy),
+            test -> GetBinContent(ix, iy),
+            ref.GetBinError(ix, iy),
+            test -> GetBinError(ix, iy),
+            result
+          );
+        }
+      }
+      return result;
+
+    }  // end 'Compare(Hist2D&, TH1*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Print a summary of a comparison
+    // ------------------------------------------------------------------------
+    void Print(const std::string& name, const Result& result, std::ostream& out = std::cout) {
+
+      if (!result.compatible) {
+        out << "      " << name << ": incompatible binning" << std::endl;
+        return;
+      }
+      out << "      " << name << ": " << result.ncells << " cells\n"
+          << "        max. content deviation = " << result.max_abs
+          << " (relative = " << result.max_rel << ", cell " << result.worst_cell << ")\n"
+          << "        max. error deviation   = " << result.max_abs_err
+          << " (relative = " << result.max_rel_err << ")"
+          << std::endl;
+      return;
+
+    }  // end 'Print(std::string&, Result&, std::ostream&)'
+
+  }  // end HistCompare namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,954 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorHistMath.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Bin-by-bin histogram arithmetic on contiguous
+ *  content/sumw2 arrays.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORHISTMATH_H
+#define PHCORRELATORHISTMATH_H
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// SIMD availability
+// ----------------------------------------------------------------------------
+/*  Vectorized kernels are only built when the library is
+ *  compiled (e.g. via ACLiC) on x86 with a compiler that
+ *  supports per-function target attributes. AVX2 needs
+ *  gcc >= 4.9 (or clang >= 3.8) and AVX-512 needs gcc >= 5
+ *  (or clang >= 3.9); anything older (or interpreted) uses
+ *  the SSE2 and/or scalar paths.
+ */
+#if !defined(__CINT__) && !defined(__CLING__) && (defined(__x86_64__) || defined(__i386__))
+  #if defined(__SSE2__)
+    #define PHEC_HISTMATH_SSE2
+    #include <emmintrin.h>
+  #endif
+  #if defined(__clang__)
+    #if (__clang_major__ > 3) || ((__clang_major__ == 3) && (__clang_minor__ >= 8))
+      #define PHEC_HISTMATH_AVX2
+    #endif
+    #if (__clang_major__ > 3) || ((__clang_major__ == 3) && (__clang_minor__ >= 9))
+      #define PHEC_HISTMATH_AVX512
+    #endif
+  #elif defined(__GNUC__)
+    #if (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))
+      #define PHEC_HISTMATH_AVX2
+    #endif
+    #if (__GNUC__ >= 5)
+      #define PHEC_HISTMATH_AVX512
+    #endif
+  #endif
+  #if defined(PHEC_HISTMATH_AVX2) || defined(PHEC_HISTMATH_AVX512)
+    #include <immintrin.h>
+  #endif
+#endif
+
+
+
+namespace PHEnergyCorrelator {
+  namespace HistMath {
+
+    // ------------------------------------------------------------------------
+    //! Available code paths
+    // ------------------------------------------------------------------------
+    enum Path {Scalar, SSE2, AVX2, AVX512};
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get name of a code path
+    // ------------------------------------------------------------------------
+    std::string PathName(const Path path) {
+
+      switch (path) {
+        case SSE2:
+          return "SSE2";
+        case AVX2:
+          return "AVX2";
+        case AVX512:
+          return "AVX-512";
+        default:
+          return "Scalar";
+      }
+
+    }  // end 'PathName(Path)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Determine best path supported by both build and CPU
+    // ------------------------------------------------------------------------
+    Path DetectPath() {
+
+      Path path = Scalar;
+#ifdef PHEC_HISTMATH_SSE2
+      path = SSE2;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+      if (__builtin_cpu_supports("avx2")) path = AVX2;
+#endif
+#ifdef PHEC_HISTMATH_AVX512
+      if (__builtin_cpu_supports("avx512f")) path = AVX512;
+#endif
+      return path;
+
+    }  // end 'DetectPath()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Access path currently in use
+    // ------------------------------------------------------------------------
+    Path& ActivePath() {
+
+      static Path path = DetectPath();
+      return path;
+
+    }  // end 'ActivePath()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Force a particular path
+    // ------------------------------------------------------------------------
+    /*! Requests for a path the CPU (or build) doesn't
+     *  support fall back to the best available one.
+     */
+    void SetPath(const Path path) {
+
+      ActivePath() = std::min(path, DetectPath());
+      return;
+
+    }  // end 'SetPath(Path)'
+
+
+
+    // scalar reference kernels ===============================================
+
+    // ------------------------------------------------------------------------
+    //! Scale contents by c (errors by c^2)
+    // ------------------------------------------------------------------------
+    void ScaleScalar(
+      double* content,
+      double* sumw2,
+      const std::size_t start,
+      const std::size_t size,
+      const double c
+    ) {
+
+      const double c2 = c * c;
+      for (std::size_t i = start; i < size; ++i) {
+        content[i] *= c;
+        sumw2[i]   *= c2;
+      }
+      return;
+
+    }  // end 'ScaleScalar(double* x 2, std::size_t x 2, double)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = c1 * a + c2 * b
+    // ------------------------------------------------------------------------
+    void AddScalar(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t start,
+      const std::size_t size,
+      const double c1,
+      const double c2
+    ) {
+
+      const double c1sq = c1 * c1;
+      const double c2sq = c2 * c2;
+      for (std::size_t i = start; i < size; ++i) {
+        co[i] = (c1 * ca[i]) + (c2 * cb[i]);
+        so[i] = (c1sq * sa[i]) + (c2sq * sb[i]);
+      }
+      return;
+
+    }  // end 'AddScalar(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (c1 * a) * (c2 * b)
+    // ------------------------------------------------------------------------
+    void MultiplyScalar(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t start,
+      const std::size_t size,
+      const double c1,
+      const double c2
+    ) {
+
+      const double w  = c1 * c2;
+      const double w2 = w * w;
+      for (std::size_t i = start; i < size; ++i) {
+        const double a = ca[i];
+        const double b = cb[i];
+        co[i] = w * a * b;
+        so[i] = w2 * ((sa[i] * b * b) + (sb[i] * a * a));
+      }
+      return;
+
+    }  // end 'MultiplyScalar(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (c1 * a) / (c2 * b)
+    // ------------------------------------------------------------------------
+    /*! Errors follow TH1::Divide (uncorrelated), and bins
+     *  with b = 0 are set to 0.
+     */
+    void DivideScalar(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t start,
+      const std::size_t size,
+      const double c1,
+      const double c2
+    ) {
+
+      const double r  = c1 / c2;
+      const double r2 = r * r;
+      for (std::size_t i = start; i < size; ++i) {
+        const double b = cb[i];
+        if (b == 0.) {
+          co[i] = 0.;
+          so[i] = 0.;
+          continue;
+        }
+        const double inv = 1. / b;
+        const double q   = ca[i] * inv;
+        co[i] = r * q;
+        so[i] = r2 * inv * inv * (sa[i] + (sb[i] * q * q));
+      }
+      return;
+
+    }  // end 'DivideScalar(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (u - R d) / (P (u + R d))
+    // ------------------------------------------------------------------------
+    /*! Luminosity-weighted spin asymmetry of two spin
+     *  states u and d, with R the relative luminosity
+     *  L(u) / L(d) and P the polarization. Errors on u and
+     *  d are treated as uncorrelated, and the uncertainty
+     *  on P (dp) is added in quadrature. Bins with
+     *  u + R d = 0 are set to 0.
+     */
+    void AsymmetryScalar(
+      const double* cu, const double* su,
+      const double* cd, const double* sd,
+      double* co, double* so,
+      const std::size_t start,
+      const std::size_t size,
+      const double lumi,
+      const double pol,
+      const double dpol
+    ) {
+
+      const double r2x4 = 4. * lumi * lumi;
+      const double ipol = 1. / pol;
+      const double k    = (dpol * dpol) * (ipol * ipol);
+      for (std::size_t i = start; i < size; ++i) {
+        const double u   = cu[i];
+        const double d   = cd[i];
+        const double sum = u + (lumi * d);
+        if (sum == 0.) {
+          co[i] = 0.;
+          so[i] = 0.;
+          continue;
+        }
+        const double inv  = 1. / sum;
+        const double inv2 = inv * inv;
+        const double a    = (u - (lumi * d)) * inv;
+        const double vara = r2x4 * (inv2 * inv2) * ((d * d * su[i]) + (u * u * sd[i]));
+        co[i] = a * ipol;
+        so[i] = (ipol * ipol) * (vara + (a * a * k));
+      }
+      return;
+
+    }  // end 'AsymmetryScalar(...)'
+
+
+
+#ifdef PHEC_HISTMATH_SSE2
+    // SSE2 kernels ===========================================================
+
+    void ScaleSSE2(double* content, double* sumw2, const std::size_t size, const double c) {
+
+      const __m128d vc  = _mm_set1_pd(c);
+      const __m128d vc2 = _mm_set1_pd(c * c);
+      std::size_t i = 0;
+      for (; i + 2 <= size; i += 2) {
+        _mm_storeu_pd(content + i, _mm_mul_pd(_mm_loadu_pd(content + i), vc));
+        _mm_storeu_pd(sumw2 + i, _mm_mul_pd(_mm_loadu_pd(sumw2 + i), vc2));
+      }
+      ScaleScalar(content, sumw2, i, size, c);
+      return;
+
+    }  // end 'ScaleSSE2(...)'
+
+    void AddSSE2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m128d v1  = _mm_set1_pd(c1);
+      const __m128d v2  = _mm_set1_pd(c2);
+      const __m128d v1s = _mm_set1_pd(c1 * c1);
+      const __m128d v2s = _mm_set1_pd(c2 * c2);
+      std::size_t i = 0;
+      for (; i + 2 <= size; i += 2) {
+        _mm_storeu_pd(co + i, _mm_add_pd(_mm_mul_pd(v1, _mm_loadu_pd(ca + i)), _mm_mul_pd(v2, _mm_loadu_pd(cb + i))));
+        _mm_storeu_pd(so + i, _mm_add_pd(_mm_mul_pd(v1s, _mm_loadu_pd(sa + i)), _mm_mul_pd(v2s, _mm_loadu_pd(sb + i))));
+      }
+      AddScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'AddSSE2(...)'
+
+    void MultiplySSE2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m128d vw  = _mm_set1_pd(c1 * c2);
+      const __m128d vw2 = _mm_set1_pd((c1 * c2) * (c1 * c2));
+      std::size_t i = 0;
+      for (; i + 2 <= size; i += 2) {
+        const __m128d a = _mm_loadu_pd(ca + i);
+        const __m128d b = _mm_loadu_pd(cb + i);
+        const __m128d t = _mm_add_pd(
+          _mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(sa + i), b), b),
+          _mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(sb + i), a), a)
+        );
+        _mm_storeu_pd(co + i, _mm_mul_pd(_mm_mul_pd(vw, a), b));
+        _mm_storeu_pd(so + i, _mm_mul_pd(vw2, t));
+      }
+      MultiplyScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'MultiplySSE2(...)'
+
+    void DivideSSE2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m128d vr   = _mm_set1_pd(c1 / c2);
+      const __m128d vr2  = _mm_set1_pd((c1 / c2) * (c1 / c2));
+      const __m128d one  = _mm_set1_pd(1.);
+      const __m128d zero = _mm_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 2 <= size; i += 2) {
+        const __m128d b    = _mm_loadu_pd(cb + i);
+        const __m128d mask = _mm_cmpneq_pd(b, zero);
+        const __m128d inv  = _mm_div_pd(one, b);
+        const __m128d q    = _mm_mul_pd(_mm_loadu_pd(ca + i), inv);
+        const __m128d t    = _mm_add_pd(_mm_loadu_pd(sa + i), _mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(sb + i), q), q));
+        _mm_storeu_pd(co + i, _mm_and_pd(mask, _mm_mul_pd(vr, q)));
+        _mm_storeu_pd(so + i, _mm_and_pd(mask, _mm_mul_pd(_mm_mul_pd(_mm_mul_pd(vr2, inv), inv), t)));
+      }
+      DivideScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'DivideSSE2(...)'
+
+    void AsymmetrySSE2(
+      const double* cu, const double* su, const double* cd, const double* sd,
+      double* co, double* so, const std::size_t size, const double lumi, const double pol, const double dpol
+    ) {
+
+      const __m128d vr    = _mm_set1_pd(lumi);
+      const __m128d vr2x4 = _mm_set1_pd(4. * lumi * lumi);
+      const __m128d vip   = _mm_set1_pd(1. / pol);
+      const __m128d vip2  = _mm_set1_pd(1. / (pol * pol));
+      const __m128d vk    = _mm_set1_pd((dpol * dpol) / (pol * pol));
+      const __m128d one   = _mm_set1_pd(1.);
+      const __m128d zero  = _mm_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 2 <= size; i += 2) {
+        const __m128d u    = _mm_loadu_pd(cu + i);
+        const __m128d d    = _mm_loadu_pd(cd + i);
+        const __m128d rd   = _mm_mul_pd(vr, d);
+        const __m128d sum  = _mm_add_pd(u, rd);
+        const __m128d mask = _mm_cmpneq_pd(sum, zero);
+        const __m128d inv  = _mm_div_pd(one, sum);
+        const __m128d inv2 = _mm_mul_pd(inv, inv);
+        const __m128d a    = _mm_mul_pd(_mm_sub_pd(u, rd), inv);
+        const __m128d t    = _mm_add_pd(
+          _mm_mul_pd(_mm_mul_pd(d, d), _mm_loadu_pd(su + i)),
+          _mm_mul_pd(_mm_mul_pd(u, u), _mm_loadu_pd(sd + i))
+        );
+        const __m128d vara = _mm_mul_pd(_mm_mul_pd(vr2x4, _mm_mul_pd(inv2, inv2)), t);
+        _mm_storeu_pd(co + i, _mm_and_pd(mask, _mm_mul_pd(a, vip)));
+        _mm_storeu_pd(so + i, _mm_and_pd(mask, _mm_mul_pd(vip2, _mm_add_pd(vara, _mm_mul_pd(_mm_mul_pd(a, a), vk)))));
+      }
+      AsymmetryScalar(cu, su, cd, sd, co, so, i, size, lumi, pol, dpol);
+      return;
+
+    }  // end 'AsymmetrySSE2(...)'
+#endif
+
+
+
+#ifdef PHEC_HISTMATH_AVX2
+    // AVX2 kernels ===========================================================
+
+    __attribute__((target("avx2")))
+    void ScaleAVX2(double* content, double* sumw2, const std::size_t size, const double c) {
+
+      const __m256d vc  = _mm256_set1_pd(c);
+      const __m256d vc2 = _mm256_set1_pd(c * c);
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        _mm256_storeu_pd(content + i, _mm256_mul_pd(_mm256_loadu_pd(content + i), vc));
+        _mm256_storeu_pd(sumw2 + i, _mm256_mul_pd(_mm256_loadu_pd(sumw2 + i), vc2));
+      }
+      ScaleScalar(content, sumw2, i, size, c);
+      return;
+
+    }  // end 'ScaleAVX2(...)'
+
+    __attribute__((target("avx2")))
+    void AddAVX2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m256d v1  = _mm256_set1_pd(c1);
+      const __m256d v2  = _mm256_set1_pd(c2);
+      const __m256d v1s = _mm256_set1_pd(c1 * c1);
+      const __m256d v2s = _mm256_set1_pd(c2 * c2);
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        _mm256_storeu_pd(co + i, _mm256_add_pd(_mm256_mul_pd(v1, _mm256_loadu_pd(ca + i)), _mm256_mul_pd(v2, _mm256_loadu_pd(cb + i))));
+        _mm256_storeu_pd(so + i, _mm256_add_pd(_mm256_mul_pd(v1s, _mm256_loadu_pd(sa + i)), _mm256_mul_pd(v2s, _mm256_loadu_pd(sb + i))));
+      }
+      AddScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'AddAVX2(...)'
+
+    __attribute__((target("avx2")))
+    void MultiplyAVX2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m256d vw  = _mm256_set1_pd(c1 * c2);
+      const __m256d vw2 = _mm256_set1_pd((c1 * c2) * (c1 * c2));
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        const __m256d a = _mm256_loadu_pd(ca + i);
+        const __m256d b = _mm256_loadu_pd(cb + i);
+        const __m256d t = _mm256_add_pd(
+          _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(sa + i), b), b),
+          _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(sb + i), a), a)
+        );
+        _mm256_storeu_pd(co + i, _mm256_mul_pd(_mm256_mul_pd(vw, a), b));
+        _mm256_storeu_pd(so + i, _mm256_mul_pd(vw2, t));
+      }
+      MultiplyScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'MultiplyAVX2(...)'
+
+    __attribute__((target("avx2")))
+    void DivideAVX2(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m256d vr   = _mm256_set1_pd(c1 / c2);
+      const __m256d vr2  = _mm256_set1_pd((c1 / c2) * (c1 / c2));
+      const __m256d one  = _mm256_set1_pd(1.);
+      const __m256d zero = _mm256_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        const __m256d b    = _mm256_loadu_pd(cb + i);
+        const __m256d mask = _mm256_cmp_pd(b, zero, _CMP_NEQ_UQ);
+        const __m256d inv  = _mm256_div_pd(one, b);
+        const __m256d q    = _mm256_mul_pd(_mm256_loadu_pd(ca + i), inv);
+        const __m256d t    = _mm256_add_pd(_mm256_loadu_pd(sa + i), _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(sb + i), q), q));
+        _mm256_storeu_pd(co + i, _mm256_and_pd(mask, _mm256_mul_pd(vr, q)));
+        _mm256_storeu_pd(so + i, _mm256_and_pd(mask, _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(vr2, inv), inv), t)));
+      }
+      DivideScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'DivideAVX2(...)'
+
+    __attribute__((target("avx2")))
+    void AsymmetryAVX2(
+      const double* cu, const double* su, const double* cd, const double* sd,
+      double* co, double* so, const std::size_t size, const double lumi, const double pol, const double dpol
+    ) {
+
+      const __m256d vr    = _mm256_set1_pd(lumi);
+      const __m256d vr2x4 = _mm256_set1_pd(4. * lumi * lumi);
+      const __m256d vip   = _mm256_set1_pd(1. / pol);
+      const __m256d vip2  = _mm256_set1_pd(1. / (pol * pol));
+      const __m256d vk    = _mm256_set1_pd((dpol * dpol) / (pol * pol));
+      const __m256d one   = _mm256_set1_pd(1.);
+      const __m256d zero  = _mm256_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        const __m256d u    = _mm256_loadu_pd(cu + i);
+        const __m256d d    = _mm256_loadu_pd(cd + i);
+        const __m256d rd   = _mm256_mul_pd(vr, d);
+        const __m256d sum  = _mm256_add_pd(u, rd);
+        const __m256d mask = _mm256_cmp_pd(sum, zero, _CMP_NEQ_UQ);
+        const __m256d inv  = _mm256_div_pd(one, sum);
+        const __m256d inv2 = _mm256_mul_pd(inv, inv);
+        const __m256d a    = _mm256_mul_pd(_mm256_sub_pd(u, rd), inv);
+        const __m256d t    = _mm256_add_pd(
+          _mm256_mul_pd(_mm256_mul_pd(d, d), _mm256_loadu_pd(su + i)),
+          _mm256_mul_pd(_mm256_mul_pd(u, u), _mm256_loadu_pd(sd + i))
+        );
+        const __m256d vara = _mm256_mul_pd(_mm256_mul_pd(vr2x4, _mm256_mul_pd(inv2, inv2)), t);
+        _mm256_storeu_pd(co + i, _mm256_and_pd(mask, _mm256_mul_pd(a, vip)));
+        _mm256_storeu_pd(so + i, _mm256_and_pd(mask, _mm256_mul_pd(vip2, _mm256_add_pd(vara, _mm256_mul_pd(_mm256_mul_pd(a, a), vk)))));
+      }
+      AsymmetryScalar(cu, su, cd, sd, co, so, i, size, lumi, pol, dpol);
+      return;
+
+    }  // end 'AsymmetryAVX2(...)'
+#endif
+
+
+
+#ifdef PHEC_HISTMATH_AVX512
+    // AVX-512 kernels ========================================================
+
+    __attribute__((target("avx512f")))
+    void ScaleAVX512(double* content, double* sumw2, const std::size_t size, const double c) {
+
+      const __m512d vc  = _mm512_set1_pd(c);
+      const __m512d vc2 = _mm512_set1_pd(c * c);
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        _mm512_storeu_pd(content + i, _mm512_mul_pd(_mm512_loadu_pd(content + i), vc));
+        _mm512_storeu_pd(sumw2 + i, _mm512_mul_pd(_mm512_loadu_pd(sumw2 + i), vc2));
+      }
+      ScaleScalar(content, sumw2, i, size, c);
+      return;
+
+    }  // end 'ScaleAVX512(...)'
+
+    __attribute__((target("avx512f")))
+    void AddAVX512(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m512d v1  = _mm512_set1_pd(c1);
+      const __m512d v2  = _mm512_set1_pd(c2);
+      const __m512d v1s = _mm512_set1_pd(c1 * c1);
+      const __m512d v2s = _mm512_set1_pd(c2 * c2);
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        _mm512_storeu_pd(co + i, _mm512_add_pd(_mm512_mul_pd(v1, _mm512_loadu_pd(ca + i)), _mm512_mul_pd(v2, _mm512_loadu_pd(cb + i))));
+        _mm512_storeu_pd(so + i, _mm512_add_pd(_mm512_mul_pd(v1s, _mm512_loadu_pd(sa + i)), _mm512_mul_pd(v2s, _mm512_loadu_pd(sb + i))));
+      }
+      AddScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'AddAVX512(...)'
+
+    __attribute__((target("avx512f")))
+    void MultiplyAVX512(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m512d vw  = _mm512_set1_pd(c1 * c2);
+      const __m512d vw2 = _mm512_set1_pd((c1 * c2) * (c1 * c2));
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        const __m512d a = _mm512_loadu_pd(ca + i);
+        const __m512d b = _mm512_loadu_pd(cb + i);
+        const __m512d t = _mm512_add_pd(
+          _mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(sa + i), b), b),
+          _mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(sb + i), a), a)
+        );
+        _mm512_storeu_pd(co + i, _mm512_mul_pd(_mm512_mul_pd(vw, a), b));
+        _mm512_storeu_pd(so + i, _mm512_mul_pd(vw2, t));
+      }
+      MultiplyScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'MultiplyAVX512(...)'
+
+    __attribute__((target("avx512f")))
+    void DivideAVX512(
+      const double* ca, const double* sa, const double* cb, const double* sb,
+      double* co, double* so, const std::size_t size, const double c1, const double c2
+    ) {
+
+      const __m512d vr   = _mm512_set1_pd(c1 / c2);
+      const __m512d vr2  = _mm512_set1_pd((c1 / c2) * (c1 / c2));
+      const __m512d one  = _mm512_set1_pd(1.);
+      const __m512d zero = _mm512_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        const __m512d   b    = _mm512_loadu_pd(cb + i);
+        const __mmask8  mask = _mm512_cmp_pd_mask(b, zero, _CMP_NEQ_UQ);
+        const __m512d   inv  = _mm512_div_pd(one, b);
+        const __m512d   q    = _mm512_mul_pd(_mm512_loadu_pd(ca + i), inv);
+        const __m512d   t    = _mm512_add_pd(_mm512_loadu_pd(sa + i), _mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(sb + i), q), q));
+        _mm512_storeu_pd(co + i, _mm512_maskz_mov_pd(mask, _mm512_mul_pd(vr, q)));
+        _mm512_storeu_pd(so + i, _mm512_maskz_mov_pd(mask, _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(vr2, inv), inv), t)));
+      }
+      DivideScalar(ca, sa, cb, sb, co, so, i, size, c1, c2);
+      return;
+
+    }  // end 'DivideAVX512(...)'
+
+    __attribute__((target("avx512f")))
+    void AsymmetryAVX512(
+      const double* cu, const double* su, const double* cd, const double* sd,
+      double* co, double* so, const std::size_t size, const double lumi, const double pol, const double dpol
+    ) {
+
+      const __m512d vr    = _mm512_set1_pd(lumi);
+      const __m512d vr2x4 = _mm512_set1_pd(4. * lumi * lumi);
+      const __m512d vip   = _mm512_set1_pd(1. / pol);
+      const __m512d vip2  = _mm512_set1_pd(1. / (pol * pol));
+      const __m512d vk    = _mm512_set1_pd((dpol * dpol) / (pol * pol));
+      const __m512d one   = _mm512_set1_pd(1.);
+      const __m512d zero  = _mm512_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        const __m512d  u    = _mm512_loadu_pd(cu + i);
+        const __m512d  d    = _mm512_loadu_pd(cd + i);
+        const __m512d  rd   = _mm512_mul_pd(vr, d);
+        const __m512d  sum  = _mm512_add_pd(u, rd);
+        const __mmask8 mask = _mm512_cmp_pd_mask(sum, zero, _CMP_NEQ_UQ);
+        const __m512d  inv  = _mm512_div_pd(one, sum);
+        const __m512d  inv2 = _mm512_mul_pd(inv, inv);
+        const __m512d  a    = _mm512_mul_pd(_mm512_sub_pd(u, rd), inv);
+        const __m512d  t    = _mm512_add_pd(
+          _mm512_mul_pd(_mm512_mul_pd(d, d), _mm512_loadu_pd(su + i)),
+          _mm512_mul_pd(_mm512_mul_pd(u, u), _mm512_loadu_pd(sd + i))
+        );
+        const __m512d  vara = _mm512_mul_pd(_mm512_mul_pd(vr2x4, _mm512_mul_pd(inv2, inv2)), t);
+        _mm512_storeu_pd(co + i, _mm512_maskz_mov_pd(mask, _mm512_mul_pd(a, vip)));
+        _mm512_storeu_pd(so + i, _mm512_maskz_mov_pd(mask, _mm512_mul_pd(vip2, _mm512_add_pd(vara, _mm512_mul_pd(_mm512_mul_pd(a, a), vk)))));
+      }
+      AsymmetryScalar(cu, su, cd, sd, co, so, i, size, lumi, pol, dpol);
+      return;
+
+    }  // end 'AsymmetryAVX512(...)'
+#endif
+
+
+
+    // dispatchers ============================================================
+
+    // ------------------------------------------------------------------------
+    //! Scale contents by c (errors by c^2)
+    // ------------------------------------------------------------------------
+    void Scale(
+      double* content,
+      double* sumw2,
+      const std::size_t size,
+      const double c,
+      const Path path = ActivePath()
+    ) {
+
+      switch (path) {
+#ifdef PHEC_HISTMATH_AVX512
+        case AVX512:
+          ScaleAVX512(content, sumw2, size, c);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+        case AVX2:
+          ScaleAVX2(content, sumw2, size, c);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_SSE2
+        case SSE2:
+          ScaleSSE2(content, sumw2, size, c);
+          return;
+#endif
+        default:
+          ScaleScalar(content, sumw2, 0, size, c);
+          return;
+      }
+
+    }  // end 'Scale(double* x 2, std::size_t, double, Path)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = c1 * a + c2 * b (use c2 < 0 to subtract)
+    // ------------------------------------------------------------------------
+    void Add(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t size,
+      const double c1 = 1.0,
+      const double c2 = 1.0,
+      const Path path = ActivePath()
+    ) {
+
+      switch (path) {
+#ifdef PHEC_HISTMATH_AVX512
+        case AVX512:
+          AddAVX512(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+        case AVX2:
+          AddAVX2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_SSE2
+        case SSE2:
+          AddSSE2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+        default:
+          AddScalar(ca, sa, cb, sb, co, so, 0, size, c1, c2);
+          return;
+      }
+
+    }  // end 'Add(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (c1 * a) * (c2 * b)
+    // ------------------------------------------------------------------------
+    void Multiply(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t size,
+      const double c1 = 1.0,
+      const double c2 = 1.0,
+      const Path path = ActivePath()
+    ) {
+
+      switch (path) {
+#ifdef PHEC_HISTMATH_AVX512
+        case AVX512:
+          MultiplyAVX512(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+        case AVX2:
+          MultiplyAVX2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_SSE2
+        case SSE2:
+          MultiplySSE2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+        default:
+          MultiplyScalar(ca, sa, cb, sb, co, so, 0, size, c1, c2);
+          return;
+      }
+
+    }  // end 'Multiply(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (c1 * a) / (c2 * b)
+    // ------------------------------------------------------------------------
+    void Divide(
+      const double* ca, const double* sa,
+      const double* cb, const double* sb,
+      double* co, double* so,
+      const std::size_t size,
+      const double c1 = 1.0,
+      const double c2 = 1.0,
+      const Path path = ActivePath()
+    ) {
+
+      switch (path) {
+#ifdef PHEC_HISTMATH_AVX512
+        case AVX512:
+          DivideAVX512(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+        case AVX2:
+          DivideAVX2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_SSE2
+        case SSE2:
+          DivideSSE2(ca, sa, cb, sb, co, so, size, c1, c2);
+          return;
+#endif
+        default:
+          DivideScalar(ca, sa, cb, sb, co, so, 0, size, c1, c2);
+          return;
+      }
+
+    }  // end 'Divide(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! out = (u - R d) / (P (u + R d))
+    // ------------------------------------------------------------------------
+    void Asymmetry(
+      const double* cu, const double* su,
+      const double* cd, const double* sd,
+      double* co, double* so,
+      const std::size_t size,
+      const double lumi = 1.0,
+      const double pol = 1.0,
+      const double dpol = 0.0,
+      const Path path = ActivePath()
+    ) {
+
+      switch (path) {
+#ifdef PHEC_HISTMATH_AVX512
+        case AVX512:
+          AsymmetryAVX512(cu, su, cd, sd, co, so, size, lumi, pol, dpol);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_AVX2
+        case AVX2:
+          AsymmetryAVX2(cu, su, cd, sd, co, so, size, lumi, pol, dpol);
+          return;
+#endif
+#ifdef PHEC_HISTMATH_SSE2
+        case SSE2:
+          AsymmetrySSE2(cu, su, cd, sd, co, so, size, lumi, pol, dpol);
+          return;
+#endif
+        default:
+          AsymmetryScalar(cu, su, cd, sd, co, so, 0, size, lumi, pol, dpol);
+          return;
+      }
+
+    }  // end 'Asymmetry(...)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Max relative difference between two arrays
+    // ------------------------------------------------------------------------
+    double MaxRelDiff(const std::vector<double>& x, const std::vector<double>& y) {
+
+      double diff = 0.;
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        const double scale = std::max(std::max(std::fabs(x[i]), std::fabs(y[i])), 1.0e-300);
+        diff = std::max(diff, std::fabs(x[i] - y[i]) / scale);
+      }
+      return diff;
+
+    }  // end 'MaxRelDiff(std::vector<double>& x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Compare all available paths against the scalar reference
+    // ------------------------------------------------------------------------
+    /*! Runs each kernel on the same pseudo-random inputs (with
+     *  some zero denominators) and checks every available path
+     *  agrees with the scalar one to within a relative tolerance.
+     *  Returns true if all paths pass.
+     *
+     *  \param size no. of cells to test (odd so tails get exercised)
+     *  \param tol  relative tolerance
+     */
+    bool SelfTest(const std::size_t size = 1031, const double tol = 1.0e-12) {
+
+      // generate inputs with a small LCG
+      std::vector<double> ca(size), sa(size), cb(size), sb(size);
+      unsigned long seed = 12345;
+      for (std::size_t i = 0; i < size; ++i) {
+        seed  = (1103515245UL * seed + 12345UL) % 2147483648UL;
+        ca[i] = (double) seed / 2147483648.0;
+        seed  = (1103515245UL * seed + 12345UL) % 2147483648UL;
+        cb[i] = ((i % 17) == 0) ? 0. : (double) seed / 2147483648.0 - 0.5;
+        sa[i] = 0.1 * ca[i];
+        sb[i] = 0.2 * std::fabs(cb[i]);
+      }
+
+      // scalar references
+      std::vector<double> rc[5], rs[5];
+      for (std::size_t iop = 0; iop < 5; ++iop) {
+        rc[iop].assign(size, 0.);
+        rs[iop].assign(size, 0.);
+      }
+      rc[0] = ca;
+      rs[0] = sa;
+      Scale(&rc[0][0], &rs[0][0], size, 1.7, Scalar);
+      Add(&ca[0], &sa[0], &cb[0], &sb[0], &rc[1][0], &rs[1][0], size, 1.3, -0.7, Scalar);
+      Multiply(&ca[0], &sa[0], &cb[0], &sb[0], &rc[2][0], &rs[2][0], size, 1.3, 0.7, Scalar);
+      Divide(&ca[0], &sa[0], &cb[0], &sb[0], &rc[3][0], &rs[3][0], size, 1.3, 0.7, Scalar);
+      Asymmetry(&ca[0], &sa[0], &cb[0], &sb[0], &rc[4][0], &rs[4][0], size, 1.1, 0.6, 0.03, Scalar);
+
+      // now check each available path
+      bool isGood = true;
+      for (int ipath = SSE2; ipath <= DetectPath(); ++ipath) {
+
+        const Path path = (Path) ipath;
+        std::vector<double> oc[5], os[5];
+        for (std::size_t iop = 0; iop < 5; ++iop) {
+          oc[iop].assign(size, 0.);
+          os[iop].assign(size, 0.);
+        }
+        oc[0] = ca;
+        os[0] = sa;
+        Scale(&oc[0][0], &os[0][0], size, 1.7, path);
+        Add(&ca[0], &sa[0], &cb[0], &sb[0], &oc[1][0], &os[1][0], size, 1.3, -0.7, path);
+        Multiply(&ca[0], &sa[0], &cb[0], &sb[0], &oc[2][0], &os[2][0], size, 1.3, 0.7, path);
+        Divide(&ca[0], &sa[0], &cb[0], &sb[0], &oc[3][0], &os[3][0], size, 1.3, 0.7, path);
+        Asymmetry(&ca[0], &sa[0], &cb[0], &sb[0], &oc[4][0], &os[4][0], size, 1.1, 0.6, 0.03, path);
+
+        double diff = 0.;
+        for (std::size_t iop = 0; iop < 5; ++iop) {
+          diff = std::max(diff, MaxRelDiff(rc[iop], oc[iop]));
+          diff = std::max(diff, MaxRelDiff(rs[iop], os[iop]));
+        }
+
+        const bool isPathGood = (diff <= tol);
+        if (!isPathGood) {
+          std::cerr << "WARNING: " << PathName(path) << " histogram arithmetic disagrees with scalar path!\n"
+                    << "         max rel. diff = " << diff
+                    << std::endl;
+        }
+        isGood = isGood && isPathGood;
+      }
+      return isGood;
+
+    }  // end 'SelfTest(std::size_t, double)'
+
+  }  // end HistMath namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,332 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorHistPool.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Pool of ROOT histograms to reuse across
+ *  plotting routines.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORHISTPOOL_H
+#define PHCORRELATORHISTPOOL_H
+
+// c++ utilities
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+// root libraries
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotTypes.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Histogram pool
+  // ==========================================================================
+  /*! Routines convert their native results into ROOT histograms
+   *  for drawing and writing at every index of a sweep, but only
+   *  ever use a handful of distinct binnings. This pool keeps
+   *  released histograms around, keyed by their (interned)
+   *  binning and storage precision, and hands them back out
+   *  (reset and refilled) on the next request for the same
+   *  binning and precision.
+   *
+   *  Pooled histograms aren't attached to any directory. Like
+   *  the rest of the ROOT-facing code, the pool isn't meant to
+   *  be shared between threads.
+   */
+  class HistPool {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Binning (and precision) keys
+      // ----------------------------------------------------------------------
+      typedef std::pair<const Binning*, Type::Precision> Key1D;
+      typedef std::pair<const Binning*, const Binning*>  Axes2D;
+      typedef std::pair<Axes2D, Type::Precision>         Key2D;
+      typedef std::map<Key1D, std::vector<TH1*> >        Free1D;
+      typedef std::map<Key2D, std::vector<TH2*> >        Free2D;
+
+    private:
+
+      // data members
+      Free1D                   m_free1D;    ///!< released 1D histograms by binning
+      Free2D                   m_free2D;    ///!< released 2D histograms by binning
+      std::map<TH1*, Key1D>    m_owned1D;   ///!< binning of each 1D histogram created by pool
+      std::map<TH2*, Key2D>    m_owned2D;   ///!< binning of each 2D histogram created by pool
+      std::size_t              m_nCreated;  ///!< no. of histograms created
+      std::size_t              m_nReused;   ///!< no. of histograms handed out again
+
+      // ----------------------------------------------------------------------
+      //! Reset ROOT-side state left over from a previous use
+      // ----------------------------------------------------------------------
+      static void Prepare(TH1* hist, const std::string& name, const std::string& title) {
+
+        hist -> Reset("ICES");
+        hist -> SetName(name.data());
+        hist -> SetTitle(title.data());
+        hist -> SetMinimum();
+        hist -> SetMaximum();
+        hist -> GetXaxis() -> SetRange(0, 0);
+        hist -> GetYaxis() -> SetRange(0, 0);
+        return;
+
+      }  // end 'Prepare(TH1*, std::string& x 2)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetNCreated() const {return m_nCreated;}
+      std::size_t GetNReused()  const {return m_nReused;}
+
+      // ----------------------------------------------------------------------
+      //! Get a ROOT histogram filled from a native 1D one
+      // ----------------------------------------------------------------------
+      TH1* Acquire(const Hist1D& native, const Type::Precision precision = Type::Double) {
+
+        // create a new histogram if none are free
+        const Key1D key = std::make_pair( native.GetBinning(), precision );
+        Free1D::iterator free = m_free1D.find(key);
+        if ((free == m_free1D.end()) || free -> second.empty()) {
+          TH1* hist = native.MakeTH1(precision);
+          m_owned1D[hist] = key;
+          ++m_nCreated;
+          return hist;
+        }
+
+        // otherwise reuse a released one
+        TH1* hist = free -> second.back();
+        free -> second.pop_back();
+        Prepare(hist, native.GetName(), native.GetTitle());
+        hist -> GetXaxis() -> SetTitle( native.GetXTitle().data() );
+        hist -> GetYaxis() -> SetTitle( native.GetYTitle().data() );
+        native.CopyTo(hist);
+        ++m_nReused;
+        return hist;
+
+      }  // end 'Acquire(Hist1D&, Type::Precision)'
+
+      // ----------------------------------------------------------------------
+      //! Get a ROOT histogram filled from a native 2D one
+      // ----------------------------------------------------------------------
+      TH2* Acquire(const Hist2D& native, const Type::Precision precision = Type::Double) {
+
+        // create a new histogram if none are free
+        const Key2D key = std::make_pair(
+          std::make_pair( native.GetXBinning(), native.GetYBinning() ),
+          precision
+        );
+        Free2D::iterator free = m_free2D.find(key);
+        if ((free == m_free2D.end()) || free -> second.empty()) {
+          TH2* hist = native.MakeTH2(precision);
+          m_owned2D[hist] = key;
+          ++m_nCreated;
+          return hist;
+        }
+
+        // otherwise reuse a released one
+        TH2* hist = free -> second.back();
+        free -> second.pop_back();
+        Prepare(hist, native.GetName(), native.GetTitle());
+        hist -> GetXaxis() -> SetTitle( native.GetXTitle().data() );
+        hist -> GetYaxis() -> SetTitle( native.GetYTitle().data() );
+        hist -> GetZaxis() -> SetTitle( native.GetZTitle().data() );
+        native.CopyTo(hist);
+        ++m_nReused;
+        return hist;
+
+      }  // end 'Acquire(Hist2D&, Type::Precision)'
+
+      // ----------------------------------------------------------------------
+      //! Return a 1D histogram to the pool
+      // ----------------------------------------------------------------------
+      /*! Only histograms handed out by `Acquire(...)` can be
+       *  released. Anything else (e.g. a ratio made by
+       *  `Tools::DivideHist1D(TH1*, ...)`) stays with its
+       *  owner, and a histogram which was already released
+       *  isn't added twice.
+       */
+      void Release(TH1* hist) {
+
+        std::map<TH1*, Key1D>::iterator owned = m_owned1D.find(hist);
+        if (owned == m_owned1D.end()) {
+          std::cerr << "WARNING: tried to release a histogram the pool doesn't own!\n"
+                    << "         hist = " << hist -> GetName()
+                    << std::endl;
+          return;
+        }
+
+        std::vector<TH1*>& free = m_free1D[owned -> second];
+        if (std::find(free.begin(), free.end(), hist) != free.end()) {
+          std::cerr << "WARNING: tried to release a histogram twice!\n"
+                    << "         hist = " << hist -> GetName()
+                    << std::endl;
+          return;
+        }
+        free.push_back(hist);
+        return;
+
+      }  // end 'Release(TH1*)'
+
+      // ----------------------------------------------------------------------
+      //! Return a 2D histogram to the pool
+      // ----------------------------------------------------------------------
+      /*! See `Release(TH1*)`. */
+      void Release(TH2* hist) {
+
+        std::map<TH2*, Key2D>::iterator owned = m_owned2D.find(hist);
+        if (owned == m_owned2D.end()) {
+          std::cerr << "WARNING: tried to release a histogram the pool doesn't own!\n"
+                    << "         hist = " << hist -> GetName()
+                    << std::endl;
+          return;
+        }
+
+        std::vector<TH2*>& free = m_free2D[owned -> second];
+        if (std::find(free.begin(), free.end(), hist) != free.end()) {
+          std::cerr << "WARNING: tried to release a histogram twice!\n"
+                    << "         hist = " << hist -> GetName()
+                    << std::endl;
+          return;
+        }
+        free.push_back(hist);
+        return;
+
+      }  // end 'Release(TH2*)'
+
+      // ----------------------------------------------------------------------
+      //! Return a list of 1D histograms to the pool
+      // ----------------------------------------------------------------------
+      void Release(std::vector<TH1*>& hists) {
+
+        for (std::size_t ihist = 0; ihist < hists.size(); ++ihist) {
+          Release(hists[ihist]);
+        }
+        hists.clear();
+        return;
+
+      }  // end 'Release(std::vector<TH1*>&)'
+
+      // ----------------------------------------------------------------------
+      //! Return a list of 2D histograms to the pool
+      // ----------------------------------------------------------------------
+      void Release(std::vector<TH2*>& hists) {
+
+        for (std::size_t ihist = 0; ihist < hists.size(); ++ihist) {
+          Release(hists[ihist]);
+        }
+        hists.clear();
+        return;
+
+      }  // end 'Release(std::vector<TH2*>&)'
+
+      // ======================================================================
+      //! Returns histograms to the pool when leaving scope
+      // ======================================================================
+      /*! Routines acquire histograms, draw them, and release
+       *  them at the end; if an error is raised (and collected,
+       *  see Error) in between, the guard still hands them back.
+       *  Lists are emptied on release, and single histograms
+       *  set to NULL, so nothing is released twice.
+       */
+      class Guard {
+
+        private:
+
+          // data members
+          HistPool&                       m_pool;     ///!< pool to return to
+          std::vector<TH1**>              m_single;   ///!< single 1D histograms to return
+          std::vector<std::vector<TH1*>*> m_lists1D;  ///!< lists of 1D histograms to return
+          std::vector<std::vector<TH2*>*> m_lists2D;  ///!< lists of 2D histograms to return
+
+          // not copyable
+          Guard(const Guard&);
+          Guard& operator=(const Guard&);
+
+        public:
+
+          // --------------------------------------------------------------------
+          //! Watch histograms
+          // --------------------------------------------------------------------
+          void Watch(TH1*& hist)              {m_single.push_back(&hist);}
+          void Watch(std::vector<TH1*>& list) {m_lists1D.push_back(&list);}
+          void Watch(std::vector<TH2*>& list) {m_lists2D.push_back(&list);}
+
+          // --------------------------------------------------------------------
+          //! ctor/dtor
+          // --------------------------------------------------------------------
+          explicit Guard(HistPool& pool) : m_pool(pool) {};
+          ~Guard() {
+            for (std::size_t ihst = 0; ihst < m_single.size(); ++ihst) {
+              if (*m_single[ihst]) m_pool.Release(*m_single[ihst]);
+              *m_single[ihst] = NULL;
+            }
+            for (std::size_t ilst = 0; ilst < m_lists1D.size(); ++ilst) {
+              m_pool.Release(*m_lists1D[ilst]);
+            }
+            for (std::size_t ilst = 0; ilst < m_lists2D.size(); ++ilst) {
+              m_pool.Release(*m_lists2D[ilst]);
+            }
+          };
+
+      };  // end Guard
+
+      // ----------------------------------------------------------------------
+      //! Delete all histograms created by the pool
+      // ----------------------------------------------------------------------
+      /*! Only call this once nothing is still using
+       *  histograms handed out by the pool.
+       */
+      void Clear() {
+
+        for (std::map<TH1*, Key1D>::iterator it = m_owned1D.begin(); it != m_owned1D.end(); ++it) {
+          delete it -> first;
+        }
+        for (std::map<TH2*, Key2D>::iterator it = m_owned2D.begin(); it != m_owned2D.end(); ++it) {
+          delete it -> first;
+        }
+        m_free1D.clear();
+        m_free2D.clear();
+        m_owned1D.clear();
+        m_owned2D.clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared pool
+      // ----------------------------------------------------------------------
+      static HistPool& Global() {
+
+        static HistPool pool;
+        return pool;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      HistPool() : m_nCreated(0), m_nReused(0) {};
+      ~HistPool() {};
+
+  };  // end HistPool
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
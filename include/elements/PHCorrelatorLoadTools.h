@@ -0,0 +1,170 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorLoadTools.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Tools to load input histograms into
+ *  native ones.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORLOADTOOLS_H
+#define PHCORRELATORLOADTOOLS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotTools.h"
+#include "PHCorrelatorSharedStore.h"
+
+
+
+namespace PHEnergyCorrelator {
+  namespace Tools {
+
+    // ------------------------------------------------------------------------
+    //! Announce where an input was loaded from
+    // ------------------------------------------------------------------------
+    /*! \param file   file input was in
+     *  \param object name of input
+     *  \param role   what the input is (omitted if empty)
+     *  \param shared true if input came from the shared store
+     */
+    void AnnounceLoad(
+      const std::string& file,
+      const std::string& object,
+      const std::string& role,
+      const bool shared
+    ) {
+
+      const std::string tag = role.empty() ? "" : " (" + role + ")";
+      if (shared) {
+        std::cout << "      Hist" << tag << " = " << object << " [shm]" << std::endl;
+      } else {
+        std::cout << "      File" << tag << " = " << file << "\n"
+                  << "      Hist" << tag << " = " << object
+                  << std::endl;
+      }
+      return;
+
+    }  // end 'AnnounceLoad(std::string& x 3, bool)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Load a 1D input
+    // ------------------------------------------------------------------------
+    /*! Takes the input from the shared-memory store (see
+     *  SharedStore) if there, otherwise grabs it from file
+     *  and closes the file right away.
+     *
+     *  \param file   file to read from
+     *  \param object name of histogram to read
+     *  \param nrebin number of bins to merge (1 if not rebinning)
+     *  \param role   what the input is (for messages)
+     */
+    Hist1D LoadHist1D(
+      const std::string& file,
+      const std::string& object,
+      const int nrebin = 1,
+      const std::string& role = ""
+    ) {
+
+      Hist1D native;
+      if (SharedStore::Global().Get(file, object, native)) {
+        AnnounceLoad(file, object, role, true);
+      } else {
+        std::vector<TFile*> files(1, OpenFile(file, "read"));
+        FileCloser          close_files(files);
+        native = Hist1D( (TH1*) GrabObject(object, files.front()) );
+        AnnounceLoad(file, object, role, false);
+      }
+
+      if (nrebin > 1) {
+        native.Rebin(nrebin);
+      }
+      return native;
+
+    }  // end 'LoadHist1D(std::string& x 2, int, std::string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Load a 2D input
+    // ------------------------------------------------------------------------
+    /*! Like LoadHist1D, but bins are merged along x and y.
+     *
+     *  \param file    file to read from
+     *  \param object  name of histogram to read
+     *  \param nrebinx number of x bins to merge
+     *  \param nrebiny number of y bins to merge
+     *  \param role    what the input is (for messages)
+     */
+    Hist2D LoadHist2D(
+      const std::string& file,
+      const std::string& object,
+      const int nrebinx = 1,
+      const int nrebiny = 1,
+      const std::string& role = ""
+    ) {
+
+      Hist2D native;
+      if (SharedStore::Global().Get(file, object, native)) {
+        AnnounceLoad(file, object, role, true);
+      } else {
+        std::vector<TFile*> files(1, OpenFile(file, "read"));
+        FileCloser          close_files(files);
+        native = Hist2D( (TH2*) GrabObject(object, files.front()) );
+        AnnounceLoad(file, object, role, false);
+      }
+
+      if ((nrebinx > 1) || (nrebiny > 1)) {
+        native.Rebin(nrebinx, nrebiny);
+      }
+      return native;
+
+    }  // end 'LoadHist2D(std::string& x 2, int x 2, std::string&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Load an optional 2D input
+    // ------------------------------------------------------------------------
+    /*! Like LoadHist2D, but a missing input isn't an error.
+     *
+     *  \return false if input isn't there (hist is left as is)
+     */
+    bool FindHist2D(
+      const std::string& file,
+      const std::string& object,
+      Hist2D& hist
+    ) {
+
+      if (SharedStore::Global().Get(file, object, hist)) {
+        return true;
+      }
+
+      std::vector<TFile*> files(1, OpenFile(file, "read"));
+      FileCloser          close_files(files);
+
+      TH2* found = (TH2*) files.front() -> Get( object.data() );
+      if (found) {
+        hist = Hist2D(found);
+      }
+      return (found != NULL);
+
+    }  // end 'FindHist2D(std::string& x 2, Hist2D&)'
+
+  }  // end Tools namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,338 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorMetricsEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Engine to collect every compared pair of a sweep
+ *  and rank them by goodness-of-fit.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORMETRICSENGINE_H
+#define PHCORRELATORMETRICSENGINE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorGoodnessOfFit.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorTable.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Goodness-of-fit metrics engine
+  // ==========================================================================
+  /*! While collecting, plotting routines hand every pair
+   *  of spectra they compare to `Add(...)` (see
+   *  `BaseRoutine::Ratio1D(...)`); the engine keeps its own
+   *  detached copies. `Run(...)` then computes the metrics
+   *  of GoodnessOfFit::Compare for all pairs in parallel and
+   *  fills a table with one row per pair, ranked from worst
+   *  to best agreement by one of its columns (chi2/ndf by
+   *  default), ready to write out as CSV or a TTree.
+   *
+   *  Each pair also records the context it was compared in
+   *  (the variable and plot index set with `SetContext(...)`,
+   *  e.g. by `Output::TryPlot1D(...)`), which is written as
+   *  extra columns so tables of several processes can be
+   *  merged.
+   */
+  class MetricsEngine {
+
+    public:
+
+      // ======================================================================
+      //! A compared pair
+      // ======================================================================
+      struct Pair {
+
+        // members
+        std::string      label;     ///!< what the pair is (e.g. "<test> vs. <ref>")
+        std::string      variable;  ///!< variable being plotted when compared
+        std::vector<int> index;     ///!< plot index when compared (see IndexColumns())
+        Hist1D           ref;       ///!< reference spectrum
+        Hist1D           test;      ///!< test spectrum
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Pair() {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Pair(const std::string& label_arg, const Hist1D& ref_arg, const Hist1D& test_arg)
+          : label(label_arg), ref(ref_arg), test(test_arg) {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments and context
+        // --------------------------------------------------------------------
+        Pair(
+          const std::string& label_arg,
+          const std::string& var_arg,
+          const std::vector<int>& idx_arg,
+          const Hist1D& ref_arg,
+          const Hist1D& test_arg
+        ) : label(label_arg), variable(var_arg), index(idx_arg), ref(ref_arg), test(test_arg) {};
+
+      };  // end Pair
+
+    private:
+
+      // data members
+      bool                               m_collect;  ///!< whether to collect pairs
+      std::string                        m_rankBy;   ///!< column to rank by
+      std::string                        m_variable; ///!< variable of current context
+      std::vector<int>                   m_index;    ///!< plot index of current context
+      std::vector<Pair>                  m_pairs;    ///!< collected pairs
+      std::vector<GoodnessOfFit::Result> m_results;  ///!< metrics of each pair
+      Table                              m_table;    ///!< ranked metrics
+
+      // ======================================================================
+      //! Computes metrics of each pair
+      // ======================================================================
+      class CompareTask : public Parallel::Task {
+
+        private:
+
+          const std::vector<Pair>*            m_pairs;
+          std::vector<GoodnessOfFit::Result>* m_results;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            (*m_results)[item] = GoodnessOfFit::Compare((*m_pairs)[item].ref, (*m_pairs)[item].test);
+          }
+
+          CompareTask(const std::vector<Pair>* pairs, std::vector<GoodnessOfFit::Result>* results)
+            : m_pairs(pairs), m_results(results) {};
+
+      };  // end CompareTask
+
+      // ----------------------------------------------------------------------
+      //! Columns of results table
+      // ----------------------------------------------------------------------
+      static std::vector<std::string> Columns() {
+
+        std::vector<std::string> columns;
+        columns.push_back("rank");
+        for (std::size_t iidx = 0; iidx < IndexColumns().size(); ++iidx) {
+          columns.push_back( IndexColumns()[iidx] );
+        }
+        columns.push_back("chi2");
+        columns.push_back("ndf");
+        columns.push_back("chi2ndf");
+        columns.push_back("ks");
+        columns.push_back("ks_prob");
+        columns.push_back("ad");
+        columns.push_back("max_pull");
+        columns.push_back("worst_bin");
+        return columns;
+
+      }  // end 'Columns()'
+
+      // ----------------------------------------------------------------------
+      //! String columns of results table
+      // ----------------------------------------------------------------------
+      static std::vector<std::string> TagColumns() {
+
+        return std::vector<std::string>(1, "variable");
+
+      }  // end 'TagColumns()'
+
+      // ----------------------------------------------------------------------
+      //! Values of a pair's result (rank left at 0)
+      // ----------------------------------------------------------------------
+      static std::vector<double> Values(const Pair& pair, const GoodnessOfFit::Result& result) {
+
+        std::vector<double> values;
+        values.push_back(0.);
+        for (std::size_t iidx = 0; iidx < IndexColumns().size(); ++iidx) {
+          values.push_back( (iidx < pair.index.size()) ? pair.index[iidx] : -1. );
+        }
+        values.push_back(result.chi2);
+        values.push_back(result.ndf);
+        values.push_back(result.chi2ndf);
+        values.push_back(result.ks);
+        values.push_back(result.ks_prob);
+        values.push_back(result.ad);
+        values.push_back(result.max_pull);
+        values.push_back(result.worst_bin);
+        return values;
+
+      }  // end 'Values(Pair&, GoodnessOfFit::Result&)'
+
+      // ----------------------------------------------------------------------
+      //! Badness of a value for ranking
+      // ----------------------------------------------------------------------
+      /*! Larger is worse, except for the KS probability;
+       *  undefined values rank last.
+       */
+      double Badness(const double value) const {
+
+        if (value != value) return -std::numeric_limits<double>::max();
+        return (m_rankBy == "ks_prob") ? -value : value;
+
+      }  // end 'Badness(double)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Names of plot index columns
+      // ----------------------------------------------------------------------
+      /*! Order of the plot index handed to `SetContext(...)`. */
+      static const std::vector<std::string>& IndexColumns() {
+
+        static std::vector<std::string> columns;
+        if (columns.empty()) {
+          columns.push_back("level");
+          columns.push_back("species");
+          columns.push_back("pt");
+          columns.push_back("cf");
+          columns.push_back("chrg");
+          columns.push_back("spin");
+        }
+        return columns;
+
+      }  // end 'IndexColumns()'
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      bool                                      GetCollect() const {return m_collect;}
+      std::string                               GetRankBy()  const {return m_rankBy;}
+      std::size_t                               GetNPairs()  const {return m_pairs.size();}
+      const std::vector<Pair>&                  GetPairs()   const {return m_pairs;}
+      const std::vector<GoodnessOfFit::Result>& GetResults() const {return m_results;}
+      const Table&                              GetTable()   const {return m_table;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetCollect(const bool collect) {m_collect = collect;}
+
+      // ----------------------------------------------------------------------
+      //! Set context of pairs collected from now on
+      // ----------------------------------------------------------------------
+      /*! \param variable what variable is being plotted
+       *  \param index    plot index, ordered as IndexColumns()
+       */
+      void SetContext(const std::string& variable, const std::vector<int>& index) {
+
+        m_variable = variable;
+        m_index    = index;
+        return;
+
+      }  // end 'SetContext(std::string&, std::vector<int>&)'
+
+      // ----------------------------------------------------------------------
+      //! Set column to rank by
+      // ----------------------------------------------------------------------
+      void SetRankBy(const std::string& column) {
+
+        if (Table(Columns()).FindColumn(column) == Columns().size()) {
+          std::cerr << "PANIC: can't rank metrics by unknown column '" << column << "'!" << std::endl;
+          Error::Raise("can't rank metrics by unknown column '" + column + "'");
+          assert(Table(Columns()).FindColumn(column) < Columns().size());
+        }
+        m_rankBy = column;
+        return;
+
+      }  // end 'SetRankBy(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Collect a compared pair
+      // ----------------------------------------------------------------------
+      /*! Does nothing unless collecting. */
+      void Add(const std::string& label, const Hist1D& ref, const Hist1D& test) {
+
+        if (!m_collect) return;
+        m_pairs.push_back( Pair(label, m_variable, m_index, ref, test) );
+        return;
+
+      }  // end 'Add(std::string&, Hist1D&, Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Compute metrics of all pairs and rank them
+      // ----------------------------------------------------------------------
+      /*! \param nthreads maximum number of threads to use */
+      const Table& Run(const std::size_t nthreads = Parallel::DefaultNThreads()) {
+
+        m_results.assign(m_pairs.size(), GoodnessOfFit::Result());
+        CompareTask task(&m_pairs, &m_results);
+        Parallel::For(task, m_pairs.size(), nthreads);
+
+        // rank from worst to best
+        const std::size_t icol = Table(Columns()).FindColumn(m_rankBy);
+
+        std::vector<std::pair<double, std::size_t> > order;
+        for (std::size_t ipair = 0; ipair < m_results.size(); ++ipair) {
+          order.push_back( std::make_pair(-Badness(Values(m_pairs[ipair], m_results[ipair])[icol]), ipair) );
+        }
+        std::stable_sort(order.begin(), order.end());
+
+        m_table = Table(Columns(), TagColumns());
+        for (std::size_t irank = 0; irank < order.size(); ++irank) {
+          const Pair&         pair   = m_pairs[order[irank].second];
+          std::vector<double> values = Values(pair, m_results[order[irank].second]);
+          values[0] = irank + 1;
+          m_table.AddRow(pair.label, values, std::vector<std::string>(1, pair.variable));
+        }
+        std::cout << "    Computed goodness-of-fit of " << m_pairs.size()
+                  << " pairs, ranked by " << m_rankBy << "."
+                  << std::endl;
+        return m_table;
+
+      }  // end 'Run(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Clear collected pairs and results
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_pairs.clear();
+        m_results.clear();
+        m_table.Clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared engine
+      // ----------------------------------------------------------------------
+      static MetricsEngine& Global() {
+
+        static MetricsEngine engine;
+        return engine;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      MetricsEngine()
+        : m_collect(false)
+        , m_rankBy("chi2ndf")
+        , m_table(Columns(), TagColumns())
+      {};
+      ~MetricsEngine() {};
+
+  };  // end MetricsEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
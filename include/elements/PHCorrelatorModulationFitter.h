@@ -0,0 +1,619 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorModulationFitter.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Closed-form fits of Fourier modulations to
+ *  angular spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORMODULATIONFITTER_H
+#define PHCORRELATORMODULATIONFITTER_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotTools.h"
+#include "PHCorrelatorPlotTypes.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Fourier basis for modulation fits
+  // ==========================================================================
+  /*! A list of terms g_k(phi), each a constant or a cos/sin
+   *  of some harmonic n: the fitted model is
+   *
+   *    f(phi) = sum_k a_k g_k(phi).
+   */
+  class ModulationBasis {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Kinds of terms
+      // ----------------------------------------------------------------------
+      enum Func {Const, Cos, Sin};
+
+      // ======================================================================
+      //! One term of the basis
+      // ======================================================================
+      struct Term {
+        Func        func;      ///!< kind of term
+        int         harmonic;  ///!< harmonic n (ignored for Const)
+        std::string name;      ///!< name used in output, e.g. "Cos1"
+      };
+
+    private:
+
+      // data members
+      std::vector<Term> m_terms;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetNTerms()                      const {return m_terms.size();}
+      const Term& GetTerm(const std::size_t iterm) const {return m_terms.at(iterm);}
+
+      // ----------------------------------------------------------------------
+      //! Add a term
+      // ----------------------------------------------------------------------
+      /*! If no name is given, one is made from the
+       *  function and harmonic (e.g. "Const", "Cos2").
+       */
+      ModulationBasis& Add(const Func func, const int harmonic = 0, const std::string& name = "") {
+
+        Term term;
+        term.func     = func;
+        term.harmonic = (func == Const) ? 0 : harmonic;
+        term.name     = name;
+        if (term.name.empty()) {
+          switch (func) {
+            case Cos:
+              term.name = "Cos" + Tools::StringifyIndex(harmonic);
+              break;
+            case Sin:
+              term.name = "Sin" + Tools::StringifyIndex(harmonic);
+              break;
+            default:
+              term.name = "Const";
+              break;
+          }
+        }
+        m_terms.push_back(term);
+        return *this;
+
+      }  // end 'Add(Func, int, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Find a term by name
+      // ----------------------------------------------------------------------
+      /*! Returns the no. of terms if there's no such term. */
+      std::size_t FindTerm(const std::string& name) const {
+
+        for (std::size_t iterm = 0; iterm < m_terms.size(); ++iterm) {
+          if (m_terms[iterm].name == name) return iterm;
+        }
+        return m_terms.size();
+
+      }  // end 'FindTerm(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Average of a term over [lo, hi)
+      // ----------------------------------------------------------------------
+      /*! Using the bin average rather than the value at
+       *  the bin center keeps fits to coarse binnings
+       *  (e.g. rebinned high-pt spectra) unbiased.
+       */
+      double Average(const std::size_t iterm, const double lo, const double hi) const {
+
+        const Term&  term  = m_terms[iterm];
+        const double n     = (double) term.harmonic;
+        const double width = hi - lo;
+        if (term.func == Const) return 1.0;
+        if (term.harmonic == 0) return (term.func == Cos) ? 1.0 : 0.0;
+        if (width <= 0.)        return (term.func == Cos) ? std::cos(n * lo) : std::sin(n * lo);
+
+        // integrate analytically
+        if (term.func == Cos) {
+          return (std::sin(n * hi) - std::sin(n * lo)) / (n * width);
+        } else {
+          return (std::cos(n * lo) - std::cos(n * hi)) / (n * width);
+        }
+
+      }  // end 'Average(std::size_t, double x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Make a constant + cos(n phi) basis, n = 1 ... nmax
+      // ----------------------------------------------------------------------
+      static ModulationBasis Cosine(const int nmax = 1) {
+
+        ModulationBasis basis;
+        basis.Add(Const);
+        for (int n = 1; n <= nmax; ++n) {
+          basis.Add(Cos, n);
+        }
+        return basis;
+
+      }  // end 'Cosine(int)'
+
+      // ----------------------------------------------------------------------
+      //! Make a constant + cos/sin(n phi) basis, n = 1 ... nmax
+      // ----------------------------------------------------------------------
+      static ModulationBasis Fourier(const int nmax = 1) {
+
+        ModulationBasis basis;
+        basis.Add(Const);
+        for (int n = 1; n <= nmax; ++n) {
+          basis.Add(Cos, n);
+          basis.Add(Sin, n);
+        }
+        return basis;
+
+      }  // end 'Fourier(int)'
+
+  };  // end ModulationBasis
+
+
+
+  // ==========================================================================
+  //! Result of a modulation fit
+  // ==========================================================================
+  struct ModulationFit {
+
+    // members
+    std::string         label;  ///!< what was fit
+    double              x;      ///!< where to place amplitudes (e.g. pt or R)
+    bool                ok;     ///!< false if fit failed (e.g. too few bins)
+    double              chi2;   ///!< chi2 of fit
+    int                 ndf;    ///!< no. of degrees of freedom
+    std::vector<double> amps;   ///!< fitted amplitudes a_k
+    std::vector<double> cov;    ///!< covariance of amplitudes (row-major)
+
+    // ------------------------------------------------------------------------
+    //! Get amplitude and its error
+    // ------------------------------------------------------------------------
+    double GetAmplitude(const std::size_t iterm) const {return amps.at(iterm);}
+    double GetError(const std::size_t iterm)     const {return std::sqrt(cov.at((iterm * amps.size()) + iterm));}
+
+    // ------------------------------------------------------------------------
+    //! Get amplitude relative to another (e.g. a_1 / a_0)
+    // ------------------------------------------------------------------------
+    /*! The error accounts for the correlation of the two
+     *  amplitudes. Returns 0 if the reference is 0.
+     */
+    double GetRelative(const std::size_t iterm, const std::size_t iref, double& error) const {
+
+      const std::size_t nterm = amps.size();
+      const double      ref   = amps.at(iref);
+      if (ref == 0.) {
+        error = 0.;
+        return 0.;
+      }
+
+      const double rel = amps.at(iterm) / ref;
+      const double var = (
+        cov[(iterm * nterm) + iterm] -
+        (2. * rel * cov[(iterm * nterm) + iref]) +
+        (rel * rel * cov[(iref * nterm) + iref])
+      ) / (ref * ref);
+      error = (var > 0.) ? std::sqrt(var) : 0.;
+      return rel;
+
+    }  // end 'GetRelative(std::size_t x 2, double&)'
+
+    // ------------------------------------------------------------------------
+    //! default ctor
+    // ------------------------------------------------------------------------
+    ModulationFit() : label(""), x(0.), ok(false), chi2(0.), ndf(0) {};
+
+  };  // end ModulationFit
+
+
+
+  // ==========================================================================
+  //! Modulation fitter
+  // ==========================================================================
+  /*! Fits a ModulationBasis to angular spectra. The model is
+   *  linear in its amplitudes, so each fit is a closed-form
+   *  weighted least-squares solve,
+   *
+   *    (G^T W G) a = G^T W y,  cov(a) = (G^T W G)^-1,
+   *
+   *  with W = 1 / sigma^2 per bin (bins with no error are
+   *  skipped) and G the bin-averaged basis functions. The
+   *  normal equations are only k x k for k terms, so they're
+   *  solved by Cholesky decomposition.
+   *
+   *  Spectra are queued (`Add`, `AddSlices`) and then fit
+   *  together (`Fit`), spread over threads with
+   *  `Parallel::For`. Amplitudes can then be collected into
+   *  amplitude-vs-x histograms (e.g. vs. jet pt or R).
+   */
+  class ModulationFitter {
+
+    private:
+
+      // data members
+      ModulationBasis            m_basis;    ///!< basis to fit
+      double                     m_lo;       ///!< lower end of fit range
+      double                     m_hi;       ///!< upper end of fit range
+      std::vector<Hist1D>        m_spectra;  ///!< spectra to fit
+      std::vector<ModulationFit> m_fits;     ///!< fit of each spectrum
+
+      // ======================================================================
+      //! Fits each queued spectrum
+      // ======================================================================
+      class FitTask : public Parallel::Task {
+
+        private:
+
+          ModulationFitter* m_fitter;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            m_fitter -> FitOne(item, m_fitter -> m_fits[item]);
+          }
+
+          explicit FitTask(ModulationFitter* fitter) : m_fitter(fitter) {};
+
+      };  // end FitTask
+      friend class FitTask;
+
+      // ----------------------------------------------------------------------
+      //! Solve normal equations by Cholesky decomposition
+      // ----------------------------------------------------------------------
+      /*! On success, `rhs` holds the solution and `mat` the
+       *  inverse of the original matrix. Returns false if the
+       *  matrix isn't positive definite.
+       */
+      static bool SolveNormal(std::vector<double>& mat, std::vector<double>& rhs, const std::size_t nterm) {
+
+        // decompose mat = L L^T (L in lower triangle)
+        std::vector<double> low(nterm * nterm, 0.);
+        for (std::size_t irow = 0; irow < nterm; ++irow) {
+          for (std::size_t icol = 0; icol <= irow; ++icol) {
+            double sum = mat[(irow * nterm) + icol];
+            for (std::size_t ik = 0; ik < icol; ++ik) {
+              sum -= low[(irow * nterm) + ik] * low[(icol * nterm) + ik];
+            }
+            if (irow == icol) {
+              if (sum <= 0.) return false;
+              low[(irow * nterm) + irow] = std::sqrt(sum);
+            } else {
+              low[(irow * nterm) + icol] = sum / low[(icol * nterm) + icol];
+            }
+          }
+        }
+
+        // invert L
+        std::vector<double> inv(nterm * nterm, 0.);
+        for (std::size_t icol = 0; icol < nterm; ++icol) {
+          inv[(icol * nterm) + icol] = 1. / low[(icol * nterm) + icol];
+          for (std::size_t irow = icol + 1; irow < nterm; ++irow) {
+            double sum = 0.;
+            for (std::size_t ik = icol; ik < irow; ++ik) {
+              sum -= low[(irow * nterm) + ik] * inv[(ik * nterm) + icol];
+            }
+            inv[(irow * nterm) + icol] = sum / low[(irow * nterm) + irow];
+          }
+        }
+
+        // mat^-1 = L^-T L^-1
+        for (std::size_t irow = 0; irow < nterm; ++irow) {
+          for (std::size_t icol = 0; icol < nterm; ++icol) {
+            double sum = 0.;
+            for (std::size_t ik = std::max(irow, icol); ik < nterm; ++ik) {
+              sum += inv[(ik * nterm) + irow] * inv[(ik * nterm) + icol];
+            }
+            mat[(irow * nterm) + icol] = sum;
+          }
+        }
+
+        // solution = mat^-1 rhs
+        std::vector<double> sol(nterm, 0.);
+        for (std::size_t irow = 0; irow < nterm; ++irow) {
+          for (std::size_t icol = 0; icol < nterm; ++icol) {
+            sol[irow] += mat[(irow * nterm) + icol] * rhs[icol];
+          }
+        }
+        rhs = sol;
+        return true;
+
+      }  // end 'SolveNormal(std::vector<double>& x 2, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Fit one queued spectrum
+      // ----------------------------------------------------------------------
+      /*! Only touches plain data, so it's safe to run
+       *  for different spectra concurrently.
+       */
+      void FitOne(const std::size_t ispec, ModulationFit& fit) const {
+
+        const Hist1D&     spectrum = m_spectra[ispec];
+        const std::size_t nterm    = m_basis.GetNTerms();
+
+        // accumulate normal equations
+        std::vector<double> mat(nterm * nterm, 0.);
+        std::vector<double> rhs(nterm, 0.);
+        std::vector<double> avg(nterm, 0.);
+        int                 nused = 0;
+        for (int ibin = 1; ibin <= spectrum.GetNbins(); ++ibin) {
+
+          // check if bin is in range & usable
+          const double lo    = spectrum.GetBinLowEdge(ibin);
+          const double hi    = spectrum.GetBinUpEdge(ibin);
+          const double sumw2 = spectrum.GetBinSumw2(ibin);
+          if ((lo < m_lo) || (hi > m_hi) || (sumw2 <= 0.)) continue;
+
+          const double weight = 1. / sumw2;
+          const double value  = spectrum.GetBinContent(ibin);
+          for (std::size_t iterm = 0; iterm < nterm; ++iterm) {
+            avg[iterm] = m_basis.Average(iterm, lo, hi);
+          }
+          for (std::size_t irow = 0; irow < nterm; ++irow) {
+            rhs[irow] += weight * avg[irow] * value;
+            for (std::size_t icol = 0; icol <= irow; ++icol) {
+              mat[(irow * nterm) + icol] += weight * avg[irow] * avg[icol];
+            }
+          }
+          ++nused;
+        }
+
+        // fill in upper triangle
+        for (std::size_t irow = 0; irow < nterm; ++irow) {
+          for (std::size_t icol = irow + 1; icol < nterm; ++icol) {
+            mat[(irow * nterm) + icol] = mat[(icol * nterm) + irow];
+          }
+        }
+
+        fit.amps.assign(nterm, 0.);
+        fit.cov.assign(nterm * nterm, 0.);
+        fit.ndf = nused - (int) nterm;
+        fit.ok  = (fit.ndf >= 0) && SolveNormal(mat, rhs, nterm);
+        if (!fit.ok) return;
+
+        fit.amps = rhs;
+        fit.cov  = mat;
+
+        // calculate chi2
+        fit.chi2 = 0.;
+        for (int ibin = 1; ibin <= spectrum.GetNbins(); ++ibin) {
+          const double lo    = spectrum.GetBinLowEdge(ibin);
+          const double hi    = spectrum.GetBinUpEdge(ibin);
+          const double sumw2 = spectrum.GetBinSumw2(ibin);
+          if ((lo < m_lo) || (hi > m_hi) || (sumw2 <= 0.)) continue;
+
+          double model = 0.;
+          for (std::size_t iterm = 0; iterm < nterm; ++iterm) {
+            model += fit.amps[iterm] * m_basis.Average(iterm, lo, hi);
+          }
+          const double resid = spectrum.GetBinContent(ibin) - model;
+          fit.chi2 += (resid * resid) / sumw2;
+        }
+        return;
+
+      }  // end 'FitOne(std::size_t, ModulationFit&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      const ModulationBasis& GetBasis()                           const {return m_basis;}
+      std::size_t            GetNQueued()                         const {return m_spectra.size();}
+      std::size_t            GetNFits()                           const {return m_fits.size();}
+      const ModulationFit&   GetFit(const std::size_t ifit)       const {return m_fits.at(ifit);}
+      const Hist1D&          GetSpectrum(const std::size_t ispec) const {return m_spectra.at(ispec);}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      /*! Changing the basis clears queued spectra and fits. */
+      void SetBasis(const ModulationBasis& basis) {
+        m_basis = basis;
+        Clear();
+      }
+
+      // ----------------------------------------------------------------------
+      //! Restrict fits to bins within [lo, hi]
+      // ----------------------------------------------------------------------
+      void SetRange(const double lo, const double hi) {
+        m_lo = lo;
+        m_hi = hi;
+      }
+
+      // ----------------------------------------------------------------------
+      //! Queue an angular spectrum
+      // ----------------------------------------------------------------------
+      /*! Returns the index of the spectrum's fit.
+       *
+       *  \param label    what is being fit
+       *  \param spectrum angular spectrum to fit
+       *  \param x        where to place its amplitudes (e.g. jet pt)
+       */
+      std::size_t Add(const std::string& label, const Hist1D& spectrum, const double x = 0.) {
+
+        ModulationFit fit;
+        fit.label = label;
+        fit.x     = x;
+        m_spectra.push_back(spectrum);
+        m_fits.push_back(fit);
+        return m_fits.size() - 1;
+
+      }  // end 'Add(std::string&, Hist1D&, double)'
+
+      // ----------------------------------------------------------------------
+      //! Queue each slice of a 2D spectrum
+      // ----------------------------------------------------------------------
+      /*! Slices are taken along the non-angular axis (one per
+       *  bin), and amplitudes placed at that bin's center.
+       *  Returns the index of the first slice's fit.
+       *
+       *  \param label    what is being fit
+       *  \param spectrum 2D spectrum to slice
+       *  \param angle    which axis is the angle (Type::X or Type::Y)
+       */
+      std::size_t AddSlices(const std::string& label, const Hist2D& spectrum, const int angle = Type::Y) {
+
+        const std::size_t first  = m_fits.size();
+        const int         nslice = (angle == Type::Y) ? spectrum.GetNbinsX() : spectrum.GetNbinsY();
+        for (int islice = 1; islice <= nslice; ++islice) {
+          const std::string name = label + "_Slice" + Tools::StringifyIndex(islice);
+          if (angle == Type::Y) {
+            Add(name, spectrum.ProjectionY(name, islice, islice), spectrum.GetXBinCenter(islice));
+          } else {
+            Add(name, spectrum.ProjectionX(name, islice, islice), spectrum.GetYBinCenter(islice));
+          }
+        }
+        return first;
+
+      }  // end 'AddSlices(std::string&, Hist2D&, int)'
+
+      // ----------------------------------------------------------------------
+      //! Fit all queued spectra
+      // ----------------------------------------------------------------------
+      /*! Each fit is only a k x k solve, so threads are only
+       *  started if each of them gets at least `nminper`
+       *  spectra; a handful of spectra is fit serially.
+       *
+       *  \param nthreads maximum number of threads to use
+       *  \param nminper  minimum no. of spectra per thread
+       */
+      void Fit(
+        const std::size_t nthreads = Parallel::DefaultNThreads(),
+        const std::size_t nminper = 16
+      ) {
+
+        if (m_basis.GetNTerms() == 0) {
+          std::cerr << "PANIC: no modulation basis set!" << std::endl;
+          Error::Raise("no modulation basis set");
+          assert(m_basis.GetNTerms() > 0);
+        }
+
+        // no. of threads worth starting
+        std::size_t nuse = (nminper > 0) ? m_spectra.size() / nminper : nthreads;
+        if (nuse > nthreads) nuse = nthreads;
+        if (nuse < 1)        nuse = 1;
+
+        FitTask task(this);
+        Parallel::For(task, m_spectra.size(), nuse);
+        return;
+
+      }  // end 'Fit(std::size_t x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Collect an amplitude of a range of fits into a histogram
+      // ----------------------------------------------------------------------
+      /*! Each fit in [first, last) fills the bin containing its
+       *  x; failed fits are left empty. If `iref` is a valid term,
+       *  amplitudes are taken relative to it (e.g. a_1 / a_0).
+       *
+       *  \param name  name of histogram
+       *  \param iterm which term to collect
+       *  \param edges bin edges in x
+       *  \param first index of first fit to collect
+       *  \param last  index after last fit to collect
+       *  \param iref  term to normalize to (none if out of range)
+       */
+      Hist1D MakeAmplitudeHist(
+        const std::string& name,
+        const std::size_t iterm,
+        const std::vector<double>& edges,
+        const std::size_t first,
+        const std::size_t last,
+        const std::size_t iref = (std::size_t) -1
+      ) const {
+
+        const bool relative = (iref < m_basis.GetNTerms());
+
+        Hist1D amps(name, "", edges);
+        amps.SetYTitle(
+          relative ? m_basis.GetTerm(iterm).name + " / " + m_basis.GetTerm(iref).name
+                   : m_basis.GetTerm(iterm).name
+        );
+        for (std::size_t ifit = first; (ifit < last) && (ifit < m_fits.size()); ++ifit) {
+
+          const ModulationFit& fit = m_fits[ifit];
+          if (!fit.ok) continue;
+
+          double error = fit.GetError(iterm);
+          double value = fit.GetAmplitude(iterm);
+          if (relative) {
+            value = fit.GetRelative(iterm, iref, error);
+          }
+
+          const int bin = amps.FindBin(fit.x);
+          amps.SetBinContent(bin, value);
+          amps.SetBinError(bin, error);
+        }
+        return amps;
+
+      }  // end 'MakeAmplitudeHist(std::string&, std::size_t, std::vector<double>&, std::size_t x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Drop all queued spectra and fits
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_spectra.clear();
+        m_fits.clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Basis used by default-constructed fitters
+      // ----------------------------------------------------------------------
+      /*! Defaults to const + cos(phi) + cos(2 phi). Can be
+       *  changed globally before a sweep, e.g.
+       *
+       *    ModulationFitter::DefaultBasis() = ModulationBasis::Fourier(2);
+       */
+      static ModulationBasis& DefaultBasis() {
+
+        static ModulationBasis basis = ModulationBasis::Cosine(2);
+        return basis;
+
+      }  // end 'DefaultBasis()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ModulationFitter()
+        : m_basis(DefaultBasis())
+        , m_lo(-1.0e10)
+        , m_hi(1.0e10)
+      {};
+      ~ModulationFitter() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a basis
+      // ----------------------------------------------------------------------
+      explicit ModulationFitter(const ModulationBasis& basis)
+        : m_basis(basis)
+        , m_lo(-1.0e10)
+        , m_hi(1.0e10)
+      {};
+
+  };  // end ModulationFitter
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
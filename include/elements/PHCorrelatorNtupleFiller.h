@@ -0,0 +1,441 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorNtupleFiller.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Engine to (re)fill histograms from pair- or
+ *  jet-level ntuples.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORNTUPLEFILLER_H
+#define PHCORRELATORNTUPLEFILLER_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TLeaf.h>
+#include <TTree.h>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorHistPool.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotOpts.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Ntuple filler
+  // ==========================================================================
+  /*! Fills histograms straight from ntuples with one
+   *  entry per pair (or jet), so that spectra can be
+   *  rebinned arbitrarily rather than only by merging
+   *  existing bins.
+   *
+   *  Each target histogram names the column to histogram,
+   *  the column to weight by, its binning, and a set of
+   *  cuts (low <= column < high) selecting entries, and
+   *  is tied to a source (e.g. the file its pre-filled
+   *  version lives in) so one ntuple fills every target of
+   *  its source in a single pass.
+   *
+   *  Entries are read serially (ROOT I/O isn't thread-safe)
+   *  in chunks of columnar arrays; each chunk is then split
+   *  into slabs filled in parallel into per-thread copies
+   *  of every target, using batched bin lookup (see
+   *  `Binning::FindBins(...)`). Per-thread copies are summed
+   *  once at the end.
+   */
+  class NtupleFiller {
+
+    public:
+
+      // ======================================================================
+      //! A cut on a column
+      // ======================================================================
+      struct Cut {
+
+        // members
+        std::string column;  ///!< column to cut on
+        double      low;     ///!< lowest accepted value
+        double      high;    ///!< highest accepted value (exclusive)
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Cut() : column(""), low(0.), high(0.) {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Cut(const std::string& column_arg, const double low_arg, const double high_arg)
+          : column(column_arg), low(low_arg), high(high_arg) {};
+
+      };  // end Cut
+
+      // ======================================================================
+      //! A histogram to fill
+      // ======================================================================
+      struct Target {
+
+        // members
+        std::string      name;     ///!< histogram name
+        std::string      source;   ///!< what ntuple fills it
+        std::string      column;   ///!< column to histogram
+        std::string      weight;   ///!< column to weight by (empty for unit weights)
+        const Binning*   binning;  ///!< binning of histogram
+        std::vector<Cut> cuts;     ///!< selection of entries
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Target() : binning(NULL) {};
+
+      };  // end Target
+
+    private:
+
+      // data members
+      std::size_t                        m_chunkSize;  ///!< no. of entries read at once
+      std::vector<Target>                m_targets;    ///!< histograms to fill
+      std::vector<Hist1D>                m_hists;      ///!< filled histograms
+      std::map<std::string, std::size_t> m_index;      ///!< position of each target by source & name
+      std::size_t                        m_nEntries;   ///!< no. of entries read
+
+      // ======================================================================
+      //! Fills one slab of a chunk into per-thread histograms
+      // ======================================================================
+      class SlabTask : public Parallel::Task {
+
+        private:
+
+          const NtupleFiller*                      m_filler;
+          const std::vector<std::size_t>*          m_targets;
+          const std::vector<std::vector<double> >* m_columns;
+          const std::map<std::string, std::size_t>* m_positions;
+          std::vector<std::vector<Hist1D> >*       m_locals;
+          std::size_t                              m_nentries;
+          std::size_t                              m_nslabs;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t thread) {
+
+            const std::size_t begin = (item * m_nentries) / m_nslabs;
+            const std::size_t end   = ((item + 1) * m_nentries) / m_nslabs;
+            if (end <= begin) return;
+
+            const std::size_t   nvals = end - begin;
+            std::vector<int>    bins(nvals, 0);
+            std::vector<double> work(nvals, 0.);
+            std::vector<char>   pass(nvals, 1);
+
+            for (std::size_t itgt = 0; itgt < m_targets -> size(); ++itgt) {
+
+              const Target& target = m_filler -> m_targets[ (*m_targets)[itgt] ];
+              Hist1D&       local  = (*m_locals)[thread][itgt];
+
+              // apply cuts
+              std::fill(pass.begin(), pass.end(), 1);
+              for (std::size_t icut = 0; icut < target.cuts.size(); ++icut) {
+                const double* vals = &(*m_columns)[ m_positions -> find(target.cuts[icut].column) -> second ][begin];
+                const double  low  = target.cuts[icut].low;
+                const double  high = target.cuts[icut].high;
+                for (std::size_t ival = 0; ival < nvals; ++ival) {
+                  pass[ival] &= (char) ((vals[ival] >= low) && (vals[ival] < high));
+                }
+              }
+
+              // look up bins & fill
+              const double* xvals = &(*m_columns)[ m_positions -> find(target.column) -> second ][begin];
+              const double* wvals = target.weight.empty()
+                                  ? NULL
+                                  : &(*m_columns)[ m_positions -> find(target.weight) -> second ][begin];
+              target.binning -> FindBins(xvals, &bins[0], nvals, &work[0]);
+
+              double* content = local.Content();
+              double* sumw2   = local.Sumw2();
+              for (std::size_t ival = 0; ival < nvals; ++ival) {
+                if (!pass[ival]) continue;
+                const double wgt = wvals ? wvals[ival] : 1.;
+                content[ bins[ival] ] += wgt;
+                sumw2[ bins[ival] ]   += wgt * wgt;
+              }
+            }
+
+          }  // end 'Run(std::size_t, std::size_t)'
+
+          SlabTask(
+            const NtupleFiller* filler,
+            const std::vector<std::size_t>* targets,
+            const std::vector<std::vector<double> >* columns,
+            const std::map<std::string, std::size_t>* positions,
+            std::vector<std::vector<Hist1D> >* locals,
+            const std::size_t nentries,
+            const std::size_t nslabs
+          ) : m_filler(filler)
+            , m_targets(targets)
+            , m_columns(columns)
+            , m_positions(positions)
+            , m_locals(locals)
+            , m_nentries(nentries)
+            , m_nslabs(nslabs)
+          {};
+
+      };  // end SlabTask
+      friend class SlabTask;
+
+      // ----------------------------------------------------------------------
+      //! Make key of a target
+      // ----------------------------------------------------------------------
+      /*! Spectra of different sources (e.g. pp and pAu) can
+       *  share a name, so targets are keyed by both.
+       */
+      static std::string MakeKey(const std::string& source, const std::string& name) {
+
+        return source + ":" + name;
+
+      }  // end 'MakeKey(std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Look up the leaf of a column
+      // ----------------------------------------------------------------------
+      static TLeaf* GetLeaf(TTree* tree, const std::string& column) {
+
+        TLeaf* leaf = tree -> GetLeaf( column.data() );
+        if (!leaf) {
+          std::cerr << "PANIC: ntuple has no column '" << column << "'!" << std::endl;
+          Error::Raise("ntuple has no column '" + column + "'");
+          assert(leaf);
+        }
+        return leaf;
+
+      }  // end 'GetLeaf(TTree*, std::string&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t                GetChunkSize() const {return m_chunkSize;}
+      std::size_t                GetNTargets()  const {return m_targets.size();}
+      std::size_t                GetNEntries()  const {return m_nEntries;}
+      const std::vector<Target>& GetTargets()   const {return m_targets;}
+      const std::vector<Hist1D>& GetHists()     const {return m_hists;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetChunkSize(const std::size_t size) {m_chunkSize = size;}
+
+      // ----------------------------------------------------------------------
+      //! Add a histogram to fill
+      // ----------------------------------------------------------------------
+      /*! Targets are unique by source and name; adding one
+       *  that already exists does nothing.
+       */
+      void AddTarget(
+        const std::string& name,
+        const std::string& source,
+        const std::string& column,
+        const std::string& weight,
+        const Binning::Edges& edges,
+        const std::vector<Cut>& cuts
+      ) {
+
+        const std::string key = MakeKey(source, name);
+        if (m_index.find(key) != m_index.end()) return;
+
+        Target target;
+        target.name    = name;
+        target.source  = source;
+        target.column  = column;
+        target.weight  = weight;
+        target.binning = Binning::Intern(edges);
+        target.cuts    = cuts;
+
+        m_index[key] = m_targets.size();
+        m_targets.push_back(target);
+        m_hists.push_back( Hist1D(name, "", target.binning) );
+        return;
+
+      }  // end 'AddTarget(std::string& x 4, Binning::Edges&, std::vector<Cut>&)'
+
+      // ----------------------------------------------------------------------
+      //! Get list of sources
+      // ----------------------------------------------------------------------
+      std::vector<std::string> GetSources() const {
+
+        std::vector<std::string> sources;
+        for (std::size_t itgt = 0; itgt < m_targets.size(); ++itgt) {
+          if (std::find(sources.begin(), sources.end(), m_targets[itgt].source) == sources.end()) {
+            sources.push_back(m_targets[itgt].source);
+          }
+        }
+        return sources;
+
+      }  // end 'GetSources()'
+
+      // ----------------------------------------------------------------------
+      //! Fill all targets of a source from an ntuple
+      // ----------------------------------------------------------------------
+      /*! \param source   which targets to fill
+       *  \param tree     ntuple to read
+       *  \param nthreads maximum number of threads to use
+       */
+      void Fill(
+        const std::string& source,
+        TTree* tree,
+        const std::size_t nthreads = Parallel::DefaultNThreads()
+      ) {
+
+        // collect targets & the columns they need
+        std::vector<std::size_t>           targets;
+        std::vector<std::string>           names;
+        std::map<std::string, std::size_t> positions;
+        for (std::size_t itgt = 0; itgt < m_targets.size(); ++itgt) {
+          if (m_targets[itgt].source != source) continue;
+          targets.push_back(itgt);
+
+          std::vector<std::string> needed;
+          needed.push_back(m_targets[itgt].column);
+          if (!m_targets[itgt].weight.empty()) needed.push_back(m_targets[itgt].weight);
+          for (std::size_t icut = 0; icut < m_targets[itgt].cuts.size(); ++icut) {
+            needed.push_back(m_targets[itgt].cuts[icut].column);
+          }
+          for (std::size_t ineed = 0; ineed < needed.size(); ++ineed) {
+            if (positions.find(needed[ineed]) != positions.end()) continue;
+            positions[needed[ineed]] = names.size();
+            names.push_back(needed[ineed]);
+          }
+        }
+        if (targets.empty()) return;
+
+        // only read the columns needed
+        tree -> SetBranchStatus("*", 0);
+        std::vector<TLeaf*> leaves;
+        for (std::size_t icol = 0; icol < names.size(); ++icol) {
+          tree -> SetBranchStatus(names[icol].data(), 1);
+          leaves.push_back( GetLeaf(tree, names[icol]) );
+        }
+
+        // set up per-thread copies of targets
+        const std::size_t nthread = std::max(nthreads, (std::size_t) 1);
+        std::vector<std::vector<Hist1D> > locals(nthread);
+        for (std::size_t ithr = 0; ithr < nthread; ++ithr) {
+          for (std::size_t itgt = 0; itgt < targets.size(); ++itgt) {
+            locals[ithr].push_back( Hist1D(m_targets[ targets[itgt] ].name, "", m_targets[ targets[itgt] ].binning) );
+          }
+        }
+
+        // read & fill chunk by chunk
+        const Long64_t    nentries = tree -> GetEntries();
+        const std::size_t chunk    = std::max(m_chunkSize, (std::size_t) 1);
+
+        std::vector<std::vector<double> > columns(names.size());
+        for (Long64_t first = 0; first < nentries; first += chunk) {
+
+          const std::size_t nread = (std::size_t) std::min((Long64_t) chunk, nentries - first);
+          for (std::size_t icol = 0; icol < names.size(); ++icol) {
+            columns[icol].resize(nread);
+          }
+          for (std::size_t ient = 0; ient < nread; ++ient) {
+            tree -> GetEntry(first + ient);
+            for (std::size_t icol = 0; icol < names.size(); ++icol) {
+              columns[icol][ient] = leaves[icol] -> GetValue();
+            }
+          }
+
+          const std::size_t nslabs = std::min(nread, 4 * nthread);
+          SlabTask task(this, &targets, &columns, &positions, &locals, nread, nslabs);
+          Parallel::For(task, nslabs, nthread);
+          m_nEntries += nread;
+        }
+        tree -> SetBranchStatus("*", 1);
+
+        // sum per-thread copies
+        for (std::size_t ithr = 0; ithr < nthread; ++ithr) {
+          for (std::size_t itgt = 0; itgt < targets.size(); ++itgt) {
+            Hist1D&           total  = m_hists[ targets[itgt] ];
+            const Hist1D&     local  = locals[ithr][itgt];
+            const std::size_t ncells = total.GetNcells();
+            for (std::size_t icell = 0; icell < ncells; ++icell) {
+              total.Content()[icell] += local.Content()[icell];
+              total.Sumw2()[icell]   += local.Sumw2()[icell];
+            }
+          }
+        }
+        std::cout << "    Filled " << targets.size() << " histograms from "
+                  << nentries << " entries of " << source << "."
+                  << std::endl;
+        return;
+
+      }  // end 'Fill(std::string&, TTree*, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Write filled histograms of a source
+      // ----------------------------------------------------------------------
+      /*! Names are only unique within a source, so each
+       *  source should be written to its own file.
+       */
+      void Write(TFile* ofile, const std::string& source) const {
+
+        ofile -> cd();
+        for (std::size_t ihst = 0; ihst < m_hists.size(); ++ihst) {
+          if (m_targets[ihst].source != source) continue;
+          TH1* hist = HistPool::Global().Acquire( m_hists[ihst], PlotOpts::DefaultPrecision() );
+          hist -> Write();
+          HistPool::Global().Release(hist);
+        }
+        return;
+
+      }  // end 'Write(TFile*, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Remove all targets
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_targets.clear();
+        m_hists.clear();
+        m_index.clear();
+        m_nEntries = 0;
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared filler
+      // ----------------------------------------------------------------------
+      static NtupleFiller& Global() {
+
+        static NtupleFiller filler;
+        return filler;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      NtupleFiller() : m_chunkSize(1 << 20), m_nEntries(0) {};
+      ~NtupleFiller() {};
+
+  };  // end NtupleFiller
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
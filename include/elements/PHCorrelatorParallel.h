@@ -0,0 +1,305 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorParallel.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Minimal parallel-for over independent work items.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORPARALLEL_H
+#define PHCORRELATORPARALLEL_H
+
+// c++ utilities
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorPlotError.h"
+
+// ----------------------------------------------------------------------------
+// threading support
+// ----------------------------------------------------------------------------
+/*! Work is spread over POSIX threads when compiled (not
+ *  interpreted) on a unix-like system; otherwise, or if
+ *  PHEC_PARALLEL_SERIAL is defined, it runs serially.
+ */
+#if !defined(__CINT__) && !defined(__CLING__) && !defined(PHEC_PARALLEL_SERIAL) && (defined(__unix__) || defined(__APPLE__))
+  #define PHEC_PARALLEL_PTHREADS
+  #include <pthread.h>
+  #include <unistd.h>
+#endif
+
+
+
+namespace PHEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Parallel helpers
+  // --------------------------------------------------------------------------
+  /*! Tasks derive from `Parallel::Task` and implement `Run`
+   *  for a single work item; `Parallel::For` then calls it
+   *  for every item, spreading the items over threads.
+   *
+   *  Items must be independent of each other. ROOT objects
+   *  (files, TH1s, canvases...) and shared singletons like
+   *  the histogram pool aren't thread-safe, so tasks should
+   *  only read/write plain data (e.g. native histograms that
+   *  were created beforehand); do all I/O serially before
+   *  and after the parallel pass.
+   *
+   *  An error raised by a task (e.g. a PlotError when errors
+   *  are collected) stops that thread's items, and is raised
+   *  again as a PlotError on the calling thread once every
+   *  thread is done.
+   */
+  namespace Parallel {
+
+    // ========================================================================
+    //! A parallelizable task
+    // ========================================================================
+    class Task {
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Process one work item
+        // --------------------------------------------------------------------
+        /*! \param item   index of item to process
+         *  \param thread index of thread doing the work
+         */
+        virtual void Run(const std::size_t item, const std::size_t thread) = 0;
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        Task()          {};
+        virtual ~Task() {};
+
+    };  // end Task
+
+
+
+    // ========================================================================
+    //! A mutex
+    // ========================================================================
+    /*! Guards shared state that tasks may touch (e.g. the
+     *  binning registry). A no-op when running serially.
+     */
+    class Mutex {
+
+      private:
+
+#ifdef PHEC_PARALLEL_PTHREADS
+        pthread_mutex_t m_mutex;  ///!< underlying mutex
+#endif
+
+        // not copyable
+        Mutex(const Mutex&);
+        Mutex& operator=(const Mutex&);
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Lock/unlock
+        // --------------------------------------------------------------------
+#ifdef PHEC_PARALLEL_PTHREADS
+        void Lock()   {pthread_mutex_lock(&m_mutex);}
+        void Unlock() {pthread_mutex_unlock(&m_mutex);}
+#else
+        void Lock()   {}
+        void Unlock() {}
+#endif
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+#ifdef PHEC_PARALLEL_PTHREADS
+        Mutex()  {pthread_mutex_init(&m_mutex, NULL);};
+        ~Mutex() {pthread_mutex_destroy(&m_mutex);};
+#else
+        Mutex()  {};
+        ~Mutex() {};
+#endif
+
+    };  // end Mutex
+
+
+
+    // ========================================================================
+    //! Holds a mutex until leaving scope
+    // ========================================================================
+    class Lock {
+
+      private:
+
+        // data members
+        Mutex& m_mutex;  ///!< mutex being held
+
+        // not copyable
+        Lock(const Lock&);
+        Lock& operator=(const Lock&);
+
+      public:
+
+        explicit Lock(Mutex& mutex) : m_mutex(mutex) {m_mutex.Lock();};
+        ~Lock() {m_mutex.Unlock();};
+
+    };  // end Lock
+
+
+
+    // ------------------------------------------------------------------------
+    //! Number of available cores
+    // ------------------------------------------------------------------------
+    std::size_t GetNCores() {
+
+#ifdef PHEC_PARALLEL_PTHREADS
+      const long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+      return (ncores > 0) ? (std::size_t) ncores : 1;
+#else
+      return 1;
+#endif
+
+    }  // end 'GetNCores()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Default number of threads
+    // ------------------------------------------------------------------------
+    /*! Defaults to the number of available cores. Can be
+     *  changed globally, e.g. to run serially:
+     *
+     *    Parallel::DefaultNThreads() = 1;
+     */
+    std::size_t& DefaultNThreads() {
+
+      static std::size_t nthreads = GetNCores();
+      return nthreads;
+
+    }  // end 'DefaultNThreads()'
+
+
+
+#ifdef PHEC_PARALLEL_PTHREADS
+    // ========================================================================
+    //! Work assigned to one thread
+    // ========================================================================
+    /*! Items are dealt out round-robin, so thread t handles
+     *  items t, t + n, t + 2n, ...
+     */
+    struct Worker {
+      Task*       task;     ///!< task to run
+      std::size_t thread;   ///!< index of this thread
+      std::size_t stride;   ///!< no. of threads
+      std::size_t nitems;   ///!< total no. of items
+      bool        failed;   ///!< true if a task raised an error
+      std::string what;     ///!< message of raised error
+    };
+
+
+
+    // ------------------------------------------------------------------------
+    //! Thread entry point
+    // ------------------------------------------------------------------------
+    /*! Errors can't leave a thread, so they're caught here
+     *  and handed back through the worker.
+     */
+    void* RunWorker(void* arg) {
+
+      Worker* worker = (Worker*) arg;
+      try {
+        for (std::size_t item = worker -> thread; item < worker -> nitems; item += worker -> stride) {
+          worker -> task -> Run(item, worker -> thread);
+        }
+      } catch (const std::exception& error) {
+        worker -> failed = true;
+        worker -> what   = error.what();
+      } catch (...) {
+        worker -> failed = true;
+        worker -> what   = "unknown error in parallel task";
+      }
+      return NULL;
+
+    }  // end 'RunWorker(void*)'
+#endif
+
+
+
+    // ------------------------------------------------------------------------
+    //! Run a task over a range of items
+    // ------------------------------------------------------------------------
+    /*! Runs `task.Run(item, thread)` for item = 0 ... nitems - 1
+     *  and returns once all items are done. If a thread can't
+     *  be started, its items are run on the calling thread.
+     *  If any task raised an error, the first one is raised
+     *  again (as a PlotError) after all threads are joined.
+     *
+     *  \param task     task to run
+     *  \param nitems   number of work items
+     *  \param nthreads maximum number of threads to use
+     */
+    void For(Task& task, const std::size_t nitems, const std::size_t nthreads = DefaultNThreads()) {
+
+      // no. of threads actually worth starting
+      std::size_t nuse = (nthreads < nitems) ? nthreads : nitems;
+      if (nuse < 1) nuse = 1;
+
+#ifdef PHEC_PARALLEL_PTHREADS
+      if (nuse > 1) {
+
+        std::vector<Worker>    workers(nuse);
+        std::vector<pthread_t> threads(nuse);
+        std::vector<bool>      started(nuse, false);
+        for (std::size_t ith = 0; ith < nuse; ++ith) {
+          workers[ith].task   = &task;
+          workers[ith].thread = ith;
+          workers[ith].stride = nuse;
+          workers[ith].nitems = nitems;
+          workers[ith].failed = false;
+        }
+
+        // thread 0 is the calling thread
+        for (std::size_t ith = 1; ith < nuse; ++ith) {
+          started[ith] = (pthread_create(&threads[ith], NULL, RunWorker, &workers[ith]) == 0);
+          if (!started[ith]) {
+            std::cerr << "WARNING: couldn't start thread " << ith << ", running its work serially." << std::endl;
+          }
+        }
+        RunWorker(&workers[0]);
+
+        // join (or make up for) the rest
+        for (std::size_t ith = 1; ith < nuse; ++ith) {
+          if (started[ith]) {
+            pthread_join(threads[ith], NULL);
+          } else {
+            RunWorker(&workers[ith]);
+          }
+        }
+
+        // and pass on any error
+        for (std::size_t ith = 0; ith < nuse; ++ith) {
+          if (workers[ith].failed) {
+            throw PlotError(workers[ith].what);
+          }
+        }
+        return;
+      }
+#endif
+
+      for (std::size_t item = 0; item < nitems; ++item) {
+        task.Run(item, 0);
+      }
+      return;
+
+    }  // end 'For(Task&, std::size_t x 2)'
+
+  }  // end Parallel namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
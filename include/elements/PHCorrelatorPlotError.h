@@ -0,0 +1,115 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorPlotError.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Error handling for plotting routines.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORPLOTERROR_H
+#define PHCORRELATORPLOTERROR_H
+
+// c++ utilities
+#include <stdexcept>
+#include <string>
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Plotting error
+  // ==========================================================================
+  /*! Thrown in place of a failed assertion when errors
+   *  are being collected (see `Error::Collect`), so
+   *  that a sweep can carry on past a bad index.
+   */
+  class PlotError : public std::runtime_error {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a message
+      // ----------------------------------------------------------------------
+      explicit PlotError(const std::string& what) : std::runtime_error(what) {};
+
+      // ----------------------------------------------------------------------
+      //! default dtor
+      // ----------------------------------------------------------------------
+      ~PlotError() throw() {};
+
+  };  // end PlotError
+
+
+
+  namespace Error {
+
+    // ------------------------------------------------------------------------
+    //! Error handling modes
+    // ------------------------------------------------------------------------
+    /*! Options are:
+     *    - Abort   = print a PANIC and assert (default);
+     *    - Collect = print a PANIC and throw a PlotError.
+     */
+    enum Mode {Abort, Collect};
+
+
+
+    // ------------------------------------------------------------------------
+    //! Access the current error handling mode
+    // ------------------------------------------------------------------------
+    Mode& CurrentMode() {
+
+      static Mode mode = Abort;
+      return mode;
+
+    }  // end 'CurrentMode()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Set error handling mode
+    // ------------------------------------------------------------------------
+    void SetMode(const Mode mode) {
+
+      CurrentMode() = mode;
+      return;
+
+    }  // end 'SetMode(Mode)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get error handling mode
+    // ------------------------------------------------------------------------
+    Mode GetMode() {
+
+      return CurrentMode();
+
+    }  // end 'GetMode()'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Raise an error
+    // ------------------------------------------------------------------------
+    /*! Throws a PlotError if errors are being collected,
+     *  otherwise does nothing so that the caller's
+     *  assert fires as usual.
+     */
+    void Raise(const std::string& what) {
+
+      if (CurrentMode() == Collect) {
+        throw PlotError(what);
+      }
+      return;
+
+    }  // end 'Raise(std::string&)'
+
+  }  // end Error namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
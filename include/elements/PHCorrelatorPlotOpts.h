@@ -14,6 +14,7 @@
 #include <string>
 // plotting utilities
 #include "PHCorrelatorCanvas.h"
+#include "PHCorrelatorPlotTypes.h"
 #include "PHCorrelatorRange.h"
 
 
@@ -30,15 +31,31 @@ namespace PHEnergyCorrelator {
   struct PlotOpts {
 
     // members
-    std::string header;       ///!< legend header
-    std::string ratio_pad;    ///!< label of pad to draw ratios in
-    std::string spectra_pad;  ///!< label of pad to draw spectra in
-    std::string correct_pad;  ///!< label of pad to draw correction factors in
-    Canvas      canvas;       ///!< definition of canvas/pads
-    Range       plot_range;   ///!< (x, y, z) ranges to plot over
-    Range       norm_range;   ///!< (x, y, z) ranges to normalize to
-    double      norm_to;      ///!< what value you're normalizing to
-    bool        do_norm;      ///!< do or do not normalize
+    std::string     header;       ///!< legend header
+    std::string     ratio_pad;    ///!< label of pad to draw ratios in
+    std::string     spectra_pad;  ///!< label of pad to draw spectra in
+    std::string     correct_pad;  ///!< label of pad to draw correction factors in
+    Canvas          canvas;       ///!< definition of canvas/pads
+    Range           plot_range;   ///!< (x, y, z) ranges to plot over
+    Range           norm_range;   ///!< (x, y, z) ranges to normalize to
+    double          norm_to;      ///!< what value you're normalizing to
+    bool            do_norm;      ///!< do or do not normalize
+    Type::Precision precision;    ///!< precision to store derived histograms with
+
+    // ------------------------------------------------------------------------
+    //! Default storage precision
+    // ------------------------------------------------------------------------
+    /*! Routines always compute in double precision; this
+     *  only sets what precision their results are stored
+     *  (and written) with when a PlotOpts doesn't say
+     *  otherwise. Set it before options are created, e.g.
+     *
+     *    PlotOpts::DefaultPrecision() = Type::Float;
+     */
+    static Type::Precision& DefaultPrecision() {
+      static Type::Precision precision = Type::Double;
+      return precision;
+    }
 
     // ------------------------------------------------------------------------
     //! default ctor
@@ -53,6 +70,7 @@ namespace PHEnergyCorrelator {
       norm_range  = Range();
       norm_to     = 1.0;
       do_norm     = true;
+      precision   = DefaultPrecision();
     };
 
     // ------------------------------------------------------------------------
@@ -72,7 +90,8 @@ namespace PHEnergyCorrelator {
       const std::string header_arg = "",
       const std::string ratio_arg = "",
       const std::string spectra_arg = "",
-      const std::string correct_arg = ""
+      const std::string correct_arg = "",
+      const Type::Precision precision_arg = DefaultPrecision()
     ) {
       canvas      = canvas_arg;
       plot_range  = plot_range_arg;
@@ -83,6 +102,7 @@ namespace PHEnergyCorrelator {
       ratio_pad   = ratio_arg;
       spectra_pad = spectra_arg;
       correct_pad = correct_arg;
+      precision   = precision_arg;
     }  // end ctor()
 
   };  // end PlotOpts
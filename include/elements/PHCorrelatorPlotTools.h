@@ -14,8 +14,10 @@
 #include <limits>
 #include <cassert>
 #include <cmath>
+#include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 // root libraries
 #include <TAxis.h>
 #include <TFile.h>
@@ -25,6 +27,9 @@
 #include <TObject.h>
 #include <TString.h>
 // plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorPlotError.h"
 #include "PHCorrelatorPlotTypes.h"
 
 
@@ -69,33 +74,33 @@ namespace PHEnergyCorrelator {
 
 
     // ------------------------------------------------------------------------
-    //! Normalize a 1D histogram by integral
+    //! Normalize a native 1D histogram by integral
     // ------------------------------------------------------------------------
     void NormalizeByIntegral(
-      TH1* hist,
+      Hist1D& hist,
       const double norm = 1.0,
       const double start = MinDouble(),
       const double stop = MaxDouble()
     ) {
 
       // calculate integral over provided range
-      const int    istart   = hist -> FindBin(start);
-      const int    istop    = hist -> FindBin(stop);
-      const double integral = hist -> Integral(istart, istop);
+      const int    istart   = hist.FindBin(start);
+      const int    istop    = hist.FindBin(stop);
+      const double integral = hist.Integral(istart, istop);
 
       // apply if nonzero
-      if (integral > 0.) hist -> Scale(norm / integral);
+      if (integral > 0.) hist.Scale(norm / integral);
       return;
 
-    }  // end 'NormalizeByIntegral(TH1*, double, double)'
+    }  // end 'NormalizeByIntegral(Hist1D&, double x 3)'
 
 
 
     // ------------------------------------------------------------------------
-    //! Normalize a 2D histogram by integral
+    //! Normalize a native 2D histogram by integral
     // ------------------------------------------------------------------------
     void NormalizeByIntegral(
-      TH2* hist,
+      Hist2D& hist,
       const double norm = 1.0,
       const double startx = MinDouble(),
       const double stopx = MaxDouble(),
@@ -104,34 +109,107 @@ namespace PHEnergyCorrelator {
     ) {
 
       // calculate integral over provided range
-      const int    istartx  = hist -> GetXaxis() -> FindBin(startx);
-      const int    istarty  = hist -> GetYaxis() -> FindBin(starty);
-      const int    istopx   = hist -> GetXaxis() -> FindBin(stopx);
-      const int    istopy   = hist -> GetYaxis() -> FindBin(stopy);
-      const double integral = hist -> Integral(istartx, istopx, istarty, istopy);
+      const int    istartx  = hist.FindXBin(startx);
+      const int    istarty  = hist.FindYBin(starty);
+      const int    istopx   = hist.FindXBin(stopx);
+      const int    istopy   = hist.FindYBin(stopy);
+      const double integral = hist.Integral(istartx, istopx, istarty, istopy);
 
       // apply if nonzero
-      if (integral > 0.) hist -> Scale(norm / integral);
+      if (integral > 0.) hist.Scale(norm / integral);
+      return;
+
+    }  // end 'NormalizeByIntegral(Hist2D&, double x 5)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Normalize a 1D histogram by integral
+    // ------------------------------------------------------------------------
+    /*! Wrapper around the native version for ROOT histograms. */
+    void NormalizeByIntegral(
+      TH1* hist,
+      const double norm = 1.0,
+      const double start = MinDouble(),
+      const double stop = MaxDouble()
+    ) {
+
+      Hist1D native(hist);
+      NormalizeByIntegral(native, norm, start, stop);
+      native.CopyTo(hist);
+      return;
+
+    }  // end 'NormalizeByIntegral(TH1*, double x 3)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Normalize a 2D histogram by integral
+    // ------------------------------------------------------------------------
+    /*! Wrapper around the native version for ROOT histograms. */
+    void NormalizeByIntegral(
+      TH2* hist,
+      const double norm = 1.0,
+      const double startx = MinDouble(),
+      const double stopx = MaxDouble(),
+      const double starty = MinDouble(),
+      const double stopy = MaxDouble()
+    ) {
+
+      Hist2D native(hist);
+      NormalizeByIntegral(native, norm, startx, stopx, starty, stopy);
+      native.CopyTo(hist);
       return;
 
-    }  // end 'NormalizeByIntegral(TH1*, double, double)'
+    }  // end 'NormalizeByIntegral(TH2*, double x 5)'
 
 
 
     // ------------------------------------------------------------------------
     //! Close a list of files
     // ------------------------------------------------------------------------
+    /*! The list is emptied afterwards, so files can't be
+     *  closed twice.
+     */
     void CloseFiles(std::vector<TFile*>& files) {
 
       for (std::size_t ifile = 0; ifile < files.size(); ++ifile) {
-        files[ifile] -> Close();
+        if (files[ifile]) files[ifile] -> Close();
       }
+      files.clear();
       return;
 
     }  // end 'CloseFiles(std::vector<TFile*>&)'
 
 
 
+    // ------------------------------------------------------------------------
+    //! Close a list of files when leaving scope
+    // ------------------------------------------------------------------------
+    /*! Makes sure files opened by a routine are closed even
+     *  if an error is raised (and collected, see Error) before
+     *  the routine closes them itself.
+     */
+    class FileCloser {
+
+      private:
+
+        // data members
+        std::vector<TFile*>* m_files;  ///!< files to close
+
+        // not copyable
+        FileCloser(const FileCloser&);
+        FileCloser& operator=(const FileCloser&);
+
+      public:
+
+        explicit FileCloser(std::vector<TFile*>& files) : m_files(&files) {};
+        ~FileCloser() {CloseFiles(*m_files);};
+
+    };  // end FileCloser
+
+
+
     // ------------------------------------------------------------------------
     //! Helper method to calculate a height based on line spacing
     // ------------------------------------------------------------------------
@@ -166,52 +244,322 @@ namespace PHEnergyCorrelator {
 
 
     // ------------------------------------------------------------------------
-    //! Divide two TH1s
+    //! Add two native 1D histograms
     // ------------------------------------------------------------------------
-    TH1* DivideHist1D(TH1* in_numer, TH1* in_denom, const double wnum = 1.0, const double wden = 1.0) {
+    /*! Returns c1 * a + c2 * b, with errors propagated like
+     *  TH1::Add. Histograms must have the same binning.
+     */
+    Hist1D AddHist1D(
+      const Hist1D& hista,
+      const Hist1D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      // throw error if binning doesn't match
+      if (!hista.IsCompatible(histb)) {
+        std::cerr << "PANIC: trying to add histograms with different binning!\n"
+                  << "       a = " << hista.GetName() << "\n"
+                  << "       b = " << histb.GetName()
+                  << std::endl;
+        Error::Raise("trying to add histograms with different binning");
+        assert(hista.IsCompatible(histb));
+      }
+
+      Hist1D sum = hista;
+      HistMath::Add(
+        hista.Content(), hista.Sumw2(),
+        histb.Content(), histb.Sumw2(),
+        sum.Content(), sum.Sumw2(),
+        sum.GetNcells(),
+        c1,
+        c2
+      );
+      return sum;
+
+    }  // end 'AddHist1D(Hist1D& x 2, double x 2)'
+
 
-      // grab inputs, create histogram to
-      // hold result
-      TH1* numer = (TH1*) in_numer -> Clone();
-      TH1* denom = (TH1*) in_denom -> Clone();
-      TH1* ratio = (TH1*) in_denom -> Clone();
-      ratio -> Reset("ICE");
 
-      // try automatic division
-      const bool isGoodDiv = ratio -> Divide(numer, denom, wnum, wden);
+    // ------------------------------------------------------------------------
+    //! Subtract two native 1D histograms
+    // ------------------------------------------------------------------------
+    /*! Returns c1 * a - c2 * b. */
+    Hist1D SubtractHist1D(
+      const Hist1D& hista,
+      const Hist1D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      return AddHist1D(hista, histb, c1, -1.0 * c2);
 
-      // if failed, do manual calculation
-      if (!isGoodDiv) {
+    }  // end 'SubtractHist1D(Hist1D& x 2, double x 2)'
 
-        // scale inputs
-        numer -> Scale(wnum);
-        denom -> Scale(wden);
 
-        // loop through denominator bins
-        const std::size_t ndenx = denom -> GetNbinsX();
-        for (std::size_t idenx = 1; idenx < ndenx; ++idenx) {
+
+    // ------------------------------------------------------------------------
+    //! Multiply two native 1D histograms
+    // ------------------------------------------------------------------------
+    /*! Returns (c1 * a) * (c2 * b), with errors propagated
+     *  like TH1::Multiply. Histograms must have the same
+     *  binning.
+     */
+    Hist1D MultiplyHist1D(
+      const Hist1D& hista,
+      const Hist1D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      // throw error if binning doesn't match
+      if (!hista.IsCompatible(histb)) {
+        std::cerr << "PANIC: trying to multiply histograms with different binning!\n"
+                  << "       a = " << hista.GetName() << "\n"
+                  << "       b = " << histb.GetName()
+                  << std::endl;
+        Error::Raise("trying to multiply histograms with different binning");
+        assert(hista.IsCompatible(histb));
+      }
+
+      Hist1D product = hista;
+      HistMath::Multiply(
+        hista.Content(), hista.Sumw2(),
+        histb.Content(), histb.Sumw2(),
+        product.Content(), product.Sumw2(),
+        product.GetNcells(),
+        c1,
+        c2
+      );
+      return product;
+
+    }  // end 'MultiplyHist1D(Hist1D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Add two native 2D histograms
+    // ------------------------------------------------------------------------
+    /*! Returns c1 * a + c2 * b, with errors propagated like
+     *  TH1::Add. Histograms must have the same binning.
+     */
+    Hist2D AddHist2D(
+      const Hist2D& hista,
+      const Hist2D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      // throw error if binning doesn't match
+      if (!hista.IsCompatible(histb)) {
+        std::cerr << "PANIC: trying to add histograms with different binning!\n"
+                  << "       a = " << hista.GetName() << "\n"
+                  << "       b = " << histb.GetName()
+                  << std::endl;
+        Error::Raise("trying to add histograms with different binning");
+        assert(hista.IsCompatible(histb));
+      }
+
+      Hist2D sum = hista;
+      HistMath::Add(
+        hista.Content(), hista.Sumw2(),
+        histb.Content(), histb.Sumw2(),
+        sum.Content(), sum.Sumw2(),
+        sum.GetNcells(),
+        c1,
+        c2
+      );
+      return sum;
+
+    }  // end 'AddHist2D(Hist2D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Subtract two native 2D histograms
+    // ------------------------------------------------------------------------
+    /*! Returns c1 * a - c2 * b. */
+    Hist2D SubtractHist2D(
+      const Hist2D& hista,
+      const Hist2D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      return AddHist2D(hista, histb, c1, -1.0 * c2);
+
+    }  // end 'SubtractHist2D(Hist2D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Multiply two native 2D histograms
+    // ------------------------------------------------------------------------
+    /*! Returns (c1 * a) * (c2 * b), with errors propagated
+     *  like TH1::Multiply. Histograms must have the same
+     *  binning.
+     */
+    Hist2D MultiplyHist2D(
+      const Hist2D& hista,
+      const Hist2D& histb,
+      const double c1 = 1.0,
+      const double c2 = 1.0
+    ) {
+
+      // throw error if binning doesn't match
+      if (!hista.IsCompatible(histb)) {
+        std::cerr << "PANIC: trying to multiply histograms with different binning!\n"
+                  << "       a = " << hista.GetName() << "\n"
+                  << "       b = " << histb.GetName()
+                  << std::endl;
+        Error::Raise("trying to multiply histograms with different binning");
+        assert(hista.IsCompatible(histb));
+      }
+
+      Hist2D product = hista;
+      HistMath::Multiply(
+        hista.Content(), hista.Sumw2(),
+        histb.Content(), histb.Sumw2(),
+        product.Content(), product.Sumw2(),
+        product.GetNcells(),
+        c1,
+        c2
+      );
+      return product;
+
+    }  // end 'MultiplyHist2D(Hist2D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Divide two native 1D histograms
+    // ------------------------------------------------------------------------
+    /*! If binning is consistent, errors are propagated the same
+     *  way as TH1::Divide. Otherwise each denominator bin is
+     *  divided by the closest numerator bin (via the cached
+     *  bin map between the two binnings) with relative errors
+     *  added in quadrature. The ratio takes the binning (and
+     *  name) of the denominator.
+     */
+    Hist1D DivideHist1D(
+      const Hist1D& numer,
+      const Hist1D& denom,
+      const double wnum = 1.0,
+      const double wden = 1.0
+    ) {
+
+      // create histogram to hold result
+      Hist1D ratio = denom;
+      ratio.Reset();
+
+      // if binning is consistent, divide bin-by-bin
+      if (numer.IsCompatible(denom)) {
+        HistMath::Divide(
+          numer.Content(), numer.Sumw2(),
+          denom.Content(), denom.Sumw2(),
+          ratio.Content(), ratio.Sumw2(),
+          ratio.GetNcells(),
+          wnum,
+          wden
+        );
+        return ratio;
+      }
+
+      // otherwise loop through denominator bins
+      const Binning::BinMap& map = Binning::Map( denom.GetBinning(), numer.GetBinning() );
+      for (int iden = 1; iden <= denom.GetNbins(); ++iden) {
+
+        // find closest numerator bin
+        const int inum = map[iden];
+
+        // grab content of dividends
+        const double valnum = wnum * numer.GetBinContent(inum);
+        const double valden = wden * denom.GetBinContent(iden);
+        const double pernum = (wnum * numer.GetBinError(inum)) / valnum;
+        const double perden = (wden * denom.GetBinError(iden)) / valden;
+
+        // take ratios
+        const double valrat = valnum / valden;
+        const double errrat = valrat * sqrt((pernum * pernum) + (perden * perden));
+        ratio.SetBinContent(iden, valrat);
+        ratio.SetBinError(iden, errrat);
+      }
+      return ratio;
+
+    }  // end 'DivideHist1D(Hist1D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Divide two native 2D histograms
+    // ------------------------------------------------------------------------
+    /*! See the 1D version. */
+    Hist2D DivideHist2D(
+      const Hist2D& numer,
+      const Hist2D& denom,
+      const double wnum = 1.0,
+      const double wden = 1.0
+    ) {
+
+      // create histogram to hold result
+      Hist2D ratio = denom;
+      ratio.Reset();
+
+      // if binning is consistent, divide bin-by-bin
+      if (numer.IsCompatible(denom)) {
+        HistMath::Divide(
+          numer.Content(), numer.Sumw2(),
+          denom.Content(), denom.Sumw2(),
+          ratio.Content(), ratio.Sumw2(),
+          ratio.GetNcells(),
+          wnum,
+          wden
+        );
+        return ratio;
+      }
+
+      // otherwise loop through denominator bins
+      const Binning::BinMap& mapx = Binning::Map( denom.GetXBinning(), numer.GetXBinning() );
+      const Binning::BinMap& mapy = Binning::Map( denom.GetYBinning(), numer.GetYBinning() );
+      for (int idenx = 1; idenx <= denom.GetNbinsX(); ++idenx) {
+        for (int ideny = 1; ideny <= denom.GetNbinsY(); ++ideny) {
 
           // find closest numerator bin
-          const double      xden  = denom -> GetBinCenter(idenx);
-          const std::size_t inumx = numer -> FindBin(xden);
+          const int inumx = mapx[idenx];
+          const int inumy = mapy[ideny];
 
           // grab content of dividends
-          const double valnum = numer -> GetBinContent(inumx);
-          const double valden = denom -> GetBinContent(idenx);
-          const double errnum = numer -> GetBinError(inumx);
-          const double errden = denom -> GetBinError(idenx);
-          const double pernum = errnum / valnum;
-          const double perden = errden / valden;
+          const double valnum = wnum * numer.GetBinContent(inumx, inumy);
+          const double valden = wden * denom.GetBinContent(idenx, ideny);
+          const double pernum = (wnum * numer.GetBinError(inumx, inumy)) / valnum;
+          const double perden = (wden * denom.GetBinError(idenx, ideny)) / valden;
 
           // take ratios
           const double valrat = valnum / valden;
           const double errrat = valrat * sqrt((pernum * pernum) + (perden * perden));
-          ratio -> SetBinContent(idenx, valrat);
-          ratio -> SetBinError(idenx, errrat);
-        }
-      }
+          ratio.SetBinContent(idenx, ideny, valrat);
+          ratio.SetBinError(idenx, ideny, errrat);
+        }  // end y bin loop
+      }  // end x bin loop
       return ratio;
 
+    }  // end 'DivideHist2D(Hist2D& x 2, double x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Divide two TH1s
+    // ------------------------------------------------------------------------
+    /*! Wrapper around the native version for ROOT histograms.
+     *  The ratio is a new TH1D owned by the caller: it isn't
+     *  from the HistPool, so delete it rather than releasing
+     *  it to the pool (which would refuse it).
+     */
+    TH1* DivideHist1D(TH1* in_numer, TH1* in_denom, const double wnum = 1.0, const double wden = 1.0) {
+
+      Hist1D ratio = DivideHist1D( Hist1D(in_numer), Hist1D(in_denom), wnum, wden );
+      return ratio.MakeTH1();
+
     }  // end 'DivideHist1D(TH1*, TH1*, double, double)'
 
 
@@ -219,54 +567,11 @@ namespace PHEnergyCorrelator {
     // ------------------------------------------------------------------------
     //! Divide two TH2s
     // ------------------------------------------------------------------------
+    /*! Wrapper around the native version for ROOT histograms. */
     TH2* DivideHist2D(TH2* in_numer, TH2* in_denom, const double wnum = 1.0, const double wden = 1.0) {
 
-      // grab inputs, create histogram to
-      // hold result
-      TH2* numer = (TH2*) in_numer -> Clone();
-      TH2* denom = (TH2*) in_denom -> Clone();
-      TH2* ratio = (TH2*) in_denom -> Clone();
-      ratio -> Reset("ICE");
-
-      // try automatic division
-      const bool isGoodDiv = ratio -> Divide(numer, denom, wnum, wden);
-
-      // if failed, do manual calculation
-      if (!isGoodDiv) {
-
-        // scale inputs
-        numer -> Scale(wnum);
-        denom -> Scale(wden);
-
-        // loop through denominator bins
-        const std::size_t ndenx = denom -> GetNbinsX();
-        const std::size_t ndeny = denom -> GetNbinsY();
-        for (std::size_t idenx = 1; idenx < ndenx; ++idenx) {
-          for (std::size_t ideny = 1; ideny < ndeny; ++ideny) {
-
-            // find closest numerator bin
-            const double      xden  = denom -> GetXaxis() -> GetBinCenter(idenx);
-            const double      yden  = denom -> GetYaxis() -> GetBinCenter(ideny);
-            const std::size_t inumx = numer -> GetXaxis() -> FindBin(xden);
-            const std::size_t inumy = numer -> GetYaxis() -> FindBin(yden);
-
-            // grab content of dividends
-            const double valnum = numer -> GetBinContent(inumx, inumy);
-            const double valden = denom -> GetBinContent(idenx, ideny);
-            const double errnum = numer -> GetBinError(inumx, inumy);
-            const double errden = denom -> GetBinError(idenx, ideny);
-            const double pernum = errnum / valnum;
-            const double perden = errden / valden;
-
-            // take ratios
-            const double valrat = valnum / valden;
-            const double errrat = valrat * sqrt((pernum * pernum) + (perden * perden));
-            ratio -> SetBinContent(idenx, ideny, valrat);
-            ratio -> SetBinError(idenx, ideny, errrat);
-          }  // end y bin loop
-        }  // end x bin loop
-      }
-      return ratio;
+      Hist2D ratio = DivideHist2D( Hist2D(in_numer), Hist2D(in_denom), wnum, wden );
+      return ratio.MakeTH2();
 
     }  // end 'DivideHist2D(TH2*, TH2*, double, double)'
 
@@ -283,15 +588,20 @@ namespace PHEnergyCorrelator {
         std::cerr << "PANIC: couldn't open file!\n"
                   << "       file = " << name << "\n"
                   << std::endl;
+        Error::Raise("couldn't open file " + name);
         assert(file);
       }
 
       // then check file by cd'ing into it
       const bool isGoodCD = file -> cd();
       if (!isGoodCD) {
+        file -> Close();
+        delete file;
+        file = NULL;
         std::cerr << "PANIC: couldn't cd into file!\n"
                   << "       file = " << name << "\n"
                   << std::endl;
+        Error::Raise("couldn't cd into file " + name);
         assert(isGoodCD);
       }
       return file;
@@ -312,6 +622,7 @@ namespace PHEnergyCorrelator {
                   << "       file   = " << file   << "\n"
                   << "       object = " << object << "\n"
                   << std::endl;
+        Error::Raise("couldn't grab object " + object + " from " + file -> GetName());
         assert(grabbed);
       }
       return grabbed;
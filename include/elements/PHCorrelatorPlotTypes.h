@@ -59,6 +59,11 @@ namespace PHEnergyCorrelator {
     // ------------------------------------------------------------------------
     enum Margin {Top, Right, Bottom, Left};
 
+    // ------------------------------------------------------------------------
+    //! Storage precision of derived histograms
+    // ------------------------------------------------------------------------
+    enum Precision {Double, Float};
+
   }  // end Types namespace
 }  // end PHEnergyCorrelator namespace
 
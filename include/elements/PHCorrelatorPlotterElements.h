@@ -11,22 +11,50 @@
 #ifndef PHCORRELATORPLOTTERELEMENTS_H
 #define PHCORRELATORPLOTTERELEMENTS_H
 
+#include "PHCorrelatorAdaptiveRebin.h"
+#include "PHCorrelatorAsymmetryEngine.h"
+#include "PHCorrelatorBinning.h"
 #include "PHCorrelatorCanvas.h"
 #include "PHCorrelatorCanvasManager.h"
+#include "PHCorrelatorClosureEngine.h"
+#include "PHCorrelatorComparisonTensor.h"
+#include "PHCorrelatorCorrectionStore.h"
+#include "PHCorrelatorCovariance.h"
+#include "PHCorrelatorGoodnessOfFit.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorHistCompare.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorHistPool.h"
 #include "PHCorrelatorLegend.h"
+#include "PHCorrelatorLoadTools.h"
+#include "PHCorrelatorMetricsEngine.h"
+#include "PHCorrelatorModulationFitter.h"
+#include "PHCorrelatorNtupleFiller.h"
 #include "PHCorrelatorPad.h"
 #include "PHCorrelatorPadOpts.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
 #include "PHCorrelatorPlotInput.h"
 #include "PHCorrelatorPlotOpts.h"
 #include "PHCorrelatorPlotShape.h"
 #include "PHCorrelatorPlotTools.h"
 #include "PHCorrelatorPlotTypes.h"
 #include "PHCorrelatorProjection.h"
+#include "PHCorrelatorPullMap.h"
+#include "PHCorrelatorRandom.h"
 #include "PHCorrelatorRange.h"
 #include "PHCorrelatorRebin.h"
+#include "PHCorrelatorReplicaEngine.h"
 #include "PHCorrelatorShape.h"
+#include "PHCorrelatorSharedStore.h"
+#include "PHCorrelatorSparseMatrix.h"
+#include "PHCorrelatorSpinRatioEngine.h"
 #include "PHCorrelatorStyle.h"
+#include "PHCorrelatorTable.h"
 #include "PHCorrelatorTextBox.h"
+#include "PHCorrelatorTileStore.h"
+#include "PHCorrelatorUnfolder.h"
+#include "PHCorrelatorVariationEngine.h"
 
 #endif
 
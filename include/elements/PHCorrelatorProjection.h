@@ -16,6 +16,7 @@
 #include <TH1.h>
 #include <TH2.h>
 // plotting utilities
+#include "PHCorrelatorHist.h"
 #include "PHCorrelatorPlotTypes.h"
 #include "PHCorrelatorRange.h"
 #include "PHCorrelatorStyle.h"
@@ -39,13 +40,36 @@ namespace PHEnergyCorrelator {
     std::string draw;    ///!< draw option
     Style::Plot style;   ///!< marker, line, and fill style
 
+    // ------------------------------------------------------------------------
+    //! Do projection on a native histogram
+    // ------------------------------------------------------------------------
+    /*! Projects onto the specified axis, summing over
+     *  the bins of the other axis within the range.
+     */
+    Hist1D Project(const Hist2D& hist) const {
+
+      if (axis == Type::Y) {
+        return hist.ProjectionY(
+          rename,
+          hist.FindXBin(range.first),
+          hist.FindXBin(range.second)
+        );
+      } else {
+        return hist.ProjectionX(
+          rename,
+          hist.FindYBin(range.first),
+          hist.FindYBin(range.second)
+        );
+      }
+
+    }  // end 'Project(Hist2D&)'
+
     // ------------------------------------------------------------------------
     //! Do projection
     // ------------------------------------------------------------------------
-    TH1* ProjectTH1(const TH2* hist) {
+    TH1* ProjectTH1(const TH2* hist) const {
 
-      /* TODO fill in */
-      return new TH1D("hToDo", "TODO", 10, 0.0, 1.0);
+      return Project( Hist2D(hist) ).MakeTH1();
 
     }  // end 'ProjectTH1(TH2*)'
 
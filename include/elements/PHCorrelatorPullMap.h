@@ -0,0 +1,267 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorPullMap.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Bin-by-bin pulls (significances) between two 2D
+ *  spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORPULLMAP_H
+#define PHCORRELATORPULLMAP_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorTable.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Pull map
+  // ==========================================================================
+  /*! Computes the pull
+   *
+   *      (A - B) / sqrt(sigma_A^2 + sigma_B^2)
+   *
+   *  of every cell of two 2D spectra, optionally after
+   *  merging groups of adjacent bins so that fluctuations
+   *  of sparsely-filled cells average out. Cells where
+   *  both errors vanish get a pull of 0.
+   *
+   *  The kernel runs over the contiguous cell arrays in
+   *  tiles of `TileY` rows by `TileX` cells, so that each
+   *  tile's inputs and outputs stay in cache, with a
+   *  branch-free inner loop the compiler can vectorize.
+   *
+   *  Each map also adds its `nTop` most significant cells
+   *  (by absolute pull) to a table, so the cells worth a
+   *  look can be read off without opening the plots.
+   */
+  class PullMap {
+
+    public:
+
+      // tile dimensions
+      enum {TileX = 256, TileY = 8};
+
+    private:
+
+      // data members
+      int         m_nGroupX;  ///!< no. of x bins to merge
+      int         m_nGroupY;  ///!< no. of y bins to merge
+      std::size_t m_nTop;     ///!< no. of most significant cells to record per map
+      Table       m_table;    ///!< most significant cells of each map
+
+      // ----------------------------------------------------------------------
+      //! Columns of results table
+      // ----------------------------------------------------------------------
+      static std::vector<std::string> Columns() {
+
+        std::vector<std::string> columns;
+        columns.push_back("rank");
+        columns.push_back("ix");
+        columns.push_back("iy");
+        columns.push_back("xlow");
+        columns.push_back("xhigh");
+        columns.push_back("ylow");
+        columns.push_back("yhigh");
+        columns.push_back("a");
+        columns.push_back("b");
+        columns.push_back("pull");
+        return columns;
+
+      }  // end 'Columns()'
+
+      // ----------------------------------------------------------------------
+      //! Record most significant cells of a map
+      // ----------------------------------------------------------------------
+      void Record(const Hist2D& pulls, const Hist2D& a, const Hist2D& b) {
+
+        // rank regular cells by absolute pull
+        std::vector<std::pair<double, int> > cells;
+        for (int iy = 1; iy <= pulls.GetNbinsY(); ++iy) {
+          for (int ix = 1; ix <= pulls.GetNbinsX(); ++ix) {
+            const int cell = pulls.GetBin(ix, iy);
+            cells.push_back( std::make_pair(std::fabs(pulls.Content()[cell]), cell) );
+          }
+        }
+
+        const std::size_t ntop = std::min(m_nTop, cells.size());
+        std::partial_sort(
+          cells.begin(),
+          cells.begin() + ntop,
+          cells.end(),
+          std::greater<std::pair<double, int> >()
+        );
+
+        const int nxcells = pulls.GetNbinsX() + 2;
+        for (std::size_t itop = 0; itop < ntop; ++itop) {
+
+          const int cell = cells[itop].second;
+          const int ix   = cell % nxcells;
+          const int iy   = cell / nxcells;
+
+          std::vector<double> values;
+          values.push_back(itop + 1);
+          values.push_back(ix);
+          values.push_back(iy);
+          values.push_back(pulls.GetXEdges()[ix - 1]);
+          values.push_back(pulls.GetXEdges()[ix]);
+          values.push_back(pulls.GetYEdges()[iy - 1]);
+          values.push_back(pulls.GetYEdges()[iy]);
+          values.push_back(a.Content()[cell]);
+          values.push_back(b.Content()[cell]);
+          values.push_back(pulls.Content()[cell]);
+          m_table.AddRow(pulls.GetName(), values);
+        }
+        return;
+
+      }  // end 'Record(Hist2D& x 3)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      int          GetNGroupX() const {return m_nGroupX;}
+      int          GetNGroupY() const {return m_nGroupY;}
+      std::size_t  GetNTop()    const {return m_nTop;}
+      const Table& GetTable()   const {return m_table;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetNTop(const std::size_t ntop) {m_nTop = ntop;}
+      void SetNGroups(const int ngroupx, const int ngroupy) {m_nGroupX = ngroupx; m_nGroupY = ngroupy;}
+
+      // ----------------------------------------------------------------------
+      //! Tiled pull kernel
+      // ----------------------------------------------------------------------
+      /*! \param ca, sa  contents, squared errors of A
+       *  \param cb, sb  contents, squared errors of B
+       *  \param[out] po pulls
+       *  \param nx, ny  no. of cells along x (fastest), y
+       */
+      static void Kernel(
+        const double* ca, const double* sa,
+        const double* cb, const double* sb,
+        double* po,
+        const std::size_t nx,
+        const std::size_t ny
+      ) {
+
+        for (std::size_t iy0 = 0; iy0 < ny; iy0 += TileY) {
+          const std::size_t iy1 = std::min(iy0 + TileY, ny);
+          for (std::size_t ix0 = 0; ix0 < nx; ix0 += TileX) {
+            const std::size_t ix1 = std::min(ix0 + TileX, nx);
+            for (std::size_t iy = iy0; iy < iy1; ++iy) {
+
+              const std::size_t row = iy * nx;
+              for (std::size_t ix = row + ix0; ix < row + ix1; ++ix) {
+                const double var = sa[ix] + sb[ix];
+                const double inv = (var > 0.) ? 1. / std::sqrt(var) : 0.;
+                po[ix] = (ca[ix] - cb[ix]) * inv;
+              }
+            }
+          }
+        }
+        return;
+
+      }  // end 'Kernel(double* x 5, std::size_t x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Compute pull map of two spectra
+      // ----------------------------------------------------------------------
+      /*! Pulls are stored as contents (with no error) of
+       *  a histogram with the (merged) binning of the
+       *  inputs.
+       *
+       *  \param a    first spectrum
+       *  \param b    second spectrum
+       *  \param name name of map
+       */
+      Hist2D Compute(const Hist2D& a, const Hist2D& b, const std::string& name) {
+
+        // coarse-grain if need be
+        Hist2D amerge = a;
+        Hist2D bmerge = b;
+        amerge.Rebin(m_nGroupX, m_nGroupY);
+        bmerge.Rebin(m_nGroupX, m_nGroupY);
+
+        if (!amerge.IsCompatible(bmerge)) {
+          std::cerr << "PANIC: can't compute pulls of " << a.GetName() << " and " << b.GetName()
+                    << ", binnings differ!"
+                    << std::endl;
+          Error::Raise("can't compute pulls of histograms with different binnings");
+          assert(amerge.IsCompatible(bmerge));
+        }
+
+        Hist2D pulls = amerge;
+        pulls.Reset();
+        pulls.SetName(name);
+        pulls.SetZTitle("(A - B) / #sigma");
+        Kernel(
+          amerge.Content(), amerge.Sumw2(),
+          bmerge.Content(), bmerge.Sumw2(),
+          pulls.Content(),
+          amerge.GetNbinsX() + 2,
+          amerge.GetNbinsY() + 2
+        );
+
+        Record(pulls, amerge, bmerge);
+        return pulls;
+
+      }  // end 'Compute(Hist2D& x 2, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Clear table of significant cells
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_table.Clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared pull map
+      // ----------------------------------------------------------------------
+      static PullMap& Global() {
+
+        static PullMap map;
+        return map;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      PullMap()
+        : m_nGroupX(1)
+        , m_nGroupY(1)
+        , m_nTop(10)
+        , m_table(Columns())
+      {};
+      ~PullMap() {};
+
+  };  // end PullMap
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,221 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorRandom.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Fast, splittable random number streams.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORRANDOM_H
+#define PHCORRELATORRANDOM_H
+
+// c++ utilities
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Random number stream
+  // ==========================================================================
+  /*! A xoshiro256+ generator. Each stream is seeded from a
+   *  (seed, stream) pair by SplitMix64, so streams handed to
+   *  different threads (or replicas) are independent and
+   *  reproducible regardless of how work is scheduled. Unlike
+   *  TRandom3 there's no shared state, so streams can be used
+   *  concurrently without locking.
+   *
+   *  Uniforms are generated in blocks (`FillUniform`) so the
+   *  transforms to Gaussian/Poisson deviates run over
+   *  contiguous arrays.
+   */
+  class RandomStream {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Convenient types
+      // ----------------------------------------------------------------------
+      typedef unsigned long long Word;
+
+    private:
+
+      // data members
+      Word m_state[4];  ///!< generator state
+
+      // ----------------------------------------------------------------------
+      //! Rotate left
+      // ----------------------------------------------------------------------
+      static Word Rotate(const Word word, const int nbits) {
+
+        return (word << nbits) | (word >> (64 - nbits));
+
+      }  // end 'Rotate(Word, int)'
+
+      // ----------------------------------------------------------------------
+      //! SplitMix64 step (used for seeding)
+      // ----------------------------------------------------------------------
+      static Word SplitMix(Word& state) {
+
+        state += 0x9E3779B97F4A7C15ULL;
+        Word mix = state;
+        mix = (mix ^ (mix >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        mix = (mix ^ (mix >> 27)) * 0x94D049BB133111EBULL;
+        return mix ^ (mix >> 31);
+
+      }  // end 'SplitMix(Word&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Seed stream
+      // ----------------------------------------------------------------------
+      /*! \param seed   global seed
+       *  \param stream index of stream (e.g. thread or replica)
+       */
+      void Seed(const Word seed, const Word stream = 0) {
+
+        Word salt = stream;
+        Word mix  = seed ^ SplitMix(salt);
+        for (int iword = 0; iword < 4; ++iword) {
+          m_state[iword] = SplitMix(mix);
+        }
+        return;
+
+      }  // end 'Seed(Word, Word)'
+
+      // ----------------------------------------------------------------------
+      //! Next 64 random bits
+      // ----------------------------------------------------------------------
+      Word Next() {
+
+        const Word result = m_state[0] + m_state[3];
+        const Word shift  = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shift;
+        m_state[3]  = Rotate(m_state[3], 45);
+        return result;
+
+      }  // end 'Next()'
+
+      // ----------------------------------------------------------------------
+      //! Uniform deviate in (0, 1)
+      // ----------------------------------------------------------------------
+      double Uniform() {
+
+        // top 53 bits, offset by half a step to exclude 0
+        return ((double) (Next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+
+      }  // end 'Uniform()'
+
+      // ----------------------------------------------------------------------
+      //! Fill a block with uniform deviates in (0, 1)
+      // ----------------------------------------------------------------------
+      void FillUniform(double* out, const std::size_t size) {
+
+        for (std::size_t idx = 0; idx < size; ++idx) {
+          out[idx] = Uniform();
+        }
+        return;
+
+      }  // end 'FillUniform(double*, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      RandomStream()  {Seed(0, 0);}
+      ~RandomStream() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting seed and stream
+      // ----------------------------------------------------------------------
+      RandomStream(const Word seed, const Word stream) {Seed(seed, stream);}
+
+  };  // end RandomStream
+
+
+
+  // --------------------------------------------------------------------------
+  //! Transforms of uniform deviates
+  // --------------------------------------------------------------------------
+  namespace Random {
+
+    // ------------------------------------------------------------------------
+    //! Inverse of the standard normal CDF
+    // ------------------------------------------------------------------------
+    /*! Acklam's rational approximation (relative error
+     *  < 1.2e-9), which is plenty for fluctuating inputs.
+     */
+    double InverseNormal(const double prob) {
+
+      static const double a[6] = {-3.969683028665376e+01,  2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01,  2.506628277459239e+00};
+      static const double b[5] = {-5.447609879822406e+01,  1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+      static const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                  -2.549732539343734e+00,  4.374664141464968e+00,  2.938163982698783e+00};
+      static const double d[4] = { 7.784695709041462e-03,  3.224671290700398e-01,  2.445134137142996e+00,
+                                   3.754408661907416e+00};
+      const double low  = 0.02425;
+      const double high = 1. - low;
+
+      if (prob < low) {
+        const double q = std::sqrt(-2. * std::log(prob));
+        return (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+               ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.);
+      }
+      if (prob > high) {
+        const double q = std::sqrt(-2. * std::log(1. - prob));
+        return -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+                ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.);
+      }
+
+      const double q = prob - 0.5;
+      const double r = q * q;
+      return (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5]) * q /
+             (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.);
+
+    }  // end 'InverseNormal(double)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Inverse of the Poisson CDF
+    // ------------------------------------------------------------------------
+    /*! Exact (sequential search) for small means; above
+     *  `limit` a continuity-corrected normal approximation
+     *  is used instead.
+     */
+    double InversePoisson(const double prob, const double mean, const double limit = 30.) {
+
+      if (mean <= 0.) return 0.;
+      if (mean > limit) {
+        const double draw = std::floor(mean + (std::sqrt(mean) * InverseNormal(prob)) + 0.5);
+        return (draw > 0.) ? draw : 0.;
+      }
+
+      double count = 0.;
+      double term  = std::exp(-mean);
+      double cdf   = term;
+      while ((cdf < prob) && (term > 0.)) {
+        count += 1.;
+        term  *= mean / count;
+        cdf   += term;
+      }
+      return count;
+
+    }  // end 'InversePoisson(double, double x 2)'
+
+  }  // end Random namespace
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
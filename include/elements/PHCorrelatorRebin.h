@@ -17,6 +17,8 @@
 #include <TH2.h>
 #include <TH3.h>
 // plotting utilities
+#include "PHCorrelatorAdaptiveRebin.h"
+#include "PHCorrelatorHist.h"
 #include "PHCorrelatorPlotTypes.h"
 #include "PHCorrelatorRange.h"
 
@@ -28,23 +30,33 @@ namespace PHEnergyCorrelator {
   //! Rebinning
   // ==========================================================================
   /*! A small helper class to facilitate rebinning.
+   *
+   *  Rebinning is either by merging a fixed number of
+   *  bins, or adaptive (see AdaptiveRebin) when created
+   *  with `Rebin::Adaptive(...)`. Adaptive rebinning only
+   *  applies to native 1D histograms; when several are
+   *  compared, routines rebin them together so they share
+   *  a binning (see `BaseRoutine::RebinCommon(...)`).
    */
   class Rebin {
 
     private:
 
-      Range::Axis m_axis;   ///!< which axis to rebin
-      std::size_t m_num;    ///!< number of bins to merge
-      bool        m_rebin;  ///!< do or do not do rebinning
+      Range::Axis m_axis;    ///!< which axis to rebin
+      std::size_t m_num;     ///!< number of bins to merge
+      bool        m_rebin;   ///!< do or do not do rebinning
+      double      m_target;  ///!< target relative uncertainty (adaptive only)
 
     public:
 
       // ----------------------------------------------------------------------
       //! Getters
       // ----------------------------------------------------------------------
-      Range::Axis GetAxis()  const {return m_axis;}
-      std::size_t GetNum()   const {return m_num;}
-      bool        GetRebin() const {return m_rebin;}
+      Range::Axis GetAxis()    const {return m_axis;}
+      std::size_t GetNum()     const {return m_num;}
+      bool        GetRebin()   const {return m_rebin;}
+      double      GetTarget()  const {return m_target;}
+      bool        IsAdaptive() const {return m_rebin && (m_target > 0.);}
 
       // ----------------------------------------------------------------------
       //! Setters
@@ -52,6 +64,7 @@ namespace PHEnergyCorrelator {
       void SetAxis(const Range::Axis axis) {m_axis  = axis;}
       void SetNum(const std::size_t num)   {m_num   = num;}
       void SetRebin(const bool rebin)      {m_rebin = rebin;}
+      void SetTarget(const double target)  {m_target = target;}
 
       // ----------------------------------------------------------------------
       //! Apply rebinning to a TH1
@@ -106,10 +119,44 @@ namespace PHEnergyCorrelator {
 
       }  // end 'Apply(TH3*)'
 
+      // ----------------------------------------------------------------------
+      //! Apply rebinning to a native 1D histogram
+      // ----------------------------------------------------------------------
+      void Apply(Hist1D& hist) const {
+
+        if (IsAdaptive()) {
+          AdaptiveRebin::Global().Apply(hist, m_target);
+        } else {
+          hist.Rebin(m_num);
+        }
+        return;
+
+      }  // end 'Apply(Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Apply rebinning to a native 2D histogram
+      // ----------------------------------------------------------------------
+      void Apply(Hist2D& hist) const {
+
+        switch (m_axis) {
+          case Range::Y:
+            hist.Rebin(1, m_num);
+            break;
+          case Range::X:
+            hist.Rebin(m_num, 1);
+            break;
+          default:
+            hist.Rebin(m_num, 1);
+            break;
+        }
+        return;
+
+      }  // end 'Apply(Hist2D&)'
+
       // ----------------------------------------------------------------------
       //! default ctor/dtor
       // ----------------------------------------------------------------------
-      Rebin() : m_axis(Range::X), m_num(2), m_rebin(false) {};
+      Rebin() : m_axis(Range::X), m_num(2), m_rebin(false), m_target(0.) {};
       ~Rebin() {};
 
       // ----------------------------------------------------------------------
@@ -120,11 +167,24 @@ namespace PHEnergyCorrelator {
         const std::size_t num = 2,
         const Range::Axis axis = Range::X
       ) {
-        m_rebin = rebin;
-        m_num   = num;
-        m_axis  = axis;
+        m_rebin  = rebin;
+        m_num    = num;
+        m_axis   = axis;
+        m_target = 0.;
       }
 
+      // ----------------------------------------------------------------------
+      //! Make an adaptive rebinning
+      // ----------------------------------------------------------------------
+      /*! \param target target relative uncertainty of merged bins */
+      static Rebin Adaptive(const double target, const Range::Axis axis = Range::X) {
+
+        Rebin rebin(true, 1, axis);
+        rebin.SetTarget(target);
+        return rebin;
+
+      }  // end 'Adaptive(double, Range::Axis)'
+
   };  // end Rebin
 
 }  // end PHEnergyCorrelator namespace
@@ -0,0 +1,476 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorReplicaEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Bootstrap-style replica uncertainties for
+ *  ratios and corrected spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORREPLICAENGINE_H
+#define PHCORRELATORREPLICAENGINE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorCovariance.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotOpts.h"
+#include "PHCorrelatorPlotTools.h"
+#include "PHCorrelatorRandom.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Chain of operations to rerun on replicas
+  // ==========================================================================
+  /*! Takes a fixed number of input spectra and returns one
+   *  output spectrum. Evaluate must only touch its arguments
+   *  (it's called from several threads at once).
+   */
+  class ReplicaChain {
+
+    protected:
+
+      // data members
+      PlotOpts m_options;  ///!< normalization options
+
+      // ----------------------------------------------------------------------
+      //! Normalize a spectrum according to the options
+      // ----------------------------------------------------------------------
+      void Normalize(Hist1D& hist) const {
+
+        if (!m_options.do_norm) return;
+        Tools::NormalizeByIntegral(
+          hist,
+          m_options.norm_to,
+          m_options.norm_range.GetX().first,
+          m_options.norm_range.GetX().second
+        );
+        return;
+
+      }  // end 'Normalize(Hist1D&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! No. of inputs the chain takes
+      // ----------------------------------------------------------------------
+      virtual std::size_t GetNInputs() const = 0;
+
+      // ----------------------------------------------------------------------
+      //! Run the chain on a set of inputs
+      // ----------------------------------------------------------------------
+      virtual Hist1D Evaluate(const std::vector<Hist1D>& inputs) const = 0;
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ReplicaChain()          {};
+      virtual ~ReplicaChain() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting options
+      // ----------------------------------------------------------------------
+      explicit ReplicaChain(const PlotOpts& options) : m_options(options) {};
+
+  };  // end ReplicaChain
+
+
+
+  // ==========================================================================
+  //! Ratio chain: normalize, then numerator / denominator
+  // ==========================================================================
+  /*! Inputs are {numerator, denominator}; mirrors the
+   *  ratios of PlotVsBaseline1D and the spin ratios.
+   */
+  class RatioChain : public ReplicaChain {
+
+    public:
+
+      std::size_t GetNInputs() const {return 2;}
+
+      Hist1D Evaluate(const std::vector<Hist1D>& inputs) const {
+
+        Hist1D numer = inputs[0];
+        Hist1D denom = inputs[1];
+        Normalize(numer);
+        Normalize(denom);
+
+        Hist1D ratio = Tools::DivideHist1D(numer, denom);
+        ratio.SetName( numer.GetName() + "_Ratio" );
+        return ratio;
+
+      }  // end 'Evaluate(std::vector<Hist1D>&)'
+
+      explicit RatioChain(const PlotOpts& options = PlotOpts()) : ReplicaChain(options) {};
+
+  };  // end RatioChain
+
+
+
+  // ==========================================================================
+  //! Correction chain: data / (reco / truth)
+  // ==========================================================================
+  /*! Inputs are {data, reco, truth}; mirrors the
+   *  bin-by-bin corrections of CorrectSpectra1D.
+   */
+  class CorrectionChain : public ReplicaChain {
+
+    public:
+
+      std::size_t GetNInputs() const {return 3;}
+
+      Hist1D Evaluate(const std::vector<Hist1D>& inputs) const {
+
+        Hist1D data  = inputs[0];
+        Hist1D recon = inputs[1];
+        Hist1D truth = inputs[2];
+        Normalize(data);
+        Normalize(recon);
+        Normalize(truth);
+
+        Hist1D corrected = Tools::DivideHist1D( data, Tools::DivideHist1D(recon, truth) );
+        corrected.SetName( data.GetName() + "_Corrected" );
+        Normalize(corrected);
+        return corrected;
+
+      }  // end 'Evaluate(std::vector<Hist1D>&)'
+
+      explicit CorrectionChain(const PlotOpts& options = PlotOpts()) : ReplicaChain(options) {};
+
+  };  // end CorrectionChain
+
+
+
+  // ==========================================================================
+  //! Percentile band from replicas
+  // ==========================================================================
+  struct ReplicaBand {
+
+    // members
+    Hist1D      nominal;    ///!< chain evaluated on unfluctuated inputs
+    Hist1D      median;     ///!< median of replicas
+    Hist1D      low;        ///!< lower percentile of replicas
+    Hist1D      high;       ///!< upper percentile of replicas
+    Covariance  covariance; ///!< bin-to-bin covariance of replicas
+    std::size_t nreplicas;  ///!< no. of replicas used
+
+    // ------------------------------------------------------------------------
+    //! Nominal with (symmetrized) band width as its error
+    // ------------------------------------------------------------------------
+    Hist1D MakeNominalWithBand() const {
+
+      Hist1D band = nominal;
+      for (int icell = 0; icell < band.GetNcells(); ++icell) {
+        const double half = 0.5 * (high.GetBinContent(icell) - low.GetBinContent(icell));
+        band.SetBinError(icell, half);
+      }
+      return band;
+
+    }  // end 'MakeNominalWithBand()'
+
+    // ------------------------------------------------------------------------
+    //! default ctor
+    // ------------------------------------------------------------------------
+    ReplicaBand() : nreplicas(0) {};
+
+  };  // end ReplicaBand
+
+
+
+  // ==========================================================================
+  //! Replica engine
+  // ==========================================================================
+  /*! Estimates uncertainties by rerunning a ReplicaChain on N
+   *  replicas of its inputs, each bin fluctuated by either
+   *    - Poisson: N ~ Pois(n_eff) scaled back by c / n_eff,
+   *      with n_eff = c^2 / sumw2 the effective no. of entries;
+   *    - Gaussian: c + sigma z;
+   *  and reporting the percentile band of the results.
+   *
+   *  Inputs are fluctuated independently by default. Inputs
+   *  can be put into correlation groups: inputs of the same
+   *  group are fluctuated with the same random numbers bin-by-
+   *  bin, i.e. treated as *fully* correlated. That's only right
+   *  for inputs built from the same counts (e.g. the same
+   *  spectrum entering a chain twice); partially correlated
+   *  inputs, like reco and truth spectra of one simulation,
+   *  should be left ungrouped, since grouping them cancels
+   *  their fluctuations in ratios and shrinks the band.
+   *
+   *  Replicas are spread over threads. Replica r always draws
+   *  from random stream (seed, r), so results don't depend on
+   *  the number of threads.
+   */
+  class ReplicaEngine {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Fluctuation modes
+      // ----------------------------------------------------------------------
+      enum Mode {Poisson, Gaussian};
+
+    private:
+
+      // data members
+      std::size_t      m_nReplicas;  ///!< no. of replicas
+      Mode             m_mode;       ///!< how to fluctuate inputs
+      unsigned long    m_seed;       ///!< global seed
+      double           m_level;      ///!< coverage of band (e.g. 0.6827)
+      std::vector<int> m_groups;     ///!< correlation group of each input
+
+      // ======================================================================
+      //! Evaluates a chain on each replica
+      // ======================================================================
+      class ReplicaTask : public Parallel::Task {
+
+        private:
+
+          const ReplicaEngine*       m_engine;
+          const ReplicaChain*        m_chain;
+          const std::vector<Hist1D>* m_inputs;
+          std::vector<double>*       m_values;
+          std::size_t                m_ncells;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            const Hist1D result = m_chain -> Evaluate( m_engine -> MakeReplica(*m_inputs, item) );
+            for (std::size_t icell = 0; icell < m_ncells; ++icell) {
+              (*m_values)[(item * m_ncells) + icell] = result.GetBinContent(icell);
+            }
+          }
+
+          ReplicaTask(
+            const ReplicaEngine* engine,
+            const ReplicaChain* chain,
+            const std::vector<Hist1D>* inputs,
+            std::vector<double>* values,
+            const std::size_t ncells
+          ) : m_engine(engine), m_chain(chain), m_inputs(inputs), m_values(values), m_ncells(ncells) {};
+
+      };  // end ReplicaTask
+      friend class ReplicaTask;
+
+      // ----------------------------------------------------------------------
+      //! Get correlation group of an input
+      // ----------------------------------------------------------------------
+      int GetGroup(const std::size_t input) const {
+
+        return (input < m_groups.size()) ? m_groups[input] : -1 - (int) input;
+
+      }  // end 'GetGroup(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Fluctuate one spectrum with a block of uniforms
+      // ----------------------------------------------------------------------
+      void Fluctuate(Hist1D& hist, const std::vector<double>& uniforms) const {
+
+        for (int icell = 0; icell < hist.GetNcells(); ++icell) {
+
+          const double content = hist.GetBinContent(icell);
+          const double sumw2   = hist.GetBinSumw2(icell);
+          if (sumw2 <= 0.) continue;
+
+          if (m_mode == Gaussian) {
+            hist.SetBinContent(icell, content + (std::sqrt(sumw2) * Random::InverseNormal(uniforms[icell])));
+          } else {
+            if (content <= 0.) continue;
+            const double neff  = (content * content) / sumw2;
+            const double scale = content / neff;
+            const double draw  = Random::InversePoisson(uniforms[icell], neff) * scale;
+            hist.SetBinContent(icell, draw);
+            hist.SetBinSumw2(icell, draw * scale);
+          }
+        }
+        return;
+
+      }  // end 'Fluctuate(Hist1D&, std::vector<double>&)'
+
+      // ----------------------------------------------------------------------
+      //! Make one replica of the inputs
+      // ----------------------------------------------------------------------
+      std::vector<Hist1D> MakeReplica(const std::vector<Hist1D>& inputs, const std::size_t replica) const {
+
+        RandomStream stream(m_seed, replica);
+
+        std::vector<Hist1D> replicas(inputs);
+        std::vector<bool>   done(inputs.size(), false);
+        std::vector<double> uniforms;
+        for (std::size_t iin = 0; iin < inputs.size(); ++iin) {
+
+          if (done[iin]) continue;
+
+          // one block of uniforms per group
+          uniforms.resize( inputs[iin].GetNcells() );
+          stream.FillUniform(&uniforms[0], uniforms.size());
+          for (std::size_t jin = iin; jin < inputs.size(); ++jin) {
+            if (done[jin] || (GetGroup(jin) != GetGroup(iin))) continue;
+            Fluctuate(replicas[jin], uniforms);
+            done[jin] = true;
+          }
+        }
+        return replicas;
+
+      }  // end 'MakeReplica(std::vector<Hist1D>&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Check inputs against a chain
+      // ----------------------------------------------------------------------
+      void CheckInputs(const ReplicaChain& chain, const std::vector<Hist1D>& inputs) const {
+
+        if (inputs.size() != chain.GetNInputs()) {
+          std::cerr << "PANIC: replica chain takes " << chain.GetNInputs() << " inputs, got " << inputs.size() << "!" << std::endl;
+          Error::Raise("replica chain got the wrong number of inputs");
+          assert(inputs.size() == chain.GetNInputs());
+        }
+        for (std::size_t iin = 0; iin < inputs.size(); ++iin) {
+          for (std::size_t jin = iin + 1; jin < inputs.size(); ++jin) {
+            if ((GetGroup(iin) == GetGroup(jin)) && (inputs[iin].GetNcells() != inputs[jin].GetNcells())) {
+              std::cerr << "PANIC: correlated inputs " << inputs[iin].GetName() << " and " << inputs[jin].GetName()
+                        << " have different no. of bins!"
+                        << std::endl;
+              Error::Raise("correlated replica inputs have different no. of bins");
+              assert(inputs[iin].GetNcells() == inputs[jin].GetNcells());
+            }
+          }
+        }
+        return;
+
+      }  // end 'CheckInputs(ReplicaChain&, std::vector<Hist1D>&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t   GetNReplicas() const {return m_nReplicas;}
+      Mode          GetMode()      const {return m_mode;}
+      unsigned long GetSeed()      const {return m_seed;}
+      double        GetLevel()     const {return m_level;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetNReplicas(const std::size_t nreplicas)  {m_nReplicas = nreplicas;}
+      void SetMode(const Mode mode)                   {m_mode      = mode;}
+      void SetSeed(const unsigned long seed)          {m_seed      = seed;}
+      void SetLevel(const double level)               {m_level     = level;}
+      void SetGroups(const std::vector<int>& groups)  {m_groups    = groups;}
+
+      // ----------------------------------------------------------------------
+      //! Run a chain on replicas of its inputs
+      // ----------------------------------------------------------------------
+      /*! The chain is first evaluated once on the nominal
+       *  inputs (on the calling thread, which also fills any
+       *  caches the chain relies on, e.g. bin maps), then on
+       *  each replica in parallel.
+       *
+       *  \param chain    operations to run
+       *  \param inputs   nominal inputs of chain
+       *  \param nthreads maximum number of threads to use
+       */
+      ReplicaBand Run(
+        const ReplicaChain& chain,
+        const std::vector<Hist1D>& inputs,
+        const std::size_t nthreads = Parallel::DefaultNThreads()
+      ) const {
+
+        CheckInputs(chain, inputs);
+
+        ReplicaBand band;
+        band.nominal   = chain.Evaluate(inputs);
+        band.nreplicas = m_nReplicas;
+        band.median    = band.nominal;
+        band.low       = band.nominal;
+        band.high      = band.nominal;
+        band.median.SetName( band.nominal.GetName() + "_ReplicaMedian" );
+        band.low.SetName( band.nominal.GetName() + "_ReplicaLow" );
+        band.high.SetName( band.nominal.GetName() + "_ReplicaHigh" );
+        if (m_nReplicas == 0) return band;
+
+        // evaluate replicas
+        const std::size_t   ncells = band.nominal.GetNcells();
+        std::vector<double> values(m_nReplicas * ncells, 0.);
+        ReplicaTask task(this, &chain, &inputs, &values, ncells);
+        Parallel::For(task, m_nReplicas, nthreads);
+
+        // bin-to-bin covariance of replicas
+        band.covariance = Covariance::FromSamples(values, m_nReplicas, ncells);
+
+        // extract percentiles bin-by-bin
+        const double        tail = 0.5 * (1. - m_level);
+        std::vector<double> column(m_nReplicas, 0.);
+        for (std::size_t icell = 0; icell < ncells; ++icell) {
+          for (std::size_t irep = 0; irep < m_nReplicas; ++irep) {
+            column[irep] = values[(irep * ncells) + icell];
+          }
+
+          const std::size_t ilow  = (std::size_t) std::floor(tail * (m_nReplicas - 1));
+          const std::size_t imid  = (m_nReplicas - 1) / 2;
+          const std::size_t ihigh = (std::size_t) std::ceil((1. - tail) * (m_nReplicas - 1));
+          std::nth_element(column.begin(), column.begin() + imid, column.end());
+          band.median.SetBinContent(icell, column[imid]);
+          std::nth_element(column.begin(), column.begin() + ilow, column.begin() + imid);
+          band.low.SetBinContent(icell, column[ilow]);
+          std::nth_element(column.begin() + imid, column.begin() + ihigh, column.end());
+          band.high.SetBinContent(icell, column[ihigh]);
+
+          band.median.SetBinSumw2(icell, 0.);
+          band.low.SetBinSumw2(icell, 0.);
+          band.high.SetBinSumw2(icell, 0.);
+        }
+        return band;
+
+      }  // end 'Run(ReplicaChain&, std::vector<Hist1D>&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared engine
+      // ----------------------------------------------------------------------
+      static ReplicaEngine& Global() {
+
+        static ReplicaEngine engine;
+        return engine;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ReplicaEngine()
+        : m_nReplicas(1000)
+        , m_mode(Poisson)
+        , m_seed(12345)
+        , m_level(0.6827)
+      {};
+      ~ReplicaEngine() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      ReplicaEngine(const std::size_t nreplicas, const Mode mode = Poisson, const unsigned long seed = 12345)
+        : m_nReplicas(nreplicas)
+        , m_mode(mode)
+        , m_seed(seed)
+        , m_level(0.6827)
+      {};
+
+  };  // end ReplicaEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,648 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorSharedStore.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Node-local shared-memory store of input
+ *  histograms for multi-process runs.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORSHAREDSTORE_H
+#define PHCORRELATORSHAREDSTORE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// posix utilities
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TKey.h>
+#include <TList.h>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorPlotError.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Shared store
+  // ==========================================================================
+  /*! Holds the bin arrays of input histograms in a POSIX
+   *  shared-memory segment, so that several plotting
+   *  processes on one node share one copy of their inputs
+   *  instead of each reading and deserializing them.
+   *
+   *  One loader process adds histograms (`Add(...)`,
+   *  `AddFile(...)`) and publishes them to a named segment
+   *  (`Publish(...)`). The segment outlives the loader, so
+   *  workers can then map it read-only (`Attach(...)`) and
+   *  look histograms up by file and object name. Lookups
+   *  (`Find(...)`) hand back views pointing straight into
+   *  the segment; `Get(...)` makes a native histogram from
+   *  a view for routines which modify their inputs. The
+   *  segment is removed with `Unlink(...)` once all workers
+   *  are done.
+   *
+   *  Every input loaded through `Tools::LoadHist1D(...)`,
+   *  `Tools::LoadHist2D(...)`, or `Tools::FindHist2D(...)`
+   *  is looked up in the store first, so this covers the
+   *  plot makers, the engines (ComparisonTensor,
+   *  SpinRatioEngine, VariationEngine), and the wirings
+   *  loading through BaseOutput. Inputs which are still
+   *  read straight from file are the 2D inputs streamed
+   *  into a TileStore by `CorrectSpectra2D::PlotTiled(...)`
+   *  and the ntuples read when re-histogramming.
+   *
+   *  The segment holds a header, then a fixed-size index
+   *  entry per histogram, then all edges, contents, and
+   *  squared weights as doubles. Attaching checks that the
+   *  index and every array fit in the segment, and the
+   *  magic string is written last, so a truncated or
+   *  half-written segment is never used. Loader and workers
+   *  are expected to be the same build on the same node.
+   */
+  class SharedStore {
+
+    public:
+
+      // ======================================================================
+      //! Read-only view of a stored histogram
+      // ======================================================================
+      struct View {
+
+        // members
+        int           ndim;     ///!< no. of dimensions (1 or 2)
+        int           nx;       ///!< no. of x bins
+        int           ny;       ///!< no. of y bins (0 if 1D)
+        const char*   title;    ///!< histogram title
+        const char*   xtitle;   ///!< x-axis title
+        const char*   ytitle;   ///!< y-axis title
+        const char*   ztitle;   ///!< z-axis title
+        const double* xedges;   ///!< x bin edges (nx + 1)
+        const double* yedges;   ///!< y bin edges (ny + 1)
+        const double* content;  ///!< bin contents (incl. under/overflow)
+        const double* sumw2;    ///!< sum of squared weights (same)
+
+        // --------------------------------------------------------------------
+        //! Get no. of cells (incl. under/overflow)
+        // --------------------------------------------------------------------
+        std::size_t GetNcells() const {
+
+          return (ndim == 1) ? (nx + 2) : ((nx + 2) * (ny + 2));
+
+        }  // end 'GetNcells()'
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        View()
+          : ndim(1)
+          , nx(0)
+          , ny(0)
+          , title(NULL)
+          , xtitle(NULL)
+          , ytitle(NULL)
+          , ztitle(NULL)
+          , xedges(NULL)
+          , yedges(NULL)
+          , content(NULL)
+          , sumw2(NULL)
+        {};
+
+      };  // end View
+
+    private:
+
+      // sizes of fixed-length fields
+      enum Size {
+        KeySize   = 512,
+        TitleSize = 128
+      };
+
+      // ======================================================================
+      //! Segment header
+      // ======================================================================
+      struct Header {
+        char        magic[8];  ///!< identifies segment
+        std::size_t nentries;  ///!< no. of index entries
+        std::size_t nbytes;    ///!< total size of segment
+      };
+
+      // ======================================================================
+      //! Index entry of a stored histogram
+      // ======================================================================
+      /*! Offsets count doubles from the start of the data block. */
+      struct Entry {
+        char        key[KeySize];        ///!< file + object name
+        char        titles[4][TitleSize]; ///!< histogram, x, y, z titles
+        int         ndim;                ///!< no. of dimensions
+        int         nx;                  ///!< no. of x bins
+        int         ny;                  ///!< no. of y bins
+        int         pad;                 ///!< (unused)
+        std::size_t xedges;              ///!< offset of x edges
+        std::size_t yedges;              ///!< offset of y edges
+        std::size_t content;             ///!< offset of contents
+        std::size_t sumw2;               ///!< offset of squared weights
+      };
+
+      // data members
+      std::string                        m_segment;  ///!< name of published/attached segment
+      void*                              m_base;     ///!< start of mapped segment
+      std::size_t                        m_nbytes;   ///!< size of mapped segment
+      std::map<std::string, View>        m_views;    ///!< views of mapped histograms
+      std::vector<std::pair<std::string, Hist1D> > m_pending1D;  ///!< 1D histograms to publish
+      std::vector<std::pair<std::string, Hist2D> > m_pending2D;  ///!< 2D histograms to publish
+
+      // ----------------------------------------------------------------------
+      //! Not copyable (owns its mapping)
+      // ----------------------------------------------------------------------
+      SharedStore(const SharedStore&);
+      SharedStore& operator=(const SharedStore&);
+
+      // ----------------------------------------------------------------------
+      //! Magic string identifying a segment
+      // ----------------------------------------------------------------------
+      static const char* Magic() {return "PHECSHM";}
+
+      // ----------------------------------------------------------------------
+      //! Check that a key fits in an index entry
+      // ----------------------------------------------------------------------
+      static void CheckKey(const std::string& key) {
+
+        if (key.size() >= KeySize) {
+          std::cerr << "PANIC: key '" << key << "' is too long for shared store!" << std::endl;
+          Error::Raise("key too long for shared store");
+          assert(key.size() < KeySize);
+        }
+        return;
+
+      }  // end 'CheckKey(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Copy a string into a fixed-length field (truncating if need be)
+      // ----------------------------------------------------------------------
+      static void CopyString(char* field, const std::string& str, const std::size_t size) {
+
+        const std::size_t ncopy = std::min(str.size(), size - 1);
+        std::memcpy(field, str.data(), ncopy);
+        field[ncopy] = '\0';
+        return;
+
+      }  // end 'CopyString(char*, std::string&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Copy an array into the data block
+      // ----------------------------------------------------------------------
+      static std::size_t CopyArray(double* data, std::size_t& next, const double* array, const std::size_t size) {
+
+        const std::size_t offset = next;
+        if (size > 0) std::memcpy(data + offset, array, size * sizeof(double));
+        next += size;
+        return offset;
+
+      }  // end 'CopyArray(double*, std::size_t&, double*, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Check that a string field is null-terminated
+      // ----------------------------------------------------------------------
+      static bool IsTerminated(const char* field, const std::size_t size) {
+
+        return (std::memchr(field, '\0', size) != NULL);
+
+      }  // end 'IsTerminated(char*, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Check that an array lies inside the data block
+      // ----------------------------------------------------------------------
+      static bool IsInside(const std::size_t offset, const std::size_t size, const std::size_t ndata) {
+
+        return (offset <= ndata) && (size <= ndata - offset);
+
+      }  // end 'IsInside(std::size_t x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Check that an index entry is sane and points inside the data block
+      // ----------------------------------------------------------------------
+      static bool IsValid(const Entry& entry, const std::size_t ndata) {
+
+        // check strings
+        if (!IsTerminated(entry.key, KeySize)) return false;
+        for (std::size_t ittl = 0; ittl < 4; ++ittl) {
+          if (!IsTerminated(entry.titles[ittl], TitleSize)) return false;
+        }
+
+        // check dimensions (bounded by data block before computing sizes)
+        if ((entry.ndim != 1) && (entry.ndim != 2)) return false;
+        if ((entry.nx < 0) || ((std::size_t) entry.nx >= ndata)) return false;
+        if ((entry.ny < 0) || ((std::size_t) entry.ny >= ndata)) return false;
+
+        const std::size_t nx     = entry.nx + 2;
+        const std::size_t ny     = (entry.ndim == 2) ? entry.ny + 2 : 1;
+        const std::size_t ncells = nx * ny;
+        if (ncells / nx != ny) return false;
+
+        // and check arrays
+        if (!IsInside(entry.xedges, nx - 1, ndata))                       return false;
+        if ((entry.ndim == 2) && !IsInside(entry.yedges, ny - 1, ndata))  return false;
+        if (!IsInside(entry.content, ncells, ndata))                      return false;
+        if (!IsInside(entry.sumw2, ncells, ndata))                        return false;
+        return true;
+
+      }  // end 'IsValid(Entry&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Build views of all histograms in mapped segment
+      // ----------------------------------------------------------------------
+      /*! \return false if the segment isn't a store, or if
+       *          its header or any index entry doesn't fit in
+       *          the mapped size
+       */
+      bool Index() {
+
+        m_views.clear();
+
+        const Header* header = (const Header*) m_base;
+        if ((m_nbytes < sizeof(Header)) || (std::strncmp(header -> magic, Magic(), 8) != 0)) {
+          return false;
+        }
+        if (header -> nbytes != m_nbytes) {
+          std::cerr << "WARNING: shared segment " << m_segment << " has the wrong size!" << std::endl;
+          return false;
+        }
+        if (header -> nentries > (m_nbytes - sizeof(Header)) / sizeof(Entry)) {
+          std::cerr << "WARNING: index of shared segment " << m_segment << " doesn't fit!" << std::endl;
+          return false;
+        }
+
+        const Entry*      entries = (const Entry*) ((const char*) m_base + sizeof(Header));
+        const double*     data    = (const double*) (entries + header -> nentries);
+        const std::size_t ndata   = (m_nbytes - sizeof(Header) - (header -> nentries * sizeof(Entry))) / sizeof(double);
+
+        for (std::size_t ient = 0; ient < header -> nentries; ++ient) {
+          const Entry& entry = entries[ient];
+          if (!IsValid(entry, ndata)) {
+            std::cerr << "WARNING: entry " << ient << " of shared segment " << m_segment << " is corrupt!" << std::endl;
+            m_views.clear();
+            return false;
+          }
+
+          View view;
+          view.ndim    = entry.ndim;
+          view.nx      = entry.nx;
+          view.ny      = entry.ny;
+          view.title   = entry.titles[0];
+          view.xtitle  = entry.titles[1];
+          view.ytitle  = entry.titles[2];
+          view.ztitle  = entry.titles[3];
+          view.xedges  = data + entry.xedges;
+          view.yedges  = (entry.ndim == 2) ? (data + entry.yedges) : NULL;
+          view.content = data + entry.content;
+          view.sumw2   = data + entry.sumw2;
+          m_views[entry.key] = view;
+        }
+        return true;
+
+      }  // end 'Index()'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::string GetSegment()  const {return m_segment;}
+      std::size_t GetNBytes()   const {return m_nbytes;}
+      std::size_t GetNHists()   const {return m_views.size();}
+      std::size_t GetNPending() const {return m_pending1D.size() + m_pending2D.size();}
+      bool        IsMapped()    const {return (m_base != NULL);}
+
+      // ----------------------------------------------------------------------
+      //! Make a key from file and object names
+      // ----------------------------------------------------------------------
+      static std::string MakeKey(const std::string& file, const std::string& object) {
+
+        return file + ":" + object;
+
+      }  // end 'MakeKey(std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Add a 1D histogram to publish
+      // ----------------------------------------------------------------------
+      void Add(const std::string& key, const Hist1D& hist) {
+
+        CheckKey(key);
+        m_pending1D.push_back( std::make_pair(key, hist) );
+        return;
+
+      }  // end 'Add(std::string&, Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Add a 2D histogram to publish
+      // ----------------------------------------------------------------------
+      void Add(const std::string& key, const Hist2D& hist) {
+
+        CheckKey(key);
+        m_pending2D.push_back( std::make_pair(key, hist) );
+        return;
+
+      }  // end 'Add(std::string&, Hist2D&)'
+
+      // ----------------------------------------------------------------------
+      //! Add all 1D and 2D histograms in a file to publish
+      // ----------------------------------------------------------------------
+      /*! Only top-level objects are added; 3D histograms
+       *  and anything else are skipped.
+       *
+       *  \return no. of histograms added
+       */
+      std::size_t AddFile(const std::string& path) {
+
+        TFile* file = TFile::Open(path.data(), "read");
+        if (!file || file -> IsZombie()) {
+          std::cerr << "PANIC: couldn't open " << path << " to add to shared store!" << std::endl;
+          Error::Raise("couldn't open '" + path + "' to add to shared store");
+          assert(file && !file -> IsZombie());
+          return 0;
+        }
+
+        std::size_t nadd = 0;
+        TList*      keys = file -> GetListOfKeys();
+        for (int ikey = 0; keys && (ikey < keys -> GetSize()); ++ikey) {
+          TKey*    key  = (TKey*) keys -> At(ikey);
+          TObject* obj  = key -> ReadObj();
+          TH1*     hist = dynamic_cast<TH1*>(obj);
+          if (hist && (hist -> GetDimension() == 1)) {
+            Add(MakeKey(path, key -> GetName()), Hist1D(hist));
+            ++nadd;
+          } else if (hist && (hist -> GetDimension() == 2)) {
+            Add(MakeKey(path, key -> GetName()), Hist2D((TH2*) hist));
+            ++nadd;
+          }
+          delete obj;
+        }
+        file -> Close();
+        return nadd;
+
+      }  // end 'AddFile(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Publish added histograms to a new segment
+      // ----------------------------------------------------------------------
+      /*! Fails if a segment of the same name already exists
+       *  (e.g. left behind by an earlier run); remove it with
+       *  `Unlink(...)` first. The loader keeps the segment
+       *  mapped read-only afterwards.
+       *
+       *  \param segment name of segment (e.g. "/phec")
+       */
+      void Publish(const std::string& segment) {
+
+        Detach();
+
+        // size up data block
+        std::size_t ndoubles = 0;
+        for (std::size_t ihst = 0; ihst < m_pending1D.size(); ++ihst) {
+          const Hist1D& hist = m_pending1D[ihst].second;
+          ndoubles += hist.GetEdges().size() + (2 * hist.GetNcells());
+        }
+        for (std::size_t ihst = 0; ihst < m_pending2D.size(); ++ihst) {
+          const Hist2D& hist = m_pending2D[ihst].second;
+          ndoubles += hist.GetXEdges().size() + hist.GetYEdges().size() + (2 * hist.GetNcells());
+        }
+        const std::size_t nentries = GetNPending();
+        const std::size_t nbytes   = sizeof(Header) + (nentries * sizeof(Entry)) + (ndoubles * sizeof(double));
+
+        // create segment
+        const int fd = shm_open(segment.data(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+          std::cerr << "PANIC: couldn't create shared segment " << segment << " (does it already exist?)" << std::endl;
+          Error::Raise("couldn't create shared segment '" + segment + "'");
+          assert(fd >= 0);
+          return;
+        }
+        if (ftruncate(fd, nbytes) != 0) {
+          close(fd);
+          Unlink(segment);
+          std::cerr << "PANIC: couldn't size shared segment " << segment << "!" << std::endl;
+          Error::Raise("couldn't size shared segment '" + segment + "'");
+          assert(false);
+          return;
+        }
+
+        // and map it
+        void* base = mmap(NULL, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+          Unlink(segment);
+          std::cerr << "PANIC: couldn't map shared segment " << segment << "!" << std::endl;
+          Error::Raise("couldn't map shared segment '" + segment + "'");
+          assert(base != MAP_FAILED);
+          return;
+        }
+
+        // write header & index entries (magic is written last, so a
+        // half-written segment is never taken for a store)
+        Header* header = (Header*) base;
+        Entry*  entries = (Entry*) ((char*) base + sizeof(Header));
+        double* data    = (double*) (entries + nentries);
+        std::memset(base, 0, sizeof(Header) + (nentries * sizeof(Entry)));
+        header -> nentries = nentries;
+        header -> nbytes   = nbytes;
+
+        // and copy over histograms
+        std::size_t next = 0;
+        for (std::size_t ihst = 0; ihst < m_pending1D.size(); ++ihst) {
+          const Hist1D& hist  = m_pending1D[ihst].second;
+          Entry&        entry = entries[ihst];
+          CopyString(entry.key, m_pending1D[ihst].first, KeySize);
+          CopyString(entry.titles[0], hist.GetTitle(), TitleSize);
+          CopyString(entry.titles[1], hist.GetXTitle(), TitleSize);
+          CopyString(entry.titles[2], hist.GetYTitle(), TitleSize);
+          entry.ndim    = 1;
+          entry.nx      = hist.GetNbins();
+          entry.xedges  = CopyArray(data, next, &hist.GetEdges()[0], hist.GetEdges().size());
+          entry.content = CopyArray(data, next, hist.Content(), hist.GetNcells());
+          entry.sumw2   = CopyArray(data, next, hist.Sumw2(), hist.GetNcells());
+        }
+        for (std::size_t ihst = 0; ihst < m_pending2D.size(); ++ihst) {
+          const Hist2D& hist  = m_pending2D[ihst].second;
+          Entry&        entry = entries[m_pending1D.size() + ihst];
+          CopyString(entry.key, m_pending2D[ihst].first, KeySize);
+          CopyString(entry.titles[0], hist.GetTitle(), TitleSize);
+          CopyString(entry.titles[1], hist.GetXTitle(), TitleSize);
+          CopyString(entry.titles[2], hist.GetYTitle(), TitleSize);
+          CopyString(entry.titles[3], hist.GetZTitle(), TitleSize);
+          entry.ndim    = 2;
+          entry.nx      = hist.GetNbinsX();
+          entry.ny      = hist.GetNbinsY();
+          entry.xedges  = CopyArray(data, next, &hist.GetXEdges()[0], hist.GetXEdges().size());
+          entry.yedges  = CopyArray(data, next, &hist.GetYEdges()[0], hist.GetYEdges().size());
+          entry.content = CopyArray(data, next, hist.Content(), hist.GetNcells());
+          entry.sumw2   = CopyArray(data, next, hist.Sumw2(), hist.GetNcells());
+        }
+        std::memcpy(header -> magic, Magic(), 8);
+        mprotect(base, nbytes, PROT_READ);
+
+        m_segment = segment;
+        m_base    = base;
+        m_nbytes  = nbytes;
+        m_pending1D.clear();
+        m_pending2D.clear();
+        Index();
+        return;
+
+      }  // end 'Publish(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Map an existing segment read-only
+      // ----------------------------------------------------------------------
+      /*! \return false (and leaves store unmapped) if the
+       *          segment doesn't exist or isn't a store
+       */
+      bool Attach(const std::string& segment) {
+
+        Detach();
+
+        const int fd = shm_open(segment.data(), O_RDONLY, 0);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if ((fstat(fd, &info) != 0) || (info.st_size < (off_t) sizeof(Header))) {
+          close(fd);
+          return false;
+        }
+        void* base = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) return false;
+
+        m_segment = segment;
+        m_base    = base;
+        m_nbytes  = info.st_size;
+        if (!Index()) {
+          Detach();
+          return false;
+        }
+        return true;
+
+      }  // end 'Attach(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Unmap segment (it stays around for other processes)
+      // ----------------------------------------------------------------------
+      void Detach() {
+
+        if (m_base) munmap(m_base, m_nbytes);
+        m_base   = NULL;
+        m_nbytes = 0;
+        m_views.clear();
+        m_segment.clear();
+        return;
+
+      }  // end 'Detach()'
+
+      // ----------------------------------------------------------------------
+      //! Remove a segment from the node
+      // ----------------------------------------------------------------------
+      /*! Processes which still have it mapped keep their
+       *  mapping until they detach.
+       */
+      static bool Unlink(const std::string& segment) {
+
+        return (shm_unlink(segment.data()) == 0);
+
+      }  // end 'Unlink(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Find view of a stored histogram
+      // ----------------------------------------------------------------------
+      /*! \return view, or NULL if not stored */
+      const View* Find(const std::string& file, const std::string& object) const {
+
+        std::map<std::string, View>::const_iterator view = m_views.find( MakeKey(file, object) );
+        return (view == m_views.end()) ? NULL : &(view -> second);
+
+      }  // end 'Find(std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Get a native 1D histogram from store
+      // ----------------------------------------------------------------------
+      /*! Copies the bins out of the segment, for routines
+       *  which rebin or normalize their inputs in place.
+       *
+       *  \return false if not stored (or not 1D)
+       */
+      bool Get(const std::string& file, const std::string& object, Hist1D& hist) const {
+
+        const View* view = Find(file, object);
+        if (!view || (view -> ndim != 1)) return false;
+
+        hist = Hist1D(object, view -> title, std::vector<double>(view -> xedges, view -> xedges + view -> nx + 1));
+        hist.SetXTitle(view -> xtitle);
+        hist.SetYTitle(view -> ytitle);
+        std::copy(view -> content, view -> content + view -> GetNcells(), hist.Content());
+        std::copy(view -> sumw2, view -> sumw2 + view -> GetNcells(), hist.Sumw2());
+        return true;
+
+      }  // end 'Get(std::string& x 2, Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Get a native 2D histogram from store
+      // ----------------------------------------------------------------------
+      /*! \return false if not stored (or not 2D) */
+      bool Get(const std::string& file, const std::string& object, Hist2D& hist) const {
+
+        const View* view = Find(file, object);
+        if (!view || (view -> ndim != 2)) return false;
+
+        hist = Hist2D(
+          object,
+          view -> title,
+          std::vector<double>(view -> xedges, view -> xedges + view -> nx + 1),
+          std::vector<double>(view -> yedges, view -> yedges + view -> ny + 1)
+        );
+        hist.SetXTitle(view -> xtitle);
+        hist.SetYTitle(view -> ytitle);
+        hist.SetZTitle(view -> ztitle);
+        std::copy(view -> content, view -> content + view -> GetNcells(), hist.Content());
+        std::copy(view -> sumw2, view -> sumw2 + view -> GetNcells(), hist.Sumw2());
+        return true;
+
+      }  // end 'Get(std::string& x 2, Hist2D&)'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared store
+      // ----------------------------------------------------------------------
+      static SharedStore& Global() {
+
+        static SharedStore store;
+        return store;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      SharedStore() : m_base(NULL), m_nbytes(0) {};
+      ~SharedStore() {Detach();};
+
+  };  // end SharedStore
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
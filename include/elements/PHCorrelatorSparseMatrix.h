@@ -0,0 +1,277 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorSparseMatrix.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Compressed sparse row matrix with (optionally
+ *  multithreaded) matrix-vector products.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORSPARSEMATRIX_H
+#define PHCORRELATORSPARSEMATRIX_H
+
+// c++ utilities
+#include <cassert>
+#include <iostream>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Sparse matrix
+  // ==========================================================================
+  /*! Stores only the nonzero elements of a matrix in
+   *  compressed sparse row (CSR) form: the elements of row
+   *  i are values[rowStart[i]] ... values[rowStart[i + 1] - 1],
+   *  with columns given by `columns`. The transpose is kept
+   *  in the same form, so products with either the matrix
+   *  or its transpose stream through contiguous memory.
+   *
+   *  Products can be split over threads in blocks of rows
+   *  (rows are independent, so no locking is needed).
+   */
+  class SparseMatrix {
+
+    private:
+
+      // ======================================================================
+      //! One CSR block of elements
+      // ======================================================================
+      struct CSR {
+        std::vector<std::size_t> rowStart;  ///!< start of each row (+ end)
+        std::vector<std::size_t> columns;   ///!< column of each element
+        std::vector<double>      values;    ///!< value of each element
+      };
+
+      // data members
+      std::size_t m_nrows;  ///!< no. of rows
+      std::size_t m_ncols;  ///!< no. of columns
+      CSR         m_mat;    ///!< the matrix
+      CSR         m_trans;  ///!< its transpose
+
+      // ======================================================================
+      //! Multiplies a block of rows
+      // ======================================================================
+      class MultiplyTask : public Parallel::Task {
+
+        private:
+
+          const CSR*    m_csr;
+          const double* m_in;
+          double*       m_out;
+          std::size_t   m_nrows;
+          std::size_t   m_block;
+          bool          m_square;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            const std::size_t first = item * m_block;
+            const std::size_t last  = (first + m_block < m_nrows) ? first + m_block : m_nrows;
+            SparseMatrix::MultiplyRows(*m_csr, m_in, m_out, first, last, m_square);
+          }
+
+          MultiplyTask(
+            const CSR* csr,
+            const double* in,
+            double* out,
+            const std::size_t nrows,
+            const std::size_t block,
+            const bool square
+          ) : m_csr(csr), m_in(in), m_out(out), m_nrows(nrows), m_block(block), m_square(square) {};
+
+      };  // end MultiplyTask
+      friend class MultiplyTask;
+
+      // ----------------------------------------------------------------------
+      //! Multiply rows [first, last) of a CSR block
+      // ----------------------------------------------------------------------
+      /*! If `square` is true, elements are squared first
+       *  (e.g. for propagating variances).
+       */
+      static void MultiplyRows(
+        const CSR& csr,
+        const double* in,
+        double* out,
+        const std::size_t first,
+        const std::size_t last,
+        const bool square
+      ) {
+
+        for (std::size_t irow = first; irow < last; ++irow) {
+          double sum = 0.;
+          for (std::size_t iel = csr.rowStart[irow]; iel < csr.rowStart[irow + 1]; ++iel) {
+            const double value = square ? csr.values[iel] * csr.values[iel] : csr.values[iel];
+            sum += value * in[ csr.columns[iel] ];
+          }
+          out[irow] = sum;
+        }
+        return;
+
+      }  // end 'MultiplyRows(CSR&, double*, double*, std::size_t x 2, bool)'
+
+      // ----------------------------------------------------------------------
+      //! Multiply a CSR block with a vector
+      // ----------------------------------------------------------------------
+      static void Multiply(
+        const CSR& csr,
+        const std::size_t nrows,
+        const std::vector<double>& in,
+        std::vector<double>& out,
+        const std::size_t nthreads,
+        const bool square
+      ) {
+
+        out.assign(nrows, 0.);
+        if (nrows == 0) return;
+
+        // split into one block of rows per thread, but
+        // only start threads if each gets enough rows
+        // to be worth it (a few bins' worth is faster
+        // serially than starting the threads)
+        const std::size_t nminrows = 2048;
+        std::size_t       nblock   = nrows / nminrows;
+        if (nblock > nthreads) nblock = nthreads;
+        if (nblock < 1)        nblock = 1;
+        const std::size_t block  = (nrows + nblock - 1) / nblock;
+        if (nblock == 1) {
+          MultiplyRows(csr, &in[0], &out[0], 0, nrows, square);
+        } else {
+          MultiplyTask task(&csr, &in[0], &out[0], nrows, block, square);
+          Parallel::For(task, (nrows + block - 1) / block, nblock);
+        }
+        return;
+
+      }  // end 'Multiply(CSR&, std::size_t, std::vector<double>& x 2, std::size_t, bool)'
+
+      // ----------------------------------------------------------------------
+      //! Check that a vector has the expected length
+      // ----------------------------------------------------------------------
+      static void CheckLength(const std::vector<double>& vec, const std::size_t length) {
+
+        if (vec.size() != length) {
+          std::cerr << "PANIC: vector has the wrong length for sparse matrix product!\n"
+                    << "       expected " << length << ", got " << vec.size()
+                    << std::endl;
+          Error::Raise("vector has the wrong length for sparse matrix product");
+          assert(vec.size() == length);
+        }
+        return;
+
+      }  // end 'CheckLength(std::vector<double>&, std::size_t)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetNRows()     const {return m_nrows;}
+      std::size_t GetNColumns()  const {return m_ncols;}
+      std::size_t GetNNonZero()  const {return m_mat.values.size();}
+
+      // ----------------------------------------------------------------------
+      //! Build from a dense, row-major array
+      // ----------------------------------------------------------------------
+      /*! Elements that are exactly zero aren't stored. */
+      void Build(const std::vector<double>& dense, const std::size_t nrows, const std::size_t ncols) {
+
+        m_nrows = nrows;
+        m_ncols = ncols;
+        CheckLength(dense, nrows * ncols);
+
+        // fill matrix row-by-row
+        m_mat = CSR();
+        m_mat.rowStart.reserve(nrows + 1);
+        m_mat.rowStart.push_back(0);
+        std::vector<std::size_t> colCount(ncols, 0);
+        for (std::size_t irow = 0; irow < nrows; ++irow) {
+          for (std::size_t icol = 0; icol < ncols; ++icol) {
+            const double value = dense[(irow * ncols) + icol];
+            if (value == 0.) continue;
+            m_mat.columns.push_back(icol);
+            m_mat.values.push_back(value);
+            ++colCount[icol];
+          }
+          m_mat.rowStart.push_back( m_mat.values.size() );
+        }
+
+        // and transpose by counting sort on columns
+        m_trans = CSR();
+        m_trans.rowStart.assign(ncols + 1, 0);
+        for (std::size_t icol = 0; icol < ncols; ++icol) {
+          m_trans.rowStart[icol + 1] = m_trans.rowStart[icol] + colCount[icol];
+        }
+        m_trans.columns.resize( m_mat.values.size() );
+        m_trans.values.resize( m_mat.values.size() );
+
+        std::vector<std::size_t> next(m_trans.rowStart.begin(), m_trans.rowStart.end() - 1);
+        for (std::size_t irow = 0; irow < nrows; ++irow) {
+          for (std::size_t iel = m_mat.rowStart[irow]; iel < m_mat.rowStart[irow + 1]; ++iel) {
+            const std::size_t slot = next[ m_mat.columns[iel] ]++;
+            m_trans.columns[slot] = irow;
+            m_trans.values[slot]  = m_mat.values[iel];
+          }
+        }
+        return;
+
+      }  // end 'Build(std::vector<double>&, std::size_t x 2)'
+
+      // ----------------------------------------------------------------------
+      //! out = M in
+      // ----------------------------------------------------------------------
+      void Multiply(
+        const std::vector<double>& in,
+        std::vector<double>& out,
+        const std::size_t nthreads = 1,
+        const bool square = false
+      ) const {
+
+        CheckLength(in, m_ncols);
+        Multiply(m_mat, m_nrows, in, out, nthreads, square);
+        return;
+
+      }  // end 'Multiply(std::vector<double>& x 2, std::size_t, bool)'
+
+      // ----------------------------------------------------------------------
+      //! out = M^T in
+      // ----------------------------------------------------------------------
+      void MultiplyTransposed(
+        const std::vector<double>& in,
+        std::vector<double>& out,
+        const std::size_t nthreads = 1,
+        const bool square = false
+      ) const {
+
+        CheckLength(in, m_nrows);
+        Multiply(m_trans, m_ncols, in, out, nthreads, square);
+        return;
+
+      }  // end 'MultiplyTransposed(std::vector<double>& x 2, std::size_t, bool)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      SparseMatrix()  : m_nrows(0), m_ncols(0) {};
+      ~SparseMatrix() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a dense, row-major array
+      // ----------------------------------------------------------------------
+      SparseMatrix(const std::vector<double>& dense, const std::size_t nrows, const std::size_t ncols) {
+        Build(dense, nrows, ncols);
+      }  // end ctor(std::vector<double>&, std::size_t x 2)
+
+  };  // end SparseMatrix
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
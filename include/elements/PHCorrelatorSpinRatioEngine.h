@@ -0,0 +1,243 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorSpinRatioEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Batched calculation of ratios between
+ *  spin-sorted spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORSPINRATIOENGINE_H
+#define PHCORRELATORSPINRATIOENGINE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+// root libraries
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorAdaptiveRebin.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorLoadTools.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotInput.h"
+#include "PHCorrelatorPlotOpts.h"
+#include "PHCorrelatorPlotTools.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Spin ratio engine
+  // ==========================================================================
+  /*! Holds the spectra of one (index, level) for each spin
+   *  state, loading (and rebinning/normalizing) each state
+   *  at most once, and computes every requested ratio of
+   *  two states in one pass over the loaded spectra.
+   *
+   *  Ratios are taken with `Tools::DivideHist1D(...)`, so
+   *  states with the same binning go through the vectorized
+   *  kernels in HistMath. Adaptive rebinning (see
+   *  AdaptiveRebin) is deferred until ratios are computed,
+   *  so that every state gets the same binning; states are
+   *  normalized again after merging.
+   */
+  class SpinRatioEngine {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Convenient types
+      // ----------------------------------------------------------------------
+      typedef std::pair<int, int>     Pair;    ///!< (numerator, denominator) spins
+      typedef std::vector<Pair>       Pairs;
+      typedef std::map<int, Hist1D>   States;
+
+    private:
+
+      // data members
+      States                  m_states;   ///!< spectrum of each loaded spin state
+      std::map<int, PlotOpts> m_options;  ///!< normalization options of each loaded state
+      Pairs                   m_pairs;    ///!< pairs ratios were computed for
+      std::vector<Hist1D>     m_ratios;   ///!< ratio for each pair
+      std::size_t             m_nLoads;   ///!< no. of spectra loaded from file
+      double                  m_target;   ///!< tightest adaptive target of loaded states (0 if none)
+      bool                    m_merged;   ///!< true if states were adaptively rebinned
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetNStates() const {return m_states.size();}
+      std::size_t GetNRatios() const {return m_ratios.size();}
+      std::size_t GetNLoads()  const {return m_nLoads;}
+      Pairs       GetPairs()   const {return m_pairs;}
+
+      // ----------------------------------------------------------------------
+      //! Check if a spin state has been loaded
+      // ----------------------------------------------------------------------
+      bool HasState(const int spin) const {
+
+        return (m_states.find(spin) != m_states.end());
+
+      }  // end 'HasState(int)'
+
+      // ----------------------------------------------------------------------
+      //! Load a spin state (if not already loaded)
+      // ----------------------------------------------------------------------
+      /*! Opens the input, rebins it if need be, and normalizes
+       *  it according to `options`. States that are already
+       *  loaded are left alone. Adaptive rebinning is left to
+       *  `Compute(...)`.
+       *
+       *  \param spin    spin state being loaded
+       *  \param input   where to find the spectrum
+       *  \param options normalization options to apply
+       */
+      void Load(const int spin, const PlotInput& input, const PlotOpts& options) {
+
+        if (HasState(spin)) return;
+
+        // grab spectrum from shared memory or file
+        Hist1D native = Tools::LoadHist1D(
+          input.file,
+          input.object,
+          1,
+          "spin " + Tools::StringifyIndex(spin)
+        );
+        native.SetName(input.rename);
+
+        // rebin if need be (or note adaptive target)
+        if (input.rebin.IsAdaptive()) {
+          const double target = input.rebin.GetTarget();
+          m_target = (m_target > 0.) ? std::min(m_target, target) : target;
+        } else if (input.rebin.GetRebin()) {
+          input.rebin.Apply(native);
+        }
+
+        // normalize if need be
+        if (options.do_norm) {
+          Tools::NormalizeByIntegral(
+            native,
+            options.norm_to,
+            options.norm_range.GetX().first,
+            options.norm_range.GetX().second
+          );
+        }
+
+        m_states[spin]  = native;
+        m_options[spin] = options;
+        ++m_nLoads;
+        return;
+
+      }  // end 'Load(int, PlotInput&, PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Get spectrum of a loaded spin state
+      // ----------------------------------------------------------------------
+      const Hist1D& GetState(const int spin) const {
+
+        States::const_iterator state = m_states.find(spin);
+        if (state == m_states.end()) {
+          std::cerr << "PANIC: spin state " << spin << " hasn't been loaded!" << std::endl;
+          Error::Raise("spin state " + Tools::StringifyIndex(spin) + " hasn't been loaded");
+          assert(state != m_states.end());
+        }
+        return state -> second;
+
+      }  // end 'GetState(int)'
+
+      // ----------------------------------------------------------------------
+      //! Compute ratios for a list of spin pairs
+      // ----------------------------------------------------------------------
+      /*! All states used by `pairs` must have been loaded.
+       *  Replaces any previously computed ratios. If any state
+       *  asked for adaptive rebinning, all loaded states are
+       *  first rebinned together to the tightest target.
+       */
+      void Compute(const Pairs& pairs) {
+
+        if ((m_target > 0.) && !m_merged) {
+          std::vector<Hist1D*> states;
+          for (States::iterator state = m_states.begin(); state != m_states.end(); ++state) {
+            states.push_back( &(state -> second) );
+          }
+          AdaptiveRebin::Global().Apply(states, m_target);
+          m_merged = true;
+
+          // merging sums bins, so normalize again
+          for (States::iterator state = m_states.begin(); state != m_states.end(); ++state) {
+            const PlotOpts& options = m_options[state -> first];
+            if (!options.do_norm) continue;
+            Tools::NormalizeByIntegral(
+              state -> second,
+              options.norm_to,
+              options.norm_range.GetX().first,
+              options.norm_range.GetX().second
+            );
+          }
+        }
+
+        m_pairs = pairs;
+        m_ratios.clear();
+        m_ratios.reserve(pairs.size());
+        for (std::size_t ipair = 0; ipair < pairs.size(); ++ipair) {
+          const Hist1D& num = GetState(pairs[ipair].first);
+          const Hist1D& den = GetState(pairs[ipair].second);
+          m_ratios.push_back( Tools::DivideHist1D(num, den) );
+          m_ratios.back().SetName( den.GetName() + "_Ratio" );
+        }
+        return;
+
+      }  // end 'Compute(Pairs&)'
+
+      // ----------------------------------------------------------------------
+      //! Get ratio computed for a pair
+      // ----------------------------------------------------------------------
+      const Hist1D& GetRatio(const std::size_t ipair) const {
+
+        if (ipair >= m_ratios.size()) {
+          std::cerr << "PANIC: no ratio computed for pair " << ipair << "!" << std::endl;
+          Error::Raise("no ratio computed for pair " + Tools::StringifyIndex(ipair));
+          assert(ipair < m_ratios.size());
+        }
+        return m_ratios[ipair];
+
+      }  // end 'GetRatio(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Drop all loaded states and ratios
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_states.clear();
+        m_options.clear();
+        m_pairs.clear();
+        m_ratios.clear();
+        m_target = 0.;
+        m_merged = false;
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      SpinRatioEngine() : m_nLoads(0), m_target(0.), m_merged(false) {};
+      ~SpinRatioEngine() {};
+
+  };  // end SpinRatioEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
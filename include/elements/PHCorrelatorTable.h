@@ -0,0 +1,261 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorTable.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Simple columnar table for writing numeric
+ *  results out as CSV or a TTree.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORTABLE_H
+#define PHCORRELATORTABLE_H
+
+// c++ utilities
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TTree.h>
+// plotting utilities
+#include "PHCorrelatorPlotError.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Columnar table
+  // ==========================================================================
+  /*! A table of named numeric columns plus one label
+   *  column (e.g. the name of the histogram a row came
+   *  from) and, optionally, more named string columns
+   *  (e.g. what variable a row is for). Columns are stored
+   *  contiguously, so they can be handed straight to
+   *  vectorized code or written out as branches of a TTree.
+   */
+  class Table {
+
+    private:
+
+      // data members
+      std::vector<std::string>               m_names;     ///!< name of each numeric column
+      std::vector<std::vector<double> >      m_columns;   ///!< numeric columns
+      std::vector<std::string>               m_labels;    ///!< label column
+      std::vector<std::string>               m_tagNames;  ///!< name of each string column
+      std::vector<std::vector<std::string> > m_tags;      ///!< string columns
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t                     GetNRows()                       const {return m_labels.size();}
+      std::size_t                     GetNColumns()                    const {return m_names.size();}
+      const std::vector<std::string>& GetNames()                       const {return m_names;}
+      const std::vector<std::string>& GetLabels()                      const {return m_labels;}
+      const std::vector<std::string>& GetTagNames()                    const {return m_tagNames;}
+      const std::vector<double>&      GetColumn(const std::size_t col) const {return m_columns.at(col);}
+      const std::vector<std::string>& GetTags(const std::size_t col)   const {return m_tags.at(col);}
+
+      // ----------------------------------------------------------------------
+      //! Find a column by name
+      // ----------------------------------------------------------------------
+      /*! Returns the no. of columns if there's no such column. */
+      std::size_t FindColumn(const std::string& name) const {
+
+        for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+          if (m_names[icol] == name) return icol;
+        }
+        return m_names.size();
+
+      }  // end 'FindColumn(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Add a row
+      // ----------------------------------------------------------------------
+      /*! Any string columns are left empty. */
+      void AddRow(const std::string& label, const std::vector<double>& values) {
+
+        AddRow(label, values, std::vector<std::string>(m_tagNames.size(), ""));
+        return;
+
+      }  // end 'AddRow(std::string&, std::vector<double>&)'
+
+      // ----------------------------------------------------------------------
+      //! Add a row with values of string columns
+      // ----------------------------------------------------------------------
+      void AddRow(
+        const std::string& label,
+        const std::vector<double>& values,
+        const std::vector<std::string>& tags
+      ) {
+
+        if ((values.size() != m_names.size()) || (tags.size() != m_tagNames.size())) {
+          std::cerr << "PANIC: row has the wrong number of values!\n"
+                    << "       columns = " << m_names.size() << " (" << m_tagNames.size() << " strings)\n"
+                    << "       values  = " << values.size() << " (" << tags.size() << " strings)"
+                    << std::endl;
+          Error::Raise("row has the wrong number of values");
+          assert(values.size() == m_names.size());
+          assert(tags.size() == m_tagNames.size());
+        }
+
+        m_labels.push_back(label);
+        for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+          m_tags[itag].push_back( tags[itag] );
+        }
+        for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+          m_columns[icol].push_back( values[icol] );
+        }
+        return;
+
+      }  // end 'AddRow(std::string&, std::vector<double>&, std::vector<std::string>&)'
+
+      // ----------------------------------------------------------------------
+      //! Append rows of another table with the same columns
+      // ----------------------------------------------------------------------
+      void Append(const Table& other) {
+
+        if ((other.GetNames() != m_names) || (other.GetTagNames() != m_tagNames)) {
+          std::cerr << "PANIC: tried to append a table with different columns!" << std::endl;
+          Error::Raise("tried to append a table with different columns");
+          assert(other.GetNames() == m_names);
+          assert(other.GetTagNames() == m_tagNames);
+        }
+
+        m_labels.insert(m_labels.end(), other.m_labels.begin(), other.m_labels.end());
+        for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+          m_tags[itag].insert(m_tags[itag].end(), other.m_tags[itag].begin(), other.m_tags[itag].end());
+        }
+        for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+          m_columns[icol].insert(m_columns[icol].end(), other.m_columns[icol].begin(), other.m_columns[icol].end());
+        }
+        return;
+
+      }  // end 'Append(Table&)'
+
+      // ----------------------------------------------------------------------
+      //! Remove all rows (keeping columns)
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_labels.clear();
+        for (std::size_t itag = 0; itag < m_tags.size(); ++itag) {
+          m_tags[itag].clear();
+        }
+        for (std::size_t icol = 0; icol < m_columns.size(); ++icol) {
+          m_columns[icol].clear();
+        }
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Write table to a CSV file
+      // ----------------------------------------------------------------------
+      void WriteCSV(const std::string& path) const {
+
+        std::ofstream out(path.data());
+        if (!out.is_open()) {
+          std::cerr << "WARNING: couldn't open " << path << " to write table!" << std::endl;
+          return;
+        }
+
+        out << "label";
+        for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+          out << "," << m_tagNames[itag];
+        }
+        for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+          out << "," << m_names[icol];
+        }
+        out << "\n" << std::setprecision(10);
+
+        for (std::size_t irow = 0; irow < m_labels.size(); ++irow) {
+          out << m_labels[irow];
+          for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+            out << "," << m_tags[itag][irow];
+          }
+          for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+            out << "," << m_columns[icol][irow];
+          }
+          out << "\n";
+        }
+        out.close();
+        return;
+
+      }  // end 'WriteCSV(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Convert table into a TTree
+      // ----------------------------------------------------------------------
+      /*! Each column becomes a double branch and the labels
+       *  (and any string columns) string branches. The tree is created in the current
+       *  directory, so cd into the output file first.
+       */
+      TTree* MakeTree(const std::string& name, const std::string& title = "") const {
+
+        TTree* tree = new TTree(name.data(), title.data());
+
+        std::string              label;
+        std::vector<std::string> tags(m_tagNames.size(), "");
+        std::vector<double>      values(m_names.size(), 0.);
+        tree -> Branch("label", &label);
+        for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+          tree -> Branch(m_tagNames[itag].data(), &tags[itag]);
+        }
+        for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+          tree -> Branch(m_names[icol].data(), &values[icol], (m_names[icol] + "/D").data());
+        }
+
+        for (std::size_t irow = 0; irow < m_labels.size(); ++irow) {
+          label = m_labels[irow];
+          for (std::size_t itag = 0; itag < m_tagNames.size(); ++itag) {
+            tags[itag] = m_tags[itag][irow];
+          }
+          for (std::size_t icol = 0; icol < m_names.size(); ++icol) {
+            values[icol] = m_columns[icol][irow];
+          }
+          tree -> Fill();
+        }
+
+        // branches point at locals, so detach them
+        tree -> ResetBranchAddresses();
+        return tree;
+
+      }  // end 'MakeTree(std::string&, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Table()  {};
+      ~Table() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting column names
+      // ----------------------------------------------------------------------
+      explicit Table(const std::vector<std::string>& names)
+        : m_names(names)
+        , m_columns(names.size())
+      {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting names of numeric and string columns
+      // ----------------------------------------------------------------------
+      Table(const std::vector<std::string>& names, const std::vector<std::string>& tagNames)
+        : m_names(names)
+        , m_columns(names.size())
+        , m_tagNames(tagNames)
+        , m_tags(tagNames.size())
+      {};
+
+  };  // end Table
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
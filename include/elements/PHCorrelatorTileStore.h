@@ -0,0 +1,485 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorTileStore.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Disk-backed store to process large 2D/3D
+ *  histograms tile by tile.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORTILESTORE_H
+#define PHCORRELATORTILESTORE_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHistMath.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotTypes.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Tile store
+  // ==========================================================================
+  /*! Keeps the contents and squared errors of 2D/3D
+   *  histograms in a temporary file rather than in memory,
+   *  and processes them in tiles of consecutive rows (runs
+   *  of x cells at fixed y, z), so that memory use is set
+   *  by the tile size rather than the number of bins.
+   *
+   *  Histograms are spilled to the store straight from
+   *  ROOT (`Spill(...)`), one at a time, combined tile by
+   *  tile (`Integral(...)`, `Scale(...)`, `Divide(...)`),
+   *  and only turned back into a ROOT histogram one at a
+   *  time to be written out (`MakeTH(...)`).
+   *
+   *  Cells are numbered like ROOT's global bins, so a tile
+   *  of rows is one contiguous block of the file.
+   */
+  class TileStore {
+
+    private:
+
+      // ======================================================================
+      //! A stored histogram
+      // ======================================================================
+      struct Slot {
+
+        // members
+        std::string    name;       ///!< histogram name
+        std::string    title;      ///!< histogram title
+        std::string    titles[3];  ///!< axis titles
+        Binning::Edges edges[3];   ///!< bin edges of each axis
+        int            ndim;       ///!< no. of dimensions (2 or 3)
+        long           offset;     ///!< where contents start in file
+        std::size_t    ncells;     ///!< no. of cells (incl. under/overflow)
+        std::size_t    nrow;       ///!< no. of cells per row (nx + 2)
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Slot() : ndim(2), offset(0), ncells(0), nrow(1) {};
+
+      };  // end Slot
+
+      // data members
+      std::FILE*        m_file;       ///!< backing file
+      long              m_size;       ///!< bytes used in file
+      std::size_t       m_tileCells;  ///!< target no. of cells per tile
+      std::vector<Slot> m_slots;      ///!< stored histograms
+
+      // ----------------------------------------------------------------------
+      //! Not copyable (owns its backing file)
+      // ----------------------------------------------------------------------
+      TileStore(const TileStore&);
+      TileStore& operator=(const TileStore&);
+
+      // ----------------------------------------------------------------------
+      //! Read or write a block of cells of a slot
+      // ----------------------------------------------------------------------
+      /*! Contents are stored first, then squared errors. */
+      void Access(
+        const std::size_t islot,
+        const std::size_t first,
+        const std::size_t ncells,
+        double* content,
+        double* sumw2,
+        const bool write
+      ) const {
+
+        const Slot& slot  = m_slots[islot];
+        const long  bytes = sizeof(double);
+
+        bool ok = true;
+        for (int iarr = 0; iarr < 2; ++iarr) {
+          double*    array = (iarr == 0) ? content : sumw2;
+          const long where = slot.offset + ((iarr * (long) slot.ncells) + (long) first) * bytes;
+          ok &= (std::fseek(m_file, where, SEEK_SET) == 0);
+          const std::size_t ndone = write ? std::fwrite(array, bytes, ncells, m_file)
+                                          : std::fread(array, bytes, ncells, m_file);
+          ok &= (ndone == ncells);
+        }
+        if (!ok) {
+          std::cerr << "PANIC: couldn't " << (write ? "write" : "read")
+                    << " tile of " << slot.name << " in tile store!"
+                    << std::endl;
+          Error::Raise("couldn't access tile store");
+          assert(ok);
+        }
+        return;
+
+      }  // end 'Access(std::size_t x 3, double* x 2, bool)'
+
+      // ----------------------------------------------------------------------
+      //! Reserve space for a new slot
+      // ----------------------------------------------------------------------
+      std::size_t Allocate(Slot slot) {
+
+        if (!m_file) m_file = std::tmpfile();
+        if (!m_file) {
+          std::cerr << "PANIC: couldn't create backing file for tile store!" << std::endl;
+          Error::Raise("couldn't create backing file for tile store");
+          assert(m_file);
+        }
+
+        slot.offset = m_size;
+        m_size     += 2 * (long) slot.ncells * (long) sizeof(double);
+        m_slots.push_back(slot);
+        return m_slots.size() - 1;
+
+      }  // end 'Allocate(Slot)'
+
+      // ----------------------------------------------------------------------
+      //! Throw error if two slots don't have the same shape
+      // ----------------------------------------------------------------------
+      void CheckShapes(const std::size_t ia, const std::size_t ib) const {
+
+        const bool same = (m_slots[ia].ncells == m_slots[ib].ncells) &&
+                          (m_slots[ia].nrow == m_slots[ib].nrow);
+        if (!same) {
+          std::cerr << "PANIC: can't combine " << m_slots[ia].name << " and " << m_slots[ib].name
+                    << " in tile store, binnings differ!"
+                    << std::endl;
+          Error::Raise("can't combine stored histograms with different binnings");
+          assert(same);
+        }
+        return;
+
+      }  // end 'CheckShapes(std::size_t, std::size_t)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Default no. of cells per tile
+      // ----------------------------------------------------------------------
+      /*! Routines which support tiling (e.g. CorrectSpectra2D)
+       *  use it when this is nonzero, otherwise they keep
+       *  everything in memory.
+       */
+      static std::size_t& DefaultTileCells() {
+
+        static std::size_t ncells = 0;
+        return ncells;
+
+      }  // end 'DefaultTileCells()'
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t GetTileCells() const {return m_tileCells;}
+      std::size_t GetNSlots()    const {return m_slots.size();}
+      long        GetNBytes()    const {return m_size;}
+
+      // ----------------------------------------------------------------------
+      //! Get name, title of a slot
+      // ----------------------------------------------------------------------
+      std::string GetName(const std::size_t islot)  const {return m_slots[islot].name;}
+      std::string GetTitle(const std::size_t islot) const {return m_slots[islot].title;}
+
+      // ----------------------------------------------------------------------
+      //! No. of rows per tile of a slot, and no. of tiles
+      // ----------------------------------------------------------------------
+      std::size_t GetTileRows(const std::size_t islot) const {
+
+        return std::max(m_tileCells / m_slots[islot].nrow, (std::size_t) 1);
+
+      }  // end 'GetTileRows(std::size_t)'
+
+      std::size_t GetNTiles(const std::size_t islot) const {
+
+        const std::size_t nrows = m_slots[islot].ncells / m_slots[islot].nrow;
+        const std::size_t ntile = GetTileRows(islot);
+        return (nrows + ntile - 1) / ntile;
+
+      }  // end 'GetNTiles(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Read/write one tile of a slot
+      // ----------------------------------------------------------------------
+      /*! \param islot   which slot
+       *  \param itile   which tile
+       *  \param content contents of tile (resized as needed)
+       *  \param sumw2   squared errors of tile (resized as needed)
+       *  \return global bin of first cell of tile
+       */
+      std::size_t ReadTile(
+        const std::size_t islot,
+        const std::size_t itile,
+        std::vector<double>& content,
+        std::vector<double>& sumw2
+      ) const {
+
+        const std::size_t first  = itile * GetTileRows(islot) * m_slots[islot].nrow;
+        const std::size_t ncells = std::min(GetTileRows(islot) * m_slots[islot].nrow, m_slots[islot].ncells - first);
+        content.resize(ncells);
+        sumw2.resize(ncells);
+        Access(islot, first, ncells, &content[0], &sumw2[0], false);
+        return first;
+
+      }  // end 'ReadTile(std::size_t x 2, std::vector<double>& x 2)'
+
+      void WriteTile(
+        const std::size_t islot,
+        const std::size_t itile,
+        std::vector<double>& content,
+        std::vector<double>& sumw2
+      ) {
+
+        const std::size_t first = itile * GetTileRows(islot) * m_slots[islot].nrow;
+        Access(islot, first, content.size(), &content[0], &sumw2[0], true);
+        return;
+
+      }  // end 'WriteTile(std::size_t x 2, std::vector<double>& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Copy a ROOT 2D/3D histogram into the store
+      // ----------------------------------------------------------------------
+      /*! \param hist  histogram to store (can be deleted after)
+       *  \param name  name to give stored histogram
+       *  \param title title to give stored histogram
+       *  \return index of slot
+       */
+      std::size_t Spill(const TH1* hist, const std::string& name, const std::string& title) {
+
+        Slot slot;
+        slot.name   = name;
+        slot.title  = title;
+        slot.ndim   = (hist -> GetDimension() == 3) ? 3 : 2;
+        slot.ncells = hist -> GetNcells();
+        slot.nrow   = hist -> GetNbinsX() + 2;
+
+        const TAxis* axes[3] = {hist -> GetXaxis(), hist -> GetYaxis(), hist -> GetZaxis()};
+        for (int idim = 0; idim < slot.ndim; ++idim) {
+          slot.titles[idim] = axes[idim] -> GetTitle();
+          const int nbins = axes[idim] -> GetNbins();
+          for (int ibin = 1; ibin <= nbins + 1; ++ibin) {
+            slot.edges[idim].push_back( axes[idim] -> GetBinLowEdge(ibin) );
+          }
+        }
+
+        // copy cells over tile by tile
+        const std::size_t   islot = Allocate(slot);
+        std::vector<double> content;
+        std::vector<double> sumw2;
+        for (std::size_t itile = 0; itile < GetNTiles(islot); ++itile) {
+          const std::size_t first  = itile * GetTileRows(islot) * slot.nrow;
+          const std::size_t ncells = std::min(GetTileRows(islot) * slot.nrow, slot.ncells - first);
+          content.resize(ncells);
+          sumw2.resize(ncells);
+          for (std::size_t icell = 0; icell < ncells; ++icell) {
+            const double err = hist -> GetBinError(first + icell);
+            content[icell] = hist -> GetBinContent(first + icell);
+            sumw2[icell]   = err * err;
+          }
+          WriteTile(islot, itile, content, sumw2);
+        }
+        return islot;
+
+      }  // end 'Spill(TH1*, std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Create an empty slot shaped like another
+      // ----------------------------------------------------------------------
+      std::size_t Create(const std::size_t like, const std::string& name, const std::string& title) {
+
+        Slot slot  = m_slots[like];
+        slot.name  = name;
+        slot.title = title;
+        return Allocate(slot);
+
+      }  // end 'Create(std::size_t, std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Integrate contents over a range in x and y
+      // ----------------------------------------------------------------------
+      /*! Bins are found like `Tools::NormalizeByIntegral(...)`;
+       *  3D histograms are integrated over all of z.
+       */
+      double Integral(
+        const std::size_t islot,
+        const double startx,
+        const double stopx,
+        const double starty,
+        const double stopy
+      ) const {
+
+        const Slot&    slot   = m_slots[islot];
+        const Binning* xbins  = Binning::Intern(slot.edges[0]);
+        const Binning* ybins  = Binning::Intern(slot.edges[1]);
+        const int      nycel  = ybins -> GetNbins() + 2;
+        const int      firstx = xbins -> FindBin(startx);
+        const int      lastx  = xbins -> FindBin(stopx);
+        const int      firsty = ybins -> FindBin(starty);
+        const int      lasty  = ybins -> FindBin(stopy);
+
+        double              integral = 0.;
+        std::vector<double> content;
+        std::vector<double> sumw2;
+        for (std::size_t itile = 0; itile < GetNTiles(islot); ++itile) {
+          const std::size_t first = ReadTile(islot, itile, content, sumw2);
+          for (std::size_t irow = 0; irow < content.size() / slot.nrow; ++irow) {
+            const int iy = (int) (((first / slot.nrow) + irow) % nycel);
+            if ((iy < firsty) || (iy > lasty)) continue;
+
+            const double* row = &content[irow * slot.nrow];
+            for (int ix = std::max(firstx, 0); ix <= std::min(lastx, (int) slot.nrow - 1); ++ix) {
+              integral += row[ix];
+            }
+          }
+        }
+        return integral;
+
+      }  // end 'Integral(std::size_t, double x 4)'
+
+      // ----------------------------------------------------------------------
+      //! Scale contents (and errors) of a slot
+      // ----------------------------------------------------------------------
+      void Scale(const std::size_t islot, const double scale) {
+
+        std::vector<double> content;
+        std::vector<double> sumw2;
+        for (std::size_t itile = 0; itile < GetNTiles(islot); ++itile) {
+          ReadTile(islot, itile, content, sumw2);
+          HistMath::Scale(&content[0], &sumw2[0], content.size(), scale);
+          WriteTile(islot, itile, content, sumw2);
+        }
+        return;
+
+      }  // end 'Scale(std::size_t, double)'
+
+      // ----------------------------------------------------------------------
+      //! Normalize a slot by its integral over a range
+      // ----------------------------------------------------------------------
+      void Normalize(
+        const std::size_t islot,
+        const double norm,
+        const double startx,
+        const double stopx,
+        const double starty,
+        const double stopy
+      ) {
+
+        const double integral = Integral(islot, startx, stopx, starty, stopy);
+        if (integral > 0.) Scale(islot, norm / integral);
+        return;
+
+      }  // end 'Normalize(std::size_t, double x 5)'
+
+      // ----------------------------------------------------------------------
+      //! Divide two slots into a new one
+      // ----------------------------------------------------------------------
+      /*! \return index of slot holding numer / denom */
+      std::size_t Divide(
+        const std::size_t numer,
+        const std::size_t denom,
+        const std::string& name,
+        const std::string& title
+      ) {
+
+        CheckShapes(numer, denom);
+        const std::size_t ratio = Create(denom, name, title);
+
+        std::vector<double> ncontent, nsumw2;
+        std::vector<double> dcontent, dsumw2;
+        std::vector<double> rcontent, rsumw2;
+        for (std::size_t itile = 0; itile < GetNTiles(ratio); ++itile) {
+          ReadTile(numer, itile, ncontent, nsumw2);
+          ReadTile(denom, itile, dcontent, dsumw2);
+          rcontent.assign(ncontent.size(), 0.);
+          rsumw2.assign(ncontent.size(), 0.);
+          HistMath::Divide(
+            &ncontent[0], &nsumw2[0],
+            &dcontent[0], &dsumw2[0],
+            &rcontent[0], &rsumw2[0],
+            rcontent.size()
+          );
+          WriteTile(ratio, itile, rcontent, rsumw2);
+        }
+        return ratio;
+
+      }  // end 'Divide(std::size_t x 2, std::string& x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Make a ROOT histogram from a slot
+      // ----------------------------------------------------------------------
+      /*! The returned histogram isn't attached to any
+       *  directory, so the caller owns it.
+       */
+      TH1* MakeTH(const std::size_t islot, const Type::Precision precision = Type::Double) const {
+
+        const Slot& slot = m_slots[islot];
+        const int   nx   = (int) slot.edges[0].size() - 1;
+        const int   ny   = (int) slot.edges[1].size() - 1;
+
+        TH1* hist = NULL;
+        if (slot.ndim == 3) {
+          const int nz = (int) slot.edges[2].size() - 1;
+          if (precision == Type::Float) {
+            hist = new TH3F(slot.name.data(), slot.title.data(), nx, &slot.edges[0][0], ny, &slot.edges[1][0], nz, &slot.edges[2][0]);
+          } else {
+            hist = new TH3D(slot.name.data(), slot.title.data(), nx, &slot.edges[0][0], ny, &slot.edges[1][0], nz, &slot.edges[2][0]);
+          }
+          hist -> GetZaxis() -> SetTitle( slot.titles[2].data() );
+        } else {
+          if (precision == Type::Float) {
+            hist = new TH2F(slot.name.data(), slot.title.data(), nx, &slot.edges[0][0], ny, &slot.edges[1][0]);
+          } else {
+            hist = new TH2D(slot.name.data(), slot.title.data(), nx, &slot.edges[0][0], ny, &slot.edges[1][0]);
+          }
+        }
+        hist -> SetDirectory(0);
+        hist -> GetXaxis() -> SetTitle( slot.titles[0].data() );
+        hist -> GetYaxis() -> SetTitle( slot.titles[1].data() );
+        hist -> Sumw2();
+
+        // copy cells over tile by tile
+        std::vector<double> content;
+        std::vector<double> sumw2;
+        for (std::size_t itile = 0; itile < GetNTiles(islot); ++itile) {
+          const std::size_t first = ReadTile(islot, itile, content, sumw2);
+          for (std::size_t icell = 0; icell < content.size(); ++icell) {
+            hist -> SetBinContent(first + icell, content[icell]);
+            hist -> SetBinError(first + icell, std::sqrt(sumw2[icell]));
+          }
+        }
+        return hist;
+
+      }  // end 'MakeTH(std::size_t, Type::Precision)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      explicit TileStore(const std::size_t ncells = 1 << 16)
+        : m_file(NULL)
+        , m_size(0)
+        , m_tileCells(std::max(ncells, (std::size_t) 1))
+      {};
+
+      ~TileStore() {
+        if (m_file) std::fclose(m_file);
+      };
+
+  };  // end TileStore
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
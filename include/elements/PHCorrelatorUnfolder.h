@@ -0,0 +1,360 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorUnfolder.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Batched iterative (D'Agostini) unfolding of
+ *  1D spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORUNFOLDER_H
+#define PHCORRELATORUNFOLDER_H
+
+// c++ utilities
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorSparseMatrix.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Iterative unfolder
+  // ==========================================================================
+  /*! Unfolds measured spectra with D'Agostini's iterative
+   *  Bayesian method. Given the response R(m, t) (counts of
+   *  truth bin t reconstructed in measured bin m) and the
+   *  truth spectrum T(t), the smearing matrix is
+   *
+   *    A(m, t) = R(m, t) / T(t),  eff(t) = sum_m A(m, t),
+   *
+   *  and each iteration updates the unfolded spectrum n(t)
+   *  from the measured d(m) as
+   *
+   *    f = A n,  n'(t) = n(t) / eff(t) * sum_m A(m, t) d(m) / f(m),
+   *
+   *  starting from the truth spectrum as prior. So every
+   *  iteration is one product with A and one with A^T, which
+   *  are done with a SparseMatrix (response matrices are
+   *  mostly near-diagonal). Statistical errors of the data
+   *  are propagated through the last iteration's unfolding
+   *  matrix (neglecting the dependence on earlier iterations).
+   *
+   *  Responses are registered once under a key and shared by
+   *  any number of queued spectra, which are then unfolded
+   *  together by `Unfold`: spread over threads one spectrum
+   *  per thread when there are enough of them, otherwise one
+   *  at a time with multithreaded products.
+   */
+  class Unfolder {
+
+    private:
+
+      // ======================================================================
+      //! A registered response
+      // ======================================================================
+      struct Response {
+        SparseMatrix        smear;  ///!< smearing matrix A(m, t)
+        std::vector<double> eff;    ///!< efficiency of each truth bin
+        std::vector<double> prior;  ///!< truth spectrum (initial prior)
+        Hist1D              truth;  ///!< truth spectrum (provides binning)
+        const Binning*      meas;   ///!< measured binning
+      };
+
+      // ======================================================================
+      //! A queued spectrum
+      // ======================================================================
+      struct Job {
+        std::string name;      ///!< name of unfolded histogram
+        Hist1D      measured;  ///!< spectrum to unfold
+        std::size_t response;  ///!< index of response to use
+      };
+
+      // data members
+      std::size_t                        m_nIter;      ///!< no. of iterations
+      std::vector<Response>              m_responses;  ///!< registered responses
+      std::map<std::string, std::size_t> m_keys;       ///!< response key to index
+      std::vector<Job>                   m_jobs;       ///!< spectra left to unfold
+      std::vector<Hist1D>                m_results;    ///!< unfolded spectra
+
+      // ======================================================================
+      //! Unfolds each queued spectrum
+      // ======================================================================
+      class UnfoldTask : public Parallel::Task {
+
+        private:
+
+          const Unfolder*      m_unfolder;
+          std::vector<Hist1D>* m_out;
+          std::size_t          m_first;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            (*m_out)[m_first + item] = m_unfolder -> UnfoldOne(m_unfolder -> m_jobs[item], 1);
+          }
+
+          UnfoldTask(const Unfolder* unfolder, std::vector<Hist1D>* out, const std::size_t first)
+            : m_unfolder(unfolder), m_out(out), m_first(first) {};
+
+      };  // end UnfoldTask
+      friend class UnfoldTask;
+
+      // ----------------------------------------------------------------------
+      //! Unfold one spectrum
+      // ----------------------------------------------------------------------
+      /*! Only reads shared data, so it's safe to run
+       *  for different spectra concurrently.
+       */
+      Hist1D UnfoldOne(const Job& job, const std::size_t nthreads) const {
+
+        const Response&   resp  = m_responses[job.response];
+        const std::size_t nmeas = resp.smear.GetNRows();
+        const std::size_t ntrue = resp.smear.GetNColumns();
+
+        // grab measured spectrum & its variance
+        std::vector<double> data(nmeas, 0.);
+        std::vector<double> vard(nmeas, 0.);
+        for (std::size_t im = 0; im < nmeas; ++im) {
+          data[im] = job.measured.GetBinContent(im + 1);
+          vard[im] = job.measured.GetBinSumw2(im + 1);
+        }
+
+        // iterate
+        std::vector<double> unfold = resp.prior;
+        std::vector<double> prev   = resp.prior;
+        std::vector<double> folded(nmeas, 0.);
+        std::vector<double> ratio(nmeas, 0.);
+        std::vector<double> back(ntrue, 0.);
+        for (std::size_t iter = 0; iter < m_nIter; ++iter) {
+          prev = unfold;
+          resp.smear.Multiply(prev, folded, nthreads);
+          for (std::size_t im = 0; im < nmeas; ++im) {
+            ratio[im] = (folded[im] > 0.) ? data[im] / folded[im] : 0.;
+          }
+          resp.smear.MultiplyTransposed(ratio, back, nthreads);
+          for (std::size_t it = 0; it < ntrue; ++it) {
+            unfold[it] = (resp.eff[it] > 0.) ? prev[it] * back[it] / resp.eff[it] : 0.;
+          }
+        }
+
+        // propagate errors through last iteration
+        resp.smear.Multiply(prev, folded, nthreads);
+
+        std::vector<double> scaled(nmeas, 0.);
+        for (std::size_t im = 0; im < nmeas; ++im) {
+          scaled[im] = (folded[im] > 0.) ? vard[im] / (folded[im] * folded[im]) : 0.;
+        }
+
+        std::vector<double> var(ntrue, 0.);
+        resp.smear.MultiplyTransposed(scaled, var, nthreads, true);
+
+        // and fill unfolded histogram
+        Hist1D result(job.name, job.measured.GetTitle(), resp.truth.GetBinning());
+        result.SetXTitle( resp.truth.GetXTitle() );
+        result.SetYTitle( job.measured.GetYTitle() );
+        for (std::size_t it = 0; it < ntrue; ++it) {
+          const double norm = (resp.eff[it] > 0.) ? prev[it] / resp.eff[it] : 0.;
+          result.SetBinContent(it + 1, unfold[it]);
+          result.SetBinSumw2(it + 1, norm * norm * var[it]);
+        }
+        return result;
+
+      }  // end 'UnfoldOne(Job&, std::size_t)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t   GetNIterations()                   const {return m_nIter;}
+      std::size_t   GetNResponses()                    const {return m_responses.size();}
+      std::size_t   GetNQueued()                       const {return m_jobs.size();}
+      std::size_t   GetNResults()                      const {return m_results.size();}
+      const Hist1D& GetResult(const std::size_t ires)  const {return m_results.at(ires);}
+
+      // ----------------------------------------------------------------------
+      //! Set no. of iterations
+      // ----------------------------------------------------------------------
+      void SetNIterations(const std::size_t niter) {m_nIter = niter;}
+
+      // ----------------------------------------------------------------------
+      //! Check if a response has been registered
+      // ----------------------------------------------------------------------
+      bool HasResponse(const std::string& key) const {
+
+        return (m_keys.find(key) != m_keys.end());
+
+      }  // end 'HasResponse(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Register a response
+      // ----------------------------------------------------------------------
+      /*! The response should have the measured (reco) variable
+       *  on x and the truth variable on y, and the truth spectrum
+       *  the same binning as the y axis. The truth spectrum
+       *  includes jets/pairs that weren't reconstructed, so
+       *  inefficiencies are corrected for. Registering under an
+       *  existing key replaces that response.
+       *
+       *  \param key      key to refer to the response by
+       *  \param response reco (x) vs. truth (y) counts
+       *  \param truth    truth-level spectrum
+       */
+      void AddResponse(const std::string& key, const Hist2D& response, const Hist1D& truth) {
+
+        if (truth.GetBinning() != response.GetYBinning()) {
+          std::cerr << "PANIC: truth spectrum and response " << key << " have different binning!" << std::endl;
+          Error::Raise("truth spectrum and response " + key + " have different binning");
+          assert(truth.GetBinning() == response.GetYBinning());
+        }
+
+        const std::size_t nmeas = response.GetNbinsX();
+        const std::size_t ntrue = response.GetNbinsY();
+
+        // build smearing matrix (in-range bins only)
+        Response resp;
+        resp.meas  = response.GetXBinning();
+        resp.truth = truth;
+        resp.prior.assign(ntrue, 0.);
+        resp.eff.assign(ntrue, 0.);
+
+        std::vector<double> dense(nmeas * ntrue, 0.);
+        for (std::size_t it = 0; it < ntrue; ++it) {
+          resp.prior[it] = truth.GetBinContent(it + 1);
+          if (resp.prior[it] <= 0.) continue;
+          for (std::size_t im = 0; im < nmeas; ++im) {
+            const double prob = response.GetBinContent(im + 1, it + 1) / resp.prior[it];
+            dense[(im * ntrue) + it] = prob;
+            resp.eff[it]            += prob;
+          }
+        }
+        resp.smear.Build(dense, nmeas, ntrue);
+
+        std::map<std::string, std::size_t>::const_iterator found = m_keys.find(key);
+        if (found != m_keys.end()) {
+          m_responses[found -> second] = resp;
+        } else {
+          m_keys[key] = m_responses.size();
+          m_responses.push_back(resp);
+        }
+        return;
+
+      }  // end 'AddResponse(std::string&, Hist2D&, Hist1D&)'
+
+      // ----------------------------------------------------------------------
+      //! Queue a spectrum to unfold
+      // ----------------------------------------------------------------------
+      /*! \param name     name of unfolded histogram
+       *  \param measured spectrum to unfold (same binning as response x axis)
+       *  \param key      key of response to use
+       */
+      void Add(const std::string& name, const Hist1D& measured, const std::string& key) {
+
+        std::map<std::string, std::size_t>::const_iterator found = m_keys.find(key);
+        if (found == m_keys.end()) {
+          std::cerr << "PANIC: no response registered as " << key << "!" << std::endl;
+          Error::Raise("no response registered as " + key);
+          assert(found != m_keys.end());
+        }
+        if (measured.GetBinning() != m_responses[found -> second].meas) {
+          std::cerr << "PANIC: " << measured.GetName() << " doesn't have the measured binning of response " << key << "!" << std::endl;
+          Error::Raise(measured.GetName() + " doesn't have the measured binning of response " + key);
+          assert(measured.GetBinning() == m_responses[found -> second].meas);
+        }
+
+        Job job;
+        job.name     = name;
+        job.measured = measured;
+        job.response = found -> second;
+        m_jobs.push_back(job);
+        return;
+
+      }  // end 'Add(std::string&, Hist1D&, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Unfold all queued spectra
+      // ----------------------------------------------------------------------
+      /*! Returns the index of the first new result; results
+       *  from earlier calls are kept.
+       *
+       *  \param nthreads maximum number of threads to use
+       */
+      std::size_t Unfold(const std::size_t nthreads = Parallel::DefaultNThreads()) {
+
+        const std::size_t first = m_results.size();
+        m_results.resize(first + m_jobs.size());
+        if ((m_jobs.size() >= nthreads) || (nthreads <= 1)) {
+          UnfoldTask task(this, &m_results, first);
+          Parallel::For(task, m_jobs.size(), nthreads);
+        } else {
+          for (std::size_t ijob = 0; ijob < m_jobs.size(); ++ijob) {
+            m_results[first + ijob] = UnfoldOne(m_jobs[ijob], nthreads);
+          }
+        }
+        m_jobs.clear();
+        return first;
+
+      }  // end 'Unfold(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Drop all queued and unfolded spectra (keeping responses)
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_jobs.clear();
+        m_results.clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Drop all registered responses
+      // ----------------------------------------------------------------------
+      void ClearResponses() {
+
+        m_jobs.clear();
+        m_responses.clear();
+        m_keys.clear();
+        return;
+
+      }  // end 'ClearResponses()'
+
+      // ----------------------------------------------------------------------
+      //! Access the shared unfolder
+      // ----------------------------------------------------------------------
+      static Unfolder& Global() {
+
+        static Unfolder unfolder;
+        return unfolder;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Unfolder() : m_nIter(4) {};
+      ~Unfolder() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting no. of iterations
+      // ----------------------------------------------------------------------
+      explicit Unfolder(const std::size_t niter) : m_nIter(niter) {};
+
+  };  // end Unfolder
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,357 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorVariationEngine.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Batch evaluation of systematic variations
+ *  sharing loads across variations.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORVARIATIONENGINE_H
+#define PHCORRELATORVARIATIONENGINE_H
+
+// c++ utilities
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// root libraries
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorBinning.h"
+#include "PHCorrelatorHist.h"
+#include "PHCorrelatorLoadTools.h"
+#include "PHCorrelatorParallel.h"
+#include "PHCorrelatorPlotError.h"
+#include "PHCorrelatorPlotTools.h"
+#include "PHCorrelatorReplicaEngine.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Result of a variation sweep
+  // ==========================================================================
+  struct VariationResult {
+
+    // members
+    Hist1D              nominal;     ///!< chain evaluated on nominal inputs
+    std::vector<Hist1D> variations;  ///!< chain evaluated on each variation
+    std::vector<Hist1D> deltas;      ///!< variation - nominal, for each variation
+    Hist1D              envelope;    ///!< nominal with max. |delta| as its error
+
+  };  // end VariationResult
+
+
+
+  // ==========================================================================
+  //! Systematic variation engine
+  // ==========================================================================
+  /*! Holds a set of named variations, each of which overrides
+   *  the input files of particular (species, level) slots of
+   *  the nominal inputs (e.g. a different reco production or
+   *  a track-efficiency variation). Slots that aren't
+   *  overridden fall back to the nominal file.
+   *
+   *  Spectra are cached by (file, hist, rebinning), so inputs
+   *  shared between the nominal and any number of variations
+   *  are only read once per sweep. Run then evaluates a
+   *  ReplicaChain (e.g. CorrectionChain) on the nominal and
+   *  on every variation, the latter spread over threads, and
+   *  returns the per-variation deltas and their envelope.
+   *
+   *  Like the correction store, loading isn't meant to be
+   *  shared between threads.
+   */
+  class VariationEngine {
+
+    public:
+
+      // ======================================================================
+      //! File override of a variation
+      // ======================================================================
+      struct Override {
+
+        int         species;  ///!< species index of slot
+        int         level;    ///!< level index of slot
+        std::string file;     ///!< file to use instead of nominal
+
+      };  // end Override
+
+      // ======================================================================
+      //! A named variation
+      // ======================================================================
+      struct Variation {
+
+        std::string           name;       ///!< name of variation (used in output names)
+        std::vector<Override> overrides;  ///!< slots to override
+
+      };  // end Variation
+
+    private:
+
+      // data members
+      std::vector<Variation>        m_variations;  ///!< declared variations
+      std::map<std::string, Hist1D> m_loaded;      ///!< loaded spectra, keyed by file:hist:nrebin
+      std::size_t                   m_nLoads;      ///!< no. of spectra loaded from file
+
+      // ======================================================================
+      //! Evaluates a chain on each variation
+      // ======================================================================
+      class VariationTask : public Parallel::Task {
+
+        private:
+
+          const ReplicaChain*                      m_chain;
+          const std::vector<std::vector<Hist1D> >* m_inputs;
+          std::vector<Hist1D>*                     m_results;
+
+        public:
+
+          void Run(const std::size_t item, const std::size_t /*thread*/) {
+            (*m_results)[item] = m_chain -> Evaluate( (*m_inputs)[item] );
+          }
+
+          VariationTask(
+            const ReplicaChain* chain,
+            const std::vector<std::vector<Hist1D> >* inputs,
+            std::vector<Hist1D>* results
+          ) : m_chain(chain), m_inputs(inputs), m_results(results) {};
+
+      };  // end VariationTask
+
+      // ----------------------------------------------------------------------
+      //! Find a variation by name
+      // ----------------------------------------------------------------------
+      std::size_t FindVariation(const std::string& name) const {
+
+        for (std::size_t ivar = 0; ivar < m_variations.size(); ++ivar) {
+          if (m_variations[ivar].name == name) return ivar;
+        }
+
+        std::cerr << "PANIC: variation '" << name << "' hasn't been declared!" << std::endl;
+        Error::Raise("variation '" + name + "' hasn't been declared");
+        assert(false);
+        return m_variations.size();
+
+      }  // end 'FindVariation(std::string&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::size_t      GetNVariations() const {return m_variations.size();}
+      std::size_t      GetNLoaded()     const {return m_loaded.size();}
+      std::size_t      GetNLoads()      const {return m_nLoads;}
+      const Variation& GetVariation(const std::size_t ivar) const {return m_variations.at(ivar);}
+
+      // ----------------------------------------------------------------------
+      //! Declare a variation
+      // ----------------------------------------------------------------------
+      void AddVariation(const std::string& name) {
+
+        Variation variation;
+        variation.name = name;
+        m_variations.push_back(variation);
+        return;
+
+      }  // end 'AddVariation(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Override the file of a (species, level) slot in a variation
+      // ----------------------------------------------------------------------
+      void AddOverride(const std::string& name, const int species, const int level, const std::string& file) {
+
+        Override over;
+        over.species = species;
+        over.level   = level;
+        over.file    = file;
+        m_variations[FindVariation(name)].overrides.push_back(over);
+        return;
+
+      }  // end 'AddOverride(std::string&, int x 2, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Get file of a slot for a variation
+      // ----------------------------------------------------------------------
+      /*! \param ivar    index of variation
+       *  \param species species index of slot
+       *  \param level   level index of slot
+       *  \param nominal file of slot in nominal inputs
+       */
+      std::string ResolveFile(
+        const std::size_t ivar,
+        const int species,
+        const int level,
+        const std::string& nominal
+      ) const {
+
+        const std::vector<Override>& overrides = m_variations.at(ivar).overrides;
+        for (std::size_t iover = 0; iover < overrides.size(); ++iover) {
+          if ((overrides[iover].species == species) && (overrides[iover].level == level)) {
+            return overrides[iover].file;
+          }
+        }
+        return nominal;
+
+      }  // end 'ResolveFile(std::size_t, int x 2, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Load a spectrum (if not already loaded)
+      // ----------------------------------------------------------------------
+      /*! Spectra are returned as loaded (and rebinned), so
+       *  any normalization is left to the chain.
+       *
+       *  \param file   file to read from
+       *  \param hist   name of histogram to read
+       *  \param nrebin number of bins to merge (1 if not rebinning)
+       */
+      const Hist1D& Load(const std::string& file, const std::string& hist, const int nrebin = 1) {
+
+        const std::string key = file + ":" + hist + ":" + Tools::StringifyIndex(nrebin);
+
+        std::map<std::string, Hist1D>::iterator loaded = m_loaded.find(key);
+        if (loaded != m_loaded.end()) {
+          return loaded -> second;
+        }
+
+        // grab spectrum from shared memory or file
+        ++m_nLoads;
+        return (m_loaded[key] = Tools::LoadHist1D(file, hist, nrebin));
+
+      }  // end 'Load(std::string& x 2, int)'
+
+      // ----------------------------------------------------------------------
+      //! Evaluate a chain on the nominal and every variation
+      // ----------------------------------------------------------------------
+      /*! The nominal is evaluated on the calling thread first,
+       *  then the variations in parallel. Overridden inputs can
+       *  have binnings the nominal doesn't, so the bin maps
+       *  between each variation's inputs are built on the
+       *  calling thread beforehand (see `Binning::Map(...)`)
+       *  rather than by the workers. Deltas are named after the
+       *  nominal output with "_Delta<name>" appended, the
+       *  envelope with "_Envelope".
+       *
+       *  \param chain    operations to run
+       *  \param nominal  nominal inputs of chain
+       *  \param inputs   inputs of chain for each variation
+       *  \param nthreads maximum number of threads to use
+       */
+      VariationResult Run(
+        const ReplicaChain& chain,
+        const std::vector<Hist1D>& nominal,
+        const std::vector<std::vector<Hist1D> >& inputs,
+        const std::size_t nthreads = Parallel::DefaultNThreads()
+      ) const {
+
+        if (inputs.size() != m_variations.size()) {
+          std::cerr << "PANIC: got inputs for " << inputs.size() << " variations, but "
+                    << m_variations.size() << " were declared!"
+                    << std::endl;
+          Error::Raise("variation inputs don't match declared variations");
+          assert(inputs.size() == m_variations.size());
+        }
+
+        VariationResult result;
+        result.nominal = chain.Evaluate(nominal);
+        result.variations.resize( inputs.size() );
+
+        // build bin maps between each variation's inputs up front
+        for (std::size_t ivar = 0; ivar < inputs.size(); ++ivar) {
+          for (std::size_t iin = 0; iin < inputs[ivar].size(); ++iin) {
+            for (std::size_t jin = 0; jin < inputs[ivar].size(); ++jin) {
+              const Binning* from = inputs[ivar][iin].GetBinning();
+              const Binning* to   = inputs[ivar][jin].GetBinning();
+              if (from != to) Binning::Map(from, to);
+            }
+          }
+        }
+
+        VariationTask task(&chain, &inputs, &result.variations);
+        Parallel::For(task, inputs.size(), nthreads);
+
+        // compute deltas and their envelope
+        result.envelope = result.nominal;
+        result.envelope.SetName( result.nominal.GetName() + "_Envelope" );
+
+        std::vector<double> largest(result.nominal.GetNcells(), 0.);
+        for (std::size_t ivar = 0; ivar < result.variations.size(); ++ivar) {
+
+          const Hist1D& varied = result.variations[ivar];
+          if (varied.GetNcells() != result.nominal.GetNcells()) {
+            std::cerr << "PANIC: variation " << m_variations[ivar].name << " has a different no. of bins than nominal!" << std::endl;
+            Error::Raise("variation '" + m_variations[ivar].name + "' has a different no. of bins than nominal");
+            assert(varied.GetNcells() == result.nominal.GetNcells());
+          }
+
+          Hist1D delta = varied;
+          delta.SetName( result.nominal.GetName() + "_Delta" + m_variations[ivar].name );
+          for (int icell = 0; icell < delta.GetNcells(); ++icell) {
+            const double diff = varied.GetBinContent(icell) - result.nominal.GetBinContent(icell);
+            delta.SetBinContent(icell, diff);
+            if (std::fabs(diff) > largest[icell]) {
+              largest[icell] = std::fabs(diff);
+            }
+          }
+          result.deltas.push_back(delta);
+        }
+
+        for (int icell = 0; icell < result.envelope.GetNcells(); ++icell) {
+          result.envelope.SetBinError(icell, largest[icell]);
+        }
+        return result;
+
+      }  // end 'Run(ReplicaChain&, std::vector<Hist1D>&, std::vector<std::vector<Hist1D> >&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Clear loaded spectra (variations are kept)
+      // ----------------------------------------------------------------------
+      void ClearLoaded() {
+
+        m_loaded.clear();
+        return;
+
+      }  // end 'ClearLoaded()'
+
+      // ----------------------------------------------------------------------
+      //! Clear everything
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_variations.clear();
+        m_loaded.clear();
+        m_nLoads = 0;
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Shared engine for a sweep
+      // ----------------------------------------------------------------------
+      static VariationEngine& Global() {
+
+        static VariationEngine engine;
+        return engine;
+
+      }  // end 'Global()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      VariationEngine() : m_nLoads(0) {};
+      ~VariationEngine() {};
+
+  };  // end VariationEngine
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
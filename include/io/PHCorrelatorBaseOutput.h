@@ -11,6 +11,9 @@
 #ifndef PHCORRELATORBASEOUTPUT_H
 #define PHCORRELATORBASEOUTPUT_H
 
+// c++ utilities
+#include <string>
+#include <vector>
 // root libraries
 #include <TFile.h>
 // plotting utilities
@@ -35,21 +38,121 @@ namespace PHEnergyCorrelator {
       // ----------------------------------------------------------------------
       //! Helper method to determine if rebinning should be done
       // ----------------------------------------------------------------------
+      /*! If the shared adaptive rebinner is on, angle spectra
+       *  at every pt are rebinned to its target uncertainty;
+       *  otherwise only high pt angle spectra are rebinned,
+       *  by merging groups of `num` bins.
+       */
       Rebin GetRebin(const int num, const int opt) {
 
-        const bool isAnAngle = (opt == Type::Angle);
-        const bool isHighPt  = (m_index.pt == HistInput::Pt15);
-        return (isAnAngle && isHighPt) ? Rebin(true, num) : Rebin(false);
+        if ((opt == Type::Angle) && AdaptiveRebin::Global().IsOn()) {
+          return Rebin::Adaptive( AdaptiveRebin::Global().GetTarget() );
+        }
+        return IsRebinned(opt, m_index.pt) ? Rebin(true, num) : Rebin(false);
 
       }  // end 'GetRebin(int, int)'
 
     protected:
 
+      // ----------------------------------------------------------------------
+      //! Indices of a pt bin at each level
+      // ----------------------------------------------------------------------
+      struct LevelIndices {
+        Type::PlotIndex data;   ///!< data spectrum
+        Type::PlotIndex reco;   ///!< reconstructed (simulated) spectrum
+        Type::PlotIndex truth;  ///!< generated (simulated) spectrum
+      };
+
       // data members
       Type::PlotIndex m_index;
       PlotMaker       m_maker;
       Input           m_input;
 
+      // ----------------------------------------------------------------------
+      //! Helper method to get jet pt bins to sweep over
+      // ----------------------------------------------------------------------
+      static std::vector<int> GetPtBins() {
+
+        std::vector<int> pts;
+        pts.push_back(HistInput::Pt5);
+        pts.push_back(HistInput::Pt10);
+        pts.push_back(HistInput::Pt15);
+        return pts;
+
+      }  // end 'GetPtBins()'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to check if spectra at a pt bin are rebinned
+      // ----------------------------------------------------------------------
+      /*! Only high pt angle spectra are rebinned. */
+      static bool IsRebinned(const int opt, const int pt) {
+
+        return (opt == Type::Angle) && (pt == HistInput::Pt15);
+
+      }  // end 'IsRebinned(int x 2)'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to get no. of bins to merge at a pt bin
+      // ----------------------------------------------------------------------
+      static int GetNMerge(const int nrebin, const int opt, const int pt) {
+
+        return IsRebinned(opt, pt) ? nrebin : 1;
+
+      }  // end 'GetNMerge(int x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to make data, reco, and truth indices of a pt bin
+      // ----------------------------------------------------------------------
+      /*! Reco and truth take the spin state set by the
+       *  correction store's key policy (see CorrectionStore).
+       */
+      LevelIndices MakeLevelIndices(const int pt) const {
+
+        const int spin = CorrectionStore::Global().ResolveSpin(m_index.spin);
+
+        LevelIndices indices;
+        indices.data        = m_index;
+        indices.data.pt     = pt;
+        indices.data.level  = FileInput::Data;
+        indices.reco        = m_index;
+        indices.reco.pt     = pt;
+        indices.reco.level  = FileInput::Reco;
+        indices.reco.spin   = spin;
+        indices.truth       = m_index;
+        indices.truth.pt    = pt;
+        indices.truth.level = FileInput::True;
+        indices.truth.spin  = spin;
+        return indices;
+
+      }  // end 'MakeLevelIndices(int)'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to load a 1D spectrum of an index
+      // ----------------------------------------------------------------------
+      Hist1D Load1D(const std::string& variable, const Type::PlotIndex& index, const int nrebin = 1) {
+
+        return Tools::LoadHist1D(
+          m_input.GetFiles().GetFile(index),
+          m_input.MakeHistName(variable, index),
+          nrebin
+        );
+
+      }  // end 'Load1D(std::string&, Type::PlotIndex&, int)'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to load a 2D spectrum of an index
+      // ----------------------------------------------------------------------
+      Hist2D Load2D(const std::string& variable, const Type::PlotIndex& index, const int nrebin = 1) {
+
+        return Tools::LoadHist2D(
+          m_input.GetFiles().GetFile(index),
+          m_input.MakeHistName(variable, index),
+          nrebin,
+          nrebin
+        );
+
+      }  // end 'Load2D(std::string&, Type::PlotIndex&, int)'
+
     public:
 
       // ----------------------------------------------------------------------
@@ -80,6 +183,15 @@ namespace PHEnergyCorrelator {
        */
       virtual void MakePlot2D(const std::string& /*variable*/, TFile* /*ofile*/) {return;}
 
+      // ----------------------------------------------------------------------
+      //! Finish any work queued over a sweep
+      // ----------------------------------------------------------------------
+      /*! Can be overwritten by wirings which queue work over
+       *  every index (e.g. ModulationFits) and only process
+       *  it once the sweep is done.
+       */
+      virtual void Finish() {return;}
+
       // ----------------------------------------------------------------------
       //! default ctor/dtor
       // ----------------------------------------------------------------------
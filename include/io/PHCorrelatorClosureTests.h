@@ -0,0 +1,141 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorClosureTests.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to run closure tests of the
+ *  bin-by-bin corrections
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCLOSURETESTS_H
+#define PHCORRELATORCLOSURETESTS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Closure Tests Output Wiring
+  // ==========================================================================
+  /*! Wiring to run closure tests of the corrections in
+   *  CorrectSpectra1D with the shared closure-test engine
+   *  (ClosureEngine::Global()).
+   *
+   *  If the engine is set to expect n pre-split subsamples,
+   *  subsample i is expected in the reco- and truth-level
+   *  files under the name of the spectrum with the variable
+   *  suffixed by "Split<i>" (e.g. "hRecoJetEECSplit0Stat_pt0").
+   *  Otherwise, the full reco and truth spectra are randomly
+   *  split.
+   */
+  class ClosureTests : public BaseOutput {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Run closure tests on 1D spectra
+      // ----------------------------------------------------------------------
+      /*! For each jet pt bin, writes the mean non-closure
+       *  (with the spread across trials as its error) and
+       *  the spread itself. Per-bin summaries are kept in
+       *  the engine's table.
+       *
+       *  \param variable what variable (spectra) is being corrected
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        ClosureEngine& engine = ClosureEngine::Global();
+
+        // normalize like CorrectSpectra1D
+        PlotOpts options;
+        options.norm_range = Default::NormRange(opt);
+        engine.SetOptions(options);
+
+        // jet pt bins to test
+        const std::vector<int> pts = GetPtBins();
+
+        // make tag
+        const std::string tag = m_input.MakeSpeciesTag("Closure1D", m_index.species) + "_";
+
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          // constrain level, pt indices
+          const LevelIndices     levels = MakeLevelIndices(pts[ipt]);
+          const Type::PlotIndex& iReco  = levels.reco;
+          const Type::PlotIndex& iTrue  = levels.truth;
+
+          // determine rebinning
+          const int nmerge = GetNMerge(nrebin, opt, pts[ipt]);
+
+          // load (sub)samples & run trials
+          const std::string name = m_input.MakeHistName(variable, iReco, tag);
+
+          ClosureResult result;
+          if (engine.GetNSplits() > 0) {
+            std::vector<ClosureSample> samples;
+            for (std::size_t isplit = 0; isplit < engine.GetNSplits(); ++isplit) {
+              const std::string split = variable + "Split" + Tools::StringifyIndex(isplit);
+              samples.push_back(
+                ClosureSample( Load1D(split, iReco, nmerge), Load1D(split, iTrue, nmerge) )
+              );
+            }
+            result = engine.RunPreSplit(name, samples);
+          } else {
+            result = engine.RunSubSampled(
+              name,
+              ClosureSample( Load1D(variable, iReco, nmerge), Load1D(variable, iTrue, nmerge) )
+            );
+          }
+
+          // save
+          ofile -> cd();
+          TH1* mean = HistPool::Global().Acquire( result.mean, PlotOpts::DefaultPrecision() );
+          mean -> Write();
+          HistPool::Global().Release(mean);
+
+          TH1* spread = HistPool::Global().Acquire( result.spread, PlotOpts::DefaultPrecision() );
+          spread -> Write();
+          HistPool::Global().Release(spread);
+
+          std::cout << "    Ran " << result.ntrials << " closure trials for " << name << "." << std::endl;
+        }
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ClosureTests()  {};
+      ~ClosureTests() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      ClosureTests(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end ClosureTests
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
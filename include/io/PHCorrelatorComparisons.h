@@ -0,0 +1,208 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorComparisons.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to make all level, species, and
+ *  jet pt comparisons from one shared block
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCOMPARISONS_H
+#define PHCORRELATORCOMPARISONS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "PHCorrelatorPPVsPAu.h"
+#include "PHCorrelatorRecoVsData.h"
+#include "PHCorrelatorSimVsData.h"
+#include "PHCorrelatorVsPtJet.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Comparisons Output Wiring
+  // ==========================================================================
+  /*! Wiring to make the sim vs. data, reco vs. data, vs. jet
+   *  pt, and pp vs. pAu comparisons of a variable in one go.
+   *  The (species, level, jet pt) block of the current index
+   *  is loaded and normalized once into the shared comparison
+   *  tensor (ComparisonTensor::Global()), every ratio those
+   *  comparisons need is computed in one batched pass, and
+   *  then each comparison is drawn from the shared results.
+   *
+   *  If the species of the current index is set, only that
+   *  species is compared; otherwise both are, along with
+   *  pp vs. pAu.
+   */
+  class Comparisons : public BaseOutput {
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Helper method to make input of a slot
+      // ----------------------------------------------------------------------
+      /*! Matches what the individual wirings use, so
+       *  their lookups hit the slots loaded here.
+       */
+      PlotInput MakeInput(
+        const std::string& variable,
+        const Type::PlotIndex& index,
+        const int opt,
+        const int nrebin
+      ) {
+
+        return PlotInput(
+          m_input.GetFiles().GetFile(index),
+          m_input.MakeHistName(variable, index),
+          m_input.MakeHistName(variable, index),
+          m_input.MakeLegend(index),
+          "",
+          Style::Plot(),
+          IsRebinned(opt, index.pt) ? Rebin(true, nrebin) : Rebin(false)
+        );
+
+      }  // end 'MakeInput(std::string&, Type::PlotIndex&, int, int)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Make all 1D comparisons
+      // ----------------------------------------------------------------------
+      /*! \param variable what variable (spectra) is being plotted
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        ComparisonTensor& tensor = ComparisonTensor::Global();
+
+        // normalize like the individual comparisons
+        PlotOpts options;
+        options.norm_range = Default::NormRange(opt);
+        tensor.Reset(options);
+
+        // determine block to load
+        std::vector<int> species;
+        if (m_index.species > -1) {
+          species.push_back(m_index.species);
+        } else {
+          species.push_back(FileInput::PP);
+          species.push_back(FileInput::PAu);
+        }
+
+        std::vector<int> levels;
+        levels.push_back(FileInput::Data);
+        levels.push_back(FileInput::Reco);
+        levels.push_back(FileInput::True);
+
+        const std::vector<int> pts = GetPtBins();
+
+        // load block
+        std::cout << "\n    Loading comparison block for " << variable << ":" << std::endl;
+        for (std::size_t isp = 0; isp < species.size(); ++isp) {
+          for (std::size_t ilv = 0; ilv < levels.size(); ++ilv) {
+            for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+              Type::PlotIndex index = m_index;
+              index.species = species[isp];
+              index.level   = levels[ilv];
+              index.pt      = pts[ipt];
+              tensor.Load(
+                ComparisonTensor::Slot(species[isp], levels[ilv], pts[ipt]),
+                MakeInput(variable, index, opt, nrebin)
+              );
+            }
+          }
+        }
+
+        // request ratios: data & reco vs. truth, reco vs. data
+        for (std::size_t isp = 0; isp < species.size(); ++isp) {
+          for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+            const ComparisonTensor::Slot data(species[isp], FileInput::Data, pts[ipt]);
+            const ComparisonTensor::Slot reco(species[isp], FileInput::Reco, pts[ipt]);
+            const ComparisonTensor::Slot truth(species[isp], FileInput::True, pts[ipt]);
+            tensor.Request(data, truth);
+            tensor.Request(reco, truth);
+            tensor.Request(reco, data);
+          }
+        }
+
+        // and pAu vs. pp
+        const bool doSpecies = (species.size() > 1);
+        if (doSpecies) {
+          for (std::size_t ilv = 0; ilv < levels.size(); ++ilv) {
+            for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+              tensor.Request(
+                ComparisonTensor::Slot(FileInput::PAu, levels[ilv], pts[ipt]),
+                ComparisonTensor::Slot(FileInput::PP, levels[ilv], pts[ipt])
+              );
+            }
+          }
+        }
+        tensor.Compute();
+
+        // now draw each comparison from the shared block
+        for (std::size_t isp = 0; isp < species.size(); ++isp) {
+          for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+            Type::PlotIndex index = m_index;
+            index.species = species[isp];
+            index.pt      = pts[ipt];
+            SimVsData(index, m_maker, m_input).MakePlot1D(variable, opt, ofile, nrebin);
+            RecoVsData(index, m_maker, m_input).MakePlot1D(variable, opt, ofile, nrebin);
+          }
+          for (std::size_t ilv = 0; ilv < levels.size(); ++ilv) {
+            Type::PlotIndex index = m_index;
+            index.species = species[isp];
+            index.level   = levels[ilv];
+            VsPtJet(index, m_maker, m_input).MakePlot1D(variable, opt, ofile, nrebin);
+          }
+        }
+        if (doSpecies) {
+          for (std::size_t ilv = 0; ilv < levels.size(); ++ilv) {
+            Type::PlotIndex index = m_index;
+            index.level = levels[ilv];
+            PPVsPAu(index, m_maker, m_input).MakePlot1D(variable, opt, ofile, nrebin);
+          }
+        }
+        std::cout << "    Drew comparisons of " << variable << " from "
+                  << tensor.GetNSlots() << " slots and "
+                  << tensor.GetNRatios() << " ratios."
+                  << std::endl;
+
+        // clear block so later routines load their own inputs
+        tensor.Reset(options);
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Comparisons()  {};
+      ~Comparisons() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      Comparisons(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end Comparisons
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -46,6 +46,10 @@ namespace PHEnergyCorrelator {
        */
       void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
 
+        // correct with spin state set by store's key policy
+        const CorrectionStore& store = CorrectionStore::Global();
+        const int              spin  = store.ResolveSpin(m_index.spin);
+
         // constrain level, pt indices
         Type::PlotIndex iPt5data = m_index;
         Type::PlotIndex iPt5reco = m_index;
@@ -54,8 +58,10 @@ namespace PHEnergyCorrelator {
         iPt5data.level = FileInput::Data;
         iPt5reco.pt    = HistInput::Pt5;
         iPt5reco.level = FileInput::Reco;
+        iPt5reco.spin  = spin;
         iPt5true.pt    = HistInput::Pt5;
         iPt5true.level = FileInput::True;
+        iPt5true.spin  = spin;
 
         Type::PlotIndex iPt10data = m_index;
         Type::PlotIndex iPt10reco = m_index;
@@ -64,8 +70,10 @@ namespace PHEnergyCorrelator {
         iPt10data.level = FileInput::Data;
         iPt10reco.pt    = HistInput::Pt10;
         iPt10reco.level = FileInput::Reco;
+        iPt10reco.spin  = spin;
         iPt10true.pt    = HistInput::Pt10;
         iPt10true.level = FileInput::True;
+        iPt10true.spin  = spin;
 
         Type::PlotIndex iPt15data = m_index;
         Type::PlotIndex iPt15reco = m_index;
@@ -74,8 +82,10 @@ namespace PHEnergyCorrelator {
         iPt15data.level = FileInput::Data;
         iPt15reco.pt    = HistInput::Pt15;
         iPt15reco.level = FileInput::Reco;
+        iPt15reco.spin  = spin;
         iPt15true.pt    = HistInput::Pt15;
         iPt15true.level = FileInput::True;
+        iPt15true.spin  = spin;
 
         // colors for diferent jet pt
         const std::size_t pt5_col[3]  = {799, 797, 809};
@@ -269,8 +279,50 @@ namespace PHEnergyCorrelator {
           )
         );
 
+        // build keys to store correction factors under
+        //   - n.b. only highest pt bin gets rebinned
+        std::vector<CorrectionStore::Key> keys;
+        keys.push_back(
+          store.MakeKey(
+            m_index.species,
+            HistInput::Pt5,
+            m_index.cf,
+            m_index.chrg,
+            m_index.spin,
+            variable,
+            reco_opt[0],
+            true_opt[0]
+          )
+        );
+        keys.push_back(
+          store.MakeKey(
+            m_index.species,
+            HistInput::Pt10,
+            m_index.cf,
+            m_index.chrg,
+            m_index.spin,
+            variable,
+            reco_opt[1],
+            true_opt[1]
+          )
+        );
+        keys.push_back(
+          store.MakeKey(
+            m_index.species,
+            HistInput::Pt15,
+            m_index.cf,
+            m_index.chrg,
+            m_index.spin,
+            variable,
+            reco_opt[2],
+            true_opt[2],
+            (opt == Type::Angle) ? nrebin : 1
+          )
+        );
+
         // make plot
         m_maker.GetCorrectSpectra1D().Configure(data_opt, reco_opt, true_opt, canvas, opt);
+        m_maker.GetCorrectSpectra1D().SetCorrectionKeys(keys);
         m_maker.GetCorrectSpectra1D().Plot(ofile);
         return;
 
@@ -0,0 +1,223 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorCovarianceSpectra.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to correct spectra with full
+ *  bin-to-bin covariance
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORCOVARIANCESPECTRA_H
+#define PHCORRELATORCOVARIANCESPECTRA_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Covariance Spectra Output Wiring
+  // ==========================================================================
+  /*! Wiring to apply the bin-by-bin corrections of
+   *  CorrectSpectra1D while propagating the full bin-to-bin
+   *  covariance, which is written next to each corrected
+   *  spectrum (as "<spectrum>_Cov").
+   *
+   *  The covariance of an input is expected in the same file
+   *  under the name of the spectrum with the variable suffixed
+   *  by "Cov" (e.g. "hDataJetEECCovStat_pt0"), binned like the
+   *  spectrum on both axes. If any input is missing one, the
+   *  covariance of the corrected spectrum is instead estimated
+   *  from replicas (see ReplicaEngine::Global()). Either way,
+   *  the errors written with the spectrum are the diagonal
+   *  of the written covariance.
+   *
+   *  Note that both paths treat reco and truth as independent
+   *  (see `Covariance::Ratio(...)`), although they come from
+   *  the same simulated events; the propagated covariance
+   *  of the correction factor is then an overestimate where
+   *  they share most of their counts.
+   */
+  class CovarianceSpectra : public BaseOutput {
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Helper method to load a spectrum and its covariance
+      // ----------------------------------------------------------------------
+      /*! \return true if a covariance was found */
+      bool Load(
+        const std::string& variable,
+        const Type::PlotIndex& index,
+        const int nrebin,
+        Hist1D& hist,
+        Covariance& cov
+      ) {
+
+        hist = Load1D(variable, index, nrebin);
+
+        // covariance is optional
+        const std::string covn = m_input.MakeHistName(variable + "Cov", index);
+
+        Hist2D     matrix;
+        const bool found = Tools::FindHist2D(m_input.GetFiles().GetFile(index), covn, matrix);
+        if (found) {
+          cov = Covariance::FromHist2D(matrix);
+          if (nrebin > 1) cov = cov.Rebin(nrebin);
+        }
+        std::cout << "      Cov. = " << (found ? covn : "(not found)") << std::endl;
+        return found;
+
+      }  // end 'Load(std::string&, Type::PlotIndex&, int, Hist1D&, Covariance&)'
+
+      // ----------------------------------------------------------------------
+      //! Helper method to normalize a spectrum and its covariance
+      // ----------------------------------------------------------------------
+      void Normalize(const PlotOpts& options, Hist1D& hist, Covariance& cov) const {
+
+        if (!options.do_norm) return;
+
+        const int istart = hist.FindBin( options.norm_range.GetX().first );
+        const int istop  = hist.FindBin( options.norm_range.GetX().second );
+
+        cov.Normalize(hist, options.norm_to, istart, istop);
+        Tools::NormalizeByIntegral(
+          hist,
+          options.norm_to,
+          options.norm_range.GetX().first,
+          options.norm_range.GetX().second
+        );
+        return;
+
+      }  // end 'Normalize(PlotOpts&, Hist1D&, Covariance&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Correct 1D spectra with covariance
+      // ----------------------------------------------------------------------
+      /*! \param variable what variable (spectra) is being corrected
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        // normalize like CorrectSpectra1D
+        PlotOpts options;
+        options.norm_range = Default::NormRange(opt);
+
+        // jet pt bins to correct
+        const std::vector<int> pts = GetPtBins();
+
+        // make tag
+        const std::string tag = m_input.MakeSpeciesTag("Cov1D", m_index.species) + "_";
+
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          // constrain level, pt indices
+          const LevelIndices     levels = MakeLevelIndices(pts[ipt]);
+          const Type::PlotIndex& iData  = levels.data;
+          const Type::PlotIndex& iReco  = levels.reco;
+          const Type::PlotIndex& iTrue  = levels.truth;
+
+          // load inputs
+          const int nmerge = GetNMerge(nrebin, opt, pts[ipt]);
+
+          Hist1D     data, recon, truth;
+          Covariance cdata, crecon, ctruth;
+          const bool hasData  = Load(variable, iData, nmerge, data, cdata);
+          const bool hasRecon = Load(variable, iReco, nmerge, recon, crecon);
+          const bool hasTruth = Load(variable, iTrue, nmerge, truth, ctruth);
+          data.SetName( m_input.MakeHistName(variable, iData, tag) );
+
+          Hist1D     corrected;
+          Covariance ccorrected;
+          if (hasData && hasRecon && hasTruth) {
+
+            // propagate input covariances
+            Normalize(options, data, cdata);
+            Normalize(options, recon, crecon);
+            Normalize(options, truth, ctruth);
+
+            // n.b. assumes reco & truth are independent
+            const Hist1D     factor  = Tools::DivideHist1D(recon, truth);
+            const Covariance cfactor = Covariance::Ratio(recon, crecon, truth, ctruth);
+
+            corrected  = Tools::DivideHist1D(data, factor);
+            ccorrected = Covariance::Ratio(data, cdata, factor, cfactor);
+            corrected.SetName( data.GetName() + "_Corrected" );
+            Normalize(options, corrected, ccorrected);
+            ccorrected.ApplyErrors(corrected);
+
+          } else {
+
+            // otherwise estimate from replicas, with
+            // data, reco & truth fluctuated independently
+            ReplicaEngine& engine = ReplicaEngine::Global();
+            engine.SetGroups(std::vector<int>());
+
+            std::vector<Hist1D> inputs;
+            inputs.push_back(data);
+            inputs.push_back(recon);
+            inputs.push_back(truth);
+
+            const ReplicaBand band = engine.Run(CorrectionChain(options), inputs);
+            corrected  = band.nominal;
+            ccorrected = band.covariance;
+            ccorrected.ApplyErrors(corrected);
+            std::cout << "    Estimated covariance of " << corrected.GetName()
+                      << " from " << band.nreplicas << " replicas."
+                      << std::endl;
+          }
+
+          // save spectrum & covariance next to each other
+          ofile -> cd();
+          TH1* hist = HistPool::Global().Acquire( corrected, PlotOpts::DefaultPrecision() );
+          hist -> Write();
+          HistPool::Global().Release(hist);
+
+          TH2* matrix = HistPool::Global().Acquire(
+            ccorrected.MakeHist2D(corrected, corrected.GetName() + "_Cov"),
+            PlotOpts::DefaultPrecision()
+          );
+          matrix -> Write();
+          HistPool::Global().Release(matrix);
+        }
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      CovarianceSpectra()  {};
+      ~CovarianceSpectra() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      CovarianceSpectra(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end CovarianceSpectra
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,158 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorFailureLog.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Helper class to collect failed plots
+ *  over a sweep.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORFAILURELOG_H
+#define PHCORRELATORFAILURELOG_H
+
+// c++ utilities
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+// plotting utilities
+#include "PHCorrelatorIOTypes.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Failure log
+  // ==========================================================================
+  /*! A small helper class to record which (wiring,
+   *  variable, index) tasks failed during a sweep
+   *  and report them at the end.
+   */
+  class FailureLog {
+
+    public:
+
+      // ======================================================================
+      //! A single failed task
+      // ======================================================================
+      struct Failure {
+
+        // members
+        std::string     wiring;    ///!< output wiring that failed
+        std::string     variable;  ///!< variable being plotted
+        Type::PlotIndex index;     ///!< index being plotted
+        std::string     what;      ///!< error message
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        Failure()  {};
+        ~Failure() {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Failure(
+          const std::string& wire_arg,
+          const std::string& var_arg,
+          const Type::PlotIndex& idx_arg,
+          const std::string& what_arg
+        ) {
+          wiring   = wire_arg;
+          variable = var_arg;
+          index    = idx_arg;
+          what     = what_arg;
+        }  // end ctor(std::string& x 2, Type::PlotIndex&, std::string&)
+
+      };  // end Failure
+
+    private:
+
+      // data members
+      std::vector<Failure> m_failures;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      std::vector<Failure> GetFailures() const {return m_failures;}
+      std::size_t          Size()        const {return m_failures.size();}
+      bool                 Empty()       const {return m_failures.empty();}
+
+      // ----------------------------------------------------------------------
+      //! Record a failure
+      // ----------------------------------------------------------------------
+      void Add(const Failure& failure) {
+
+        m_failures.push_back(failure);
+        return;
+
+      }  // end 'Add(Failure&)'
+
+      // ----------------------------------------------------------------------
+      //! Clear log
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        m_failures.clear();
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Write report to a stream
+      // ----------------------------------------------------------------------
+      /*! Report is tab-separated with one failure per line,
+       *  so it can be sorted or filtered with standard tools.
+       */
+      void Report(std::ostream& stream) const {
+
+        stream << "# wiring\tvariable\tlevel\tspecies\tpt\tcf\tchrg\tspin\twhat\n";
+        for (std::size_t ifail = 0; ifail < m_failures.size(); ++ifail) {
+          const Failure& fail = m_failures[ifail];
+          stream << fail.wiring        << "\t"
+                 << fail.variable      << "\t"
+                 << fail.index.level   << "\t"
+                 << fail.index.species << "\t"
+                 << fail.index.pt      << "\t"
+                 << fail.index.cf      << "\t"
+                 << fail.index.chrg    << "\t"
+                 << fail.index.spin    << "\t"
+                 << fail.what          << "\n";
+        }
+        return;
+
+      }  // end 'Report(std::ostream&)'
+
+      // ----------------------------------------------------------------------
+      //! Write report to a file
+      // ----------------------------------------------------------------------
+      void Write(const std::string& name) const {
+
+        std::ofstream report(name.data());
+        if (!report.is_open()) {
+          std::cerr << "WARNING: couldn't open failure report " << name << "!" << std::endl;
+          return;
+        }
+        Report(report);
+        report.close();
+        return;
+
+      }  // end 'Write(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      FailureLog()  {};
+      ~FailureLog() {};
+
+  };  // end FailureLog
+
+}  // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,242 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorModulationFits.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to fit azimuthal modulations
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORMODULATIONFITS_H
+#define PHCORRELATORMODULATIONFITS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Modulation Fits Output Wiring
+  // ==========================================================================
+  /*! Wiring to fit Fourier modulations (by default
+   *  const + cos(phi) + cos(2 phi), see
+   *  ModulationFitter::DefaultBasis()) to angular
+   *  spectra of each jet pt bin and each R slice of
+   *  the corresponding "VsR" spectrum, and save the
+   *  amplitudes vs. pt and R.
+   *
+   *  Spectra are only queued by `MakePlot1D(...)`; every
+   *  spectrum of the sweep is then fit in one parallel
+   *  pass and saved by `Finish()`.
+   */
+  class ModulationFits : public BaseOutput {
+
+    private:
+
+      // ======================================================================
+      //! Fits queued for one call to MakePlot1D
+      // ======================================================================
+      struct Queued {
+        std::string         variable;  ///!< variable fit
+        Type::PlotIndex     index;     ///!< index fit
+        std::string         rTitle;    ///!< title of R axis
+        std::vector<double> rEdges;    ///!< edges of R slices
+        TFile*              ofile;     ///!< file to write amplitudes to
+        std::size_t         firstPt;   ///!< index of first pt fit
+        std::size_t         firstR;    ///!< index of first R fit
+        std::size_t         lastR;     ///!< index after last R fit
+      };
+
+      // data members
+      ModulationFitter    m_fitter;  ///!< fitter holding every queued spectrum
+      std::vector<Queued> m_queued;  ///!< what was queued for each call
+
+      // ----------------------------------------------------------------------
+      //! Edges of jet pt bins
+      // ----------------------------------------------------------------------
+      static std::vector<double> PtEdges() {
+
+        std::vector<double> edges;
+        edges.push_back(5.);
+        edges.push_back(10.);
+        edges.push_back(15.);
+        edges.push_back(20.);
+        return edges;
+
+      }  // end 'PtEdges()'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Queue modulation fits of 1D angular spectra
+      // ----------------------------------------------------------------------
+      /*! Loads the spectra of the current index (one per jet
+       *  pt bin, one per R slice) and queues them. Nothing is
+       *  queued unless all of them load, so a failed call
+       *  leaves no partial entries behind. Fits are done by
+       *  `Finish()`.
+       *
+       *  \param variable what variable (spectra) is being fit
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        // jet pt bins to fit
+        const std::vector<int>    pts     = GetPtBins();
+        const std::vector<double> ptEdges = PtEdges();
+
+        // load angular spectrum of each pt bin
+        std::vector<Hist1D> natives;
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          Type::PlotIndex iPt = m_index;
+          iPt.pt = pts[ipt];
+          natives.push_back( Load1D(variable, iPt, GetNMerge(nrebin, opt, pts[ipt])) );
+        }
+
+        // and pt-integrated spectrum vs. R
+        Type::PlotIndex iInt = m_index;
+        iInt.pt = HistInput::PtInt;
+
+        const Hist2D native2D = Load2D(variable + "VsR", iInt);
+
+        // start from the current default basis on a new sweep
+        if (m_queued.empty()) {
+          m_fitter.SetBasis( ModulationFitter::DefaultBasis() );
+        }
+
+        // now queue everything
+        Queued queued;
+        queued.variable = variable;
+        queued.index    = m_index;
+        queued.rTitle   = native2D.GetXTitle();
+        queued.rEdges   = native2D.GetXEdges();
+        queued.ofile    = ofile;
+        queued.firstPt  = m_fitter.GetNQueued();
+        for (std::size_t ipt = 0; ipt < natives.size(); ++ipt) {
+          m_fitter.Add(natives[ipt].GetName(), natives[ipt], 0.5 * (ptEdges[ipt] + ptEdges[ipt + 1]));
+        }
+        queued.firstR = m_fitter.AddSlices(native2D.GetName(), native2D, Type::Y);
+        queued.lastR  = m_fitter.GetNQueued();
+        m_queued.push_back(queued);
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! Fit everything queued and save amplitudes
+      // ----------------------------------------------------------------------
+      /*! All spectra queued over the sweep are fit in a single
+       *  parallel pass. Amplitudes of each non-constant term are
+       *  saved relative to the constant term if there is one.
+       *  The queue is emptied afterwards, even if saving fails.
+       */
+      void Finish() {
+
+        if (m_queued.empty()) return;
+
+        // swap out queue so it's empty however this ends
+        std::vector<Queued> queued;
+        queued.swap(m_queued);
+
+        // fit everything at once
+        m_fitter.Fit();
+
+        // grab reference term (if any)
+        const ModulationBasis&    basis   = m_fitter.GetBasis();
+        const std::size_t         iref    = basis.FindTerm("Const");
+        const std::vector<double> ptEdges = PtEdges();
+
+        // collect amplitudes of each call and save
+        for (std::size_t iq = 0; iq < queued.size(); ++iq) {
+
+          const Queued& q = queued[iq];
+          q.ofile -> cd();
+          for (std::size_t iterm = 0; iterm < basis.GetNTerms(); ++iterm) {
+
+            if (iterm == iref) continue;
+
+            Type::PlotIndex iInt = q.index;
+            iInt.pt = HistInput::PtInt;
+
+            const std::string term = basis.GetTerm(iterm).name;
+            const std::string vsPt = m_input.MakeSpeciesTag("Amp" + term + "VsPtJet", q.index.species) + "_";
+            const std::string vsR  = m_input.MakeSpeciesTag("Amp" + term + "VsR", q.index.species) + "_";
+
+            Hist1D ampVsPt = m_fitter.MakeAmplitudeHist(
+              m_input.MakeHistName(q.variable, q.index, vsPt),
+              iterm,
+              ptEdges,
+              q.firstPt,
+              q.firstR,
+              iref
+            );
+            ampVsPt.SetXTitle("p_{T}^{jet} [GeV/c]");
+
+            Hist1D ampVsR = m_fitter.MakeAmplitudeHist(
+              m_input.MakeHistName(q.variable, iInt, vsR),
+              iterm,
+              q.rEdges,
+              q.firstR,
+              q.lastR,
+              iref
+            );
+            ampVsR.SetXTitle(q.rTitle);
+
+            TH1* rootVsPt = HistPool::Global().Acquire(ampVsPt, PlotOpts::DefaultPrecision());
+            TH1* rootVsR  = HistPool::Global().Acquire(ampVsR, PlotOpts::DefaultPrecision());
+            rootVsPt -> Write();
+            rootVsR  -> Write();
+            HistPool::Global().Release(rootVsPt);
+            HistPool::Global().Release(rootVsR);
+          }
+        }
+
+        // report failed fits
+        std::size_t nfail = 0;
+        for (std::size_t ifit = 0; ifit < m_fitter.GetNFits(); ++ifit) {
+          if (!m_fitter.GetFit(ifit).ok) ++nfail;
+        }
+        std::cout << "    Fit " << m_fitter.GetNFits() << " spectra of "
+                  << queued.size() << " variables/indices"
+                  << " (" << nfail << " failed)."
+                  << std::endl;
+
+        m_fitter.Clear();
+        return;
+
+      }  // end 'Finish()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ModulationFits()  {};
+      ~ModulationFits() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      ModulationFits(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end ModulationFits
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
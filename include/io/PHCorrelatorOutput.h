@@ -12,6 +12,8 @@
 #define PHCORRELATOROUTPUT_H
 
 // c++ utilities
+#include <exception>
+#include <iostream>
 #include <map>
 #include <string>
 #include <utility>
@@ -20,14 +22,25 @@
 #include <TFile.h>
 // plotting utilities
 #include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorClosureTests.h"
+#include "PHCorrelatorComparisons.h"
 #include "PHCorrelatorCorrectSpectra.h"
+#include "PHCorrelatorCovarianceSpectra.h"
+#include "PHCorrelatorFailureLog.h"
 #include "PHCorrelatorInput.h"
 #include "PHCorrelatorIOTypes.h"
+#include "PHCorrelatorModulationFits.h"
 #include "PHCorrelatorPlotIndexVector.h"
 #include "PHCorrelatorPPVsPAu.h"
+#include "PHCorrelatorPullMaps.h"
 #include "PHCorrelatorRecoVsData.h"
+#include "PHCorrelatorRehistogram.h"
+#include "PHCorrelatorReplicaBands.h"
 #include "PHCorrelatorSimVsData.h"
+#include "PHCorrelatorSpinAsymmetries.h"
 #include "PHCorrelatorSpinRatios.h"
+#include "PHCorrelatorSystematicVariations.h"
+#include "PHCorrelatorUnfoldSpectra.h"
 #include "PHCorrelatorVsPtJet.h"
 #include "../elements/PHCorrelatorPlotterElements.h"
 #include "../maker/PHCorrelatorPlotMaker.h"
@@ -48,7 +61,7 @@ namespace PHEnergyCorrelator {
 
       // enumerate outputs
       struct Plots {
-        enum EnuPlots {SimVsData, RecoVsData, VsPtJet, PPVsPAu, CorrectSpectra, SpinRatios};
+        enum EnuPlots {SimVsData, RecoVsData, VsPtJet, PPVsPAu, CorrectSpectra, SpinRatios, SpinAsymmetries, ModulationFits, UnfoldSpectra, ReplicaBands, SystematicVariations, ClosureTests, CovarianceSpectra, Comparisons, PullMaps, Rehistogram};
       };
 
       // for working with map of wirings
@@ -58,8 +71,9 @@ namespace PHEnergyCorrelator {
     private:
 
       // data members
-      bool    m_isInit;
-      Wirings m_outputs;
+      bool       m_isInit;
+      Wirings    m_outputs;
+      FailureLog m_failures;
 
       // ----------------------------------------------------------------------
       //! Initialize wirings
@@ -72,12 +86,65 @@ namespace PHEnergyCorrelator {
         m_outputs["RecoVsData"]     = new RecoVsData(m_index, m_maker, m_input);
         m_outputs["PPVsPAu"]        = new PPVsPAu(m_index, m_maker, m_input);
         m_outputs["CorrectSpectra"] = new CorrectSpectra(m_index, m_maker, m_input);
+        m_outputs["SpinAsymmetries"] = new SpinAsymmetries(m_index, m_maker, m_input);
+        m_outputs["ModulationFits"]  = new ModulationFits(m_index, m_maker, m_input);
+        m_outputs["UnfoldSpectra"]   = new UnfoldSpectra(m_index, m_maker, m_input);
+        m_outputs["ReplicaBands"]    = new ReplicaBands(m_index, m_maker, m_input);
+        m_outputs["SystematicVariations"] = new SystematicVariations(m_index, m_maker, m_input);
+        m_outputs["ClosureTests"]    = new ClosureTests(m_index, m_maker, m_input);
+        m_outputs["CovarianceSpectra"] = new CovarianceSpectra(m_index, m_maker, m_input);
+        m_outputs["Comparisons"]     = new Comparisons(m_index, m_maker, m_input);
+        m_outputs["PullMaps"]        = new PullMaps(m_index, m_maker, m_input);
+        m_outputs["Rehistogram"]     = new Rehistogram(m_index, m_maker, m_input);
         return;
 
       }  // end 'InitWirings()'
 
+      // ----------------------------------------------------------------------
+      //! Tag pairs compared from now on with the current index
+      // ----------------------------------------------------------------------
+      void SetMetricsContext(const std::string& variable) const {
+
+        std::vector<int> index;
+        index.push_back(m_index.level);
+        index.push_back(m_index.species);
+        index.push_back(m_index.pt);
+        index.push_back(m_index.cf);
+        index.push_back(m_index.chrg);
+        index.push_back(m_index.spin);
+        MetricsEngine::Global().SetContext(variable, index);
+        return;
+
+      }  // end 'SetMetricsContext(std::string&)'
+
     public:
 
+      // ----------------------------------------------------------------------
+      //! Record a failed plot
+      // ----------------------------------------------------------------------
+      /*! Called by `TryPlot1D/2D(...)`, and by steps run
+       *  outside of a wiring (e.g. reading ntuples) which
+       *  catch their own errors.
+       */
+      void RecordFailure(
+        const std::string& wiring,
+        const std::string& variable,
+        const std::string& what
+      ) {
+
+        std::cerr << "WARNING: " << wiring << " failed for " << variable << ", continuing!\n"
+                  << "         what = " << what
+                  << std::endl;
+        m_failures.Add( FailureLog::Failure(wiring, variable, m_index, what) );
+        return;
+
+      }  // end 'RecordFailure(std::string& x 3)'
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      FailureLog GetFailures() const {return m_failures;}
+
       // ----------------------------------------------------------------------
       //! Update a plot index
       // ----------------------------------------------------------------------
@@ -87,6 +154,7 @@ namespace PHEnergyCorrelator {
        */
       void UpdateIndex(const Type::PlotIndex& index) {
 
+        m_index = index;
         for (it_wire output = m_outputs.begin(); output != m_outputs.end(); ++output) {
           (output -> second) -> SetIndex(index);
         }
@@ -112,6 +180,123 @@ namespace PHEnergyCorrelator {
 
       }  // end 'Init()'
 
+      // ----------------------------------------------------------------------
+      //! Try making a 1D plot with a particular output
+      // ----------------------------------------------------------------------
+      /*! If errors are being collected (see `Error::Collect`), a
+       *  failure is recorded against the current index and the
+       *  sweep carries on. Otherwise equivalent to calling
+       *  `MakePlot1D(...)` on the wiring directly. Pairs handed
+       *  to the metrics engine are tagged with the variable and
+       *  current index.
+       *
+       *  \param wiring   which output wiring to use
+       *  \param variable what variable (spectra) is being plotted
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      bool TryPlot1D(
+        const std::string& wiring,
+        const std::string& variable,
+        const int opt,
+        TFile* ofile,
+        const int nrebin = 1
+      ) {
+
+        SetMetricsContext(variable);
+        if (Error::GetMode() != Error::Collect) {
+          m_outputs.at(wiring) -> MakePlot1D(variable, opt, ofile, nrebin);
+          return true;
+        }
+
+        try {
+          m_outputs.at(wiring) -> MakePlot1D(variable, opt, ofile, nrebin);
+        } catch (const std::exception& error) {
+          RecordFailure(wiring, variable, error.what());
+          return false;
+        }
+        return true;
+
+      }  // end 'TryPlot1D(std::string& x 2, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! Try making a 2D plot with a particular output
+      // ----------------------------------------------------------------------
+      /*! See `TryPlot1D(...)`.
+       *
+       *  \param wiring   which output wiring to use
+       *  \param variable what variable (spectra) is being plotted
+       *  \param ofile    what file to write output to
+       */
+      bool TryPlot2D(
+        const std::string& wiring,
+        const std::string& variable,
+        TFile* ofile
+      ) {
+
+        SetMetricsContext(variable);
+        if (Error::GetMode() != Error::Collect) {
+          m_outputs.at(wiring) -> MakePlot2D(variable, ofile);
+          return true;
+        }
+
+        try {
+          m_outputs.at(wiring) -> MakePlot2D(variable, ofile);
+        } catch (const std::exception& error) {
+          RecordFailure(wiring, variable, error.what());
+          return false;
+        }
+        return true;
+
+      }  // end 'TryPlot2D(std::string& x 2, TFile*)'
+
+      // ----------------------------------------------------------------------
+      //! Try finishing work queued by a particular output
+      // ----------------------------------------------------------------------
+      /*! Should be called once after the index loop. Failures
+       *  are handled as in `TryPlot1D(...)`.
+       *
+       *  \param wiring which output wiring to finish
+       */
+      bool TryFinish(const std::string& wiring) {
+
+        if (Error::GetMode() != Error::Collect) {
+          m_outputs.at(wiring) -> Finish();
+          return true;
+        }
+
+        try {
+          m_outputs.at(wiring) -> Finish();
+        } catch (const std::exception& error) {
+          RecordFailure(wiring, "Finish", error.what());
+          return false;
+        }
+        return true;
+
+      }  // end 'TryFinish(std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Report any failed plots
+      // ----------------------------------------------------------------------
+      /*! Prints a summary and, if anything failed, writes
+       *  the failure report to the provided file.
+       *
+       *  \param name file to write report to
+       */
+      void ReportFailures(const std::string& name) const {
+
+        if (m_failures.Empty()) {
+          std::cout << "    No failed plots." << std::endl;
+          return;
+        }
+
+        std::cout << "    WARNING: " << m_failures.Size() << " plots failed! See " << name << std::endl;
+        m_failures.Write(name);
+        return;
+
+      }  // end 'ReportFailures(std::string&)'
+
       // ----------------------------------------------------------------------
       //! Access a particular output
       // ----------------------------------------------------------------------
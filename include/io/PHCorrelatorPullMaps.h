@@ -0,0 +1,121 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorPullMaps.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to make 2D pull maps of data
+ *  vs. simulation
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORPULLMAPS_H
+#define PHCORRELATORPULLMAPS_H
+
+// c++ utilities
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Pull Maps Output Wiring
+  // ==========================================================================
+  /*! Wiring to make maps of the bin-by-bin pulls of 2D
+   *  spectra in data vs. reco- and truth-level simulation.
+   *  The most significant cells of each map are kept in
+   *  the shared pull map's table (PullMap::Global()).
+   */
+  class PullMaps : public BaseOutput {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Make 2D pull maps
+      // ----------------------------------------------------------------------
+      /*! \param variable what variable (spectra) is being plotted
+       *  \param ofile    what file to write output to
+       */
+      void MakePlot2D(const std::string& variable, TFile* ofile) {
+
+        // constrain level indices
+        Type::PlotIndex iData = m_index;
+        Type::PlotIndex iReco = m_index;
+        Type::PlotIndex iTrue = m_index;
+        iData.level = FileInput::Data;
+        iReco.level = FileInput::Reco;
+        iTrue.level = FileInput::True;
+
+        // make canvas name and tag
+        const std::string tag    = m_input.MakeSpeciesTag("Pulls", m_index.species) + "_";
+        const std::string canvas = m_input.MakeCanvasName("cPulls" + variable, m_index);
+
+        // bundle input options
+        PlotInput dat_opt = PlotInput(
+          m_input.GetFiles().GetFile(iData),
+          m_input.MakeHistName(variable, iData),
+          m_input.MakeHistName(variable, iData, tag),
+          m_input.MakeLegend(iData),
+          "colz"
+        );
+        PlotInput rec_opt = PlotInput(
+          m_input.GetFiles().GetFile(iReco),
+          m_input.MakeHistName(variable, iReco),
+          m_input.MakeHistName(variable, iReco, tag),
+          m_input.MakeLegend(iReco),
+          "colz"
+        );
+        PlotInput tru_opt = PlotInput(
+          m_input.GetFiles().GetFile(iTrue),
+          m_input.MakeHistName(variable, iTrue),
+          m_input.MakeHistName(variable, iTrue, tag),
+          m_input.MakeLegend(iTrue),
+          "colz"
+        );
+
+        // data vs. reco, data vs. truth
+        std::vector<PlotInput> denominators;
+        std::vector<PlotInput> numerators;
+        denominators.push_back( rec_opt );
+        denominators.push_back( tru_opt );
+        numerators.push_back( dat_opt );
+        numerators.push_back( dat_opt );
+
+        // rename data so each map gets a unique name
+        numerators[0].rename = m_input.MakeHistName(variable, iData, tag + "VsReco_");
+        numerators[1].rename = m_input.MakeHistName(variable, iData, tag + "VsTrue_");
+
+        // make plot
+        m_maker.GetPlotPulls2D().Configure(denominators, numerators, canvas);
+        m_maker.GetPlotPulls2D().Plot(ofile);
+        return;
+
+      }  // end 'MakePlot2D(std::string&, TFile*)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      PullMaps()  {};
+      ~PullMaps() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      PullMaps(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end PullMaps
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,226 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorRehistogram.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to re-histogram spectra from
+ *  pair-level ntuples.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORREHISTOGRAM_H
+#define PHCORRELATORREHISTOGRAM_H
+
+// c++ utilities
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TMath.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Re-histogram Output Wiring
+  // ==========================================================================
+  /*! Wiring to register spectra to be refilled from
+   *  pair-level ntuples with the shared ntuple filler
+   *  (NtupleFiller::Global()). Each spectrum is named
+   *  as its pre-filled version, uses the binning set
+   *  for its variable (see `SetColumn(...)`), and
+   *  selects pairs with cuts matching its plot index.
+   *
+   *  Filling happens after all spectra are registered,
+   *  so that each ntuple is only read once.
+   */
+  class Rehistogram : public BaseOutput {
+
+    public:
+
+      // ======================================================================
+      //! What to histogram for a variable
+      // ======================================================================
+      struct Column {
+
+        // members
+        std::string    column;  ///!< column to histogram
+        std::string    weight;  ///!< column to weight by
+        Binning::Edges edges;   ///!< bin edges
+
+        // --------------------------------------------------------------------
+        //! default ctor
+        // --------------------------------------------------------------------
+        Column() : column(""), weight("") {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting arguments
+        // --------------------------------------------------------------------
+        Column(const std::string& column_arg, const std::string& weight_arg, const Binning::Edges& edges_arg)
+          : column(column_arg), weight(weight_arg), edges(edges_arg) {};
+
+      };  // end Column
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Columns of each variable
+      // ----------------------------------------------------------------------
+      /*! Defaults to 75 log bins in R_L for the EEC, and 32
+       *  uniform bins in (-pi, pi) for the modulation angles,
+       *  all weighted by the EEC weight.
+       */
+      static std::map<std::string, Column>& Columns() {
+
+        static std::map<std::string, Column> columns;
+        static bool                          loaded = false;
+        if (!loaded) {
+          const Binning::Edges rl    = Binning::MakeLog(75, 1e-5, 1.);
+          const Binning::Edges angle = Binning::MakeUniform(32, -TMath::Pi(), TMath::Pi());
+          columns["EEC"]             = Column("rl", "eecWeight", rl);
+          columns["CollinsBlue"]     = Column("phiCollB", "eecWeight", angle);
+          columns["CollinsYell"]     = Column("phiCollY", "eecWeight", angle);
+          columns["BoerMuldersBlue"] = Column("phiBoerB", "eecWeight", angle);
+          columns["BoerMuldersYell"] = Column("phiBoerY", "eecWeight", angle);
+          loaded = true;
+        }
+        return columns;
+
+      }  // end 'Columns()'
+
+      // ----------------------------------------------------------------------
+      //! Make cuts selecting pairs of current index
+      // ----------------------------------------------------------------------
+      std::vector<NtupleFiller::Cut> MakeCuts() const {
+
+        const double big = std::numeric_limits<double>::max();
+        const double eps = std::numeric_limits<double>::min();
+
+        std::vector<NtupleFiller::Cut> cuts;
+        switch (m_index.pt) {
+          case HistInput::Pt5:
+            cuts.push_back( NtupleFiller::Cut("ptJet", 5., 10.) );
+            break;
+          case HistInput::Pt10:
+            cuts.push_back( NtupleFiller::Cut("ptJet", 10., 15.) );
+            break;
+          case HistInput::Pt15:
+            cuts.push_back( NtupleFiller::Cut("ptJet", 15., 20.) );
+            break;
+          case HistInput::PtInt:
+            cuts.push_back( NtupleFiller::Cut("ptJet", 5., big) );
+            break;
+          default:
+            break;
+        }
+        switch (m_index.cf) {
+          case HistInput::CFLow:
+            cuts.push_back( NtupleFiller::Cut("cfJet", 0., 0.5) );
+            break;
+          case HistInput::CFHigh:
+            cuts.push_back( NtupleFiller::Cut("cfJet", 0.5, 1.5) );
+            break;
+          default:
+            break;
+        }
+        // charge indices follow the legends (see HistInput)
+        switch (m_index.chrg) {
+          case HistInput::Pos:
+            cuts.push_back( NtupleFiller::Cut("chargeJet", -big, 0.) );
+            break;
+          case HistInput::Neg:
+            cuts.push_back( NtupleFiller::Cut("chargeJet", eps, big) );
+            break;
+          default:
+            break;
+        }
+
+        // spins are stored as +1 (up) or -1 (down)
+        const bool blueUp   = (m_index.spin == HistInput::BU)   || (m_index.spin == HistInput::BUYU) || (m_index.spin == HistInput::BUYD);
+        const bool blueDown = (m_index.spin == HistInput::BD)   || (m_index.spin == HistInput::BDYU) || (m_index.spin == HistInput::BDYD);
+        const bool yellUp   = (m_index.spin == HistInput::YU)   || (m_index.spin == HistInput::BUYU) || (m_index.spin == HistInput::BDYU);
+        const bool yellDown = (m_index.spin == HistInput::YD)   || (m_index.spin == HistInput::BUYD) || (m_index.spin == HistInput::BDYD);
+        if (blueUp)   cuts.push_back( NtupleFiller::Cut("spinB", 0., 2.) );
+        if (blueDown) cuts.push_back( NtupleFiller::Cut("spinB", -2., 0.) );
+        if (yellUp)   cuts.push_back( NtupleFiller::Cut("spinY", 0., 2.) );
+        if (yellDown) cuts.push_back( NtupleFiller::Cut("spinY", -2., 0.) );
+        return cuts;
+
+      }  // end 'MakeCuts()'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Set what to histogram for a variable
+      // ----------------------------------------------------------------------
+      static void SetColumn(const std::string& variable, const Column& column) {
+
+        Columns()[variable] = column;
+        return;
+
+      }  // end 'SetColumn(std::string&, Column&)'
+
+      // ----------------------------------------------------------------------
+      //! Register a 1D spectrum to re-histogram
+      // ----------------------------------------------------------------------
+      /*! The remaining arguments are unused: spectra are
+       *  written once every ntuple has been read (see
+       *  `NtupleFiller::Write(...)`).
+       *
+       *  \param variable what variable (spectra) is being plotted
+       */
+      void MakePlot1D(
+        const std::string& variable,
+        const int /*opt*/,
+        TFile* /*ofile*/,
+        const int /*nrebin*/ = 1
+      ) {
+
+        std::map<std::string, Column>::const_iterator column = Columns().find(variable);
+        if (column == Columns().end()) {
+          std::cerr << "PANIC: no ntuple column set for variable '" << variable << "'!" << std::endl;
+          Error::Raise("no ntuple column set for variable '" + variable + "'");
+          assert(column != Columns().end());
+        }
+
+        NtupleFiller::Global().AddTarget(
+          m_input.MakeHistName(variable, m_index),
+          m_input.GetFiles().GetFile(m_index),
+          column -> second.column,
+          column -> second.weight,
+          column -> second.edges,
+          MakeCuts()
+        );
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Rehistogram()  {};
+      ~Rehistogram() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      Rehistogram(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end Rehistogram
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
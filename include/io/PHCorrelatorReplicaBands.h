@@ -0,0 +1,144 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorReplicaBands.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to estimate uncertainties on
+ *  corrected spectra from replicas
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORREPLICABANDS_H
+#define PHCORRELATORREPLICABANDS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Replica Bands Output Wiring
+  // ==========================================================================
+  /*! Wiring to rerun the bin-by-bin correction chain
+   *  (see CorrectionChain) on replicas of the data, reco,
+   *  and truth spectra with the shared replica engine
+   *  (ReplicaEngine::Global()). Each input is fluctuated
+   *  independently.
+   *
+   *  Note that this IGNORES the correlation between reco
+   *  and truth: they come from the same simulated events,
+   *  but only share part of their counts, which can't be
+   *  grouped (that would make them fully correlated) and
+   *  isn't known bin-by-bin here. Since the correction is
+   *  truth / reco, the shared events partly cancel, so the
+   *  bands are conservative (too wide) where reco and truth
+   *  overlap strongly. This is noted in the title of each
+   *  saved histogram and printed with each call.
+   */
+  class ReplicaBands : public BaseOutput {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Estimate bands on 1D corrected spectra
+      // ----------------------------------------------------------------------
+      /*! For each jet pt bin, writes the nominal corrected
+       *  spectrum with the band as its error, along with the
+       *  replicas' median and lower/upper percentiles.
+       *
+       *  \param variable what variable (spectra) is being corrected
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        // normalize like CorrectSpectra1D
+        PlotOpts options;
+        options.norm_range = Default::NormRange(opt);
+
+        // fluctuate data, reco & truth independently (the
+        // reco/truth correlation is ignored, see above)
+        ReplicaEngine& engine = ReplicaEngine::Global();
+        engine.SetGroups(std::vector<int>());
+
+        // jet pt bins to correct
+        const std::vector<int> pts = GetPtBins();
+
+        // make tag
+        const std::string tag = m_input.MakeSpeciesTag("Replica1D", m_index.species) + "_";
+
+        const CorrectionChain chain(options);
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          // constrain level, pt indices
+          const LevelIndices     levels = MakeLevelIndices(pts[ipt]);
+          const Type::PlotIndex& iData  = levels.data;
+          const Type::PlotIndex& iReco  = levels.reco;
+          const Type::PlotIndex& iTrue  = levels.truth;
+
+          // load inputs
+          const int nmerge = GetNMerge(nrebin, opt, pts[ipt]);
+
+          std::vector<Hist1D> inputs;
+          inputs.push_back( Load1D(variable, iData, nmerge) );
+          inputs.push_back( Load1D(variable, iReco, nmerge) );
+          inputs.push_back( Load1D(variable, iTrue, nmerge) );
+          inputs[0].SetName( m_input.MakeHistName(variable, iData, tag) );
+
+          // run replicas & save
+          const ReplicaBand band    = engine.Run(chain, inputs);
+          const Hist1D      nominal = band.MakeNominalWithBand();
+
+          std::vector<Hist1D> outputs;
+          outputs.push_back(nominal);
+          outputs.push_back(band.median);
+          outputs.push_back(band.low);
+          outputs.push_back(band.high);
+
+          ofile -> cd();
+          for (std::size_t iout = 0; iout < outputs.size(); ++iout) {
+            outputs[iout].SetTitle( outputs[iout].GetTitle() + " (reco/truth correlation ignored)" );
+            TH1* hist = HistPool::Global().Acquire( outputs[iout], PlotOpts::DefaultPrecision() );
+            hist -> Write();
+            HistPool::Global().Release(hist);
+          }
+        }
+        std::cout << "    Ran " << engine.GetNReplicas() << " replicas for " << variable << ".\n"
+                  << "      Note: reco and truth were fluctuated independently, ignoring their correlation."
+                  << std::endl;
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      ReplicaBands()  {};
+      ~ReplicaBands() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      ReplicaBands(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end ReplicaBands
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -0,0 +1,190 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorSpinAsymmetries.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to calculate spin asymmetries
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORSPINASYMMETRIES_H
+#define PHCORRELATORSPINASYMMETRIES_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Spin Asymmetries Output Wiring
+  // ==========================================================================
+  /*! Wiring to calculate single- and double-spin asymmetries
+   *  of data. Asymmetries are computed by the shared engine
+   *  (AsymmetryEngine::Global()), which also collects them
+   *  into a table over the whole sweep.
+   */
+  class SpinAsymmetries : public BaseOutput {
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Helper method to build input for a spin state
+      // ----------------------------------------------------------------------
+      PlotInput MakeInput(
+        const std::string& variable,
+        const Type::PlotIndex& index,
+        const int opt,
+        const int nrebin
+      ) {
+
+        return PlotInput(
+          m_input.GetFiles().GetFile(index),
+          m_input.MakeHistName(variable, index),
+          m_input.MakeHistName(variable, index),
+          m_input.MakeLegend(index),
+          "",
+          Style::Plot(),
+          IsRebinned(opt, index.pt) ? Rebin(true, nrebin) : Rebin(false)
+        );
+
+      }  // end 'MakeInput(std::string&, Type::PlotIndex&, int x 2)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Calculate 1D spin asymmetries
+      // ----------------------------------------------------------------------
+      /*! Loads the (unnormalized) spin-sorted data spectra of
+       *  the current index once and queues blue, yellow, and
+       *  double-spin asymmetries as appropriate: variables
+       *  tied to one beam (e.g. "CollinsBlue") skip the other
+       *  beam's single-spin asymmetry, and pAu only gets blue
+       *  ones. Results are written to the output file.
+       *
+       *  \param variable what variable (spectra) is being plotted
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        // determine which asymmetries to calculate
+        const bool isPAu    = m_input.IsPAu(m_index);
+        const bool doBlue   = (variable.find("Yell") == std::string::npos);
+        const bool doYellow = !isPAu && (variable.find("Blue") == std::string::npos);
+        const bool doDouble = !isPAu;
+
+        // spin states to load
+        std::vector<int> spins;
+        if (doBlue) {
+          spins.push_back(HistInput::BU);
+          spins.push_back(HistInput::BD);
+        }
+        if (doYellow) {
+          spins.push_back(HistInput::YU);
+          spins.push_back(HistInput::YD);
+        }
+        if (doDouble) {
+          spins.push_back(HistInput::BUYU);
+          spins.push_back(HistInput::BUYD);
+          spins.push_back(HistInput::BDYU);
+          spins.push_back(HistInput::BDYD);
+        }
+
+        // load each state once, without normalizing
+        Type::PlotIndex iData = m_index;
+        iData.level = FileInput::Data;
+
+        PlotOpts raw;
+        raw.do_norm = false;
+
+        SpinRatioEngine states;
+        for (std::size_t isp = 0; isp < spins.size(); ++isp) {
+          Type::PlotIndex iSpin = iData;
+          iSpin.spin = spins[isp];
+          states.Load(spins[isp], MakeInput(variable, iSpin, opt, nrebin), raw);
+        }
+
+        // queue asymmetries (dropping anything left over from a
+        // call which failed part way)
+        AsymmetryEngine& engine = AsymmetryEngine::Global();
+        const int        group  = m_index.species;
+        engine.ClearQueue();
+        engine.ClearResults();
+        if (doBlue) {
+          engine.AddSingle(
+            m_input.MakeHistName(variable, iData, m_input.MakeSpeciesTag("AsymBlue", m_index.species) + "_"),
+            AsymmetryEngine::Blue,
+            states.GetState(HistInput::BU),
+            states.GetState(HistInput::BD),
+            group
+          );
+        }
+        if (doYellow) {
+          engine.AddSingle(
+            m_input.MakeHistName(variable, iData, m_input.MakeSpeciesTag("AsymYell", m_index.species) + "_"),
+            AsymmetryEngine::Yellow,
+            states.GetState(HistInput::YU),
+            states.GetState(HistInput::YD),
+            group
+          );
+        }
+        if (doDouble) {
+          engine.AddDouble(
+            m_input.MakeHistName(variable, iData, m_input.MakeSpeciesTag("AsymDouble", m_index.species) + "_"),
+            states.GetState(HistInput::BUYU),
+            states.GetState(HistInput::BDYD),
+            states.GetState(HistInput::BUYD),
+            states.GetState(HistInput::BDYU),
+            group
+          );
+        }
+
+        // calculate and save
+        const std::size_t first = engine.Compute();
+        ofile -> cd();
+        for (std::size_t iasym = first; iasym < engine.GetNResults(); ++iasym) {
+          TH1* hist = HistPool::Global().Acquire( engine.GetResult(iasym), PlotOpts::DefaultPrecision() );
+          hist -> Write();
+          HistPool::Global().Release(hist);
+        }
+        std::cout << "    Calculated " << engine.GetNResults() - first
+                  << " spin asymmetries for " << variable << "."
+                  << std::endl;
+
+        // results are written (and tabulated), so drop them
+        engine.ClearResults();
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      SpinAsymmetries()  {};
+      ~SpinAsymmetries() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      SpinAsymmetries(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end SpinAsymmetries
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -37,7 +37,10 @@ namespace PHEnergyCorrelator {
       // ----------------------------------------------------------------------
       //! Make 1D spin ratios plot
       // ----------------------------------------------------------------------
-      /*! Wiring to make a 1D spin ratios plot.
+      /*! Wiring to make a 1D spin ratios plot. Each spin state
+       *  of each level is loaded once, all ratios are computed
+       *  in one pass (see SpinRatioEngine), and then a canvas is
+       *  drawn for each combination of spins.
        *
        *  \param variable what variable (spectra) is being plotted
        *  \param opt      what axis option to use
@@ -88,7 +91,13 @@ namespace PHEnergyCorrelator {
         std::pair<std::size_t, std::size_t> rec_mar = std::make_pair(25, 21);
         std::pair<std::size_t, std::size_t> tru_mar = std::make_pair(30, 29);
 
-        // now loop through combos and make plots
+        // engines to hold spectra of each level
+        //   - [0] = data, [1] = reco, [2] = true
+        std::vector<SpinRatioEngine> engines(3);
+
+        // first configure a plot for each combo, loading
+        // any spin states not yet seen along the way
+        std::vector<PlotRatios1D::Params> params;
         for (std::size_t isp = 0; isp < spins.size(); ++isp) {
 
           // replicate indices and constrain spins
@@ -242,9 +251,35 @@ namespace PHEnergyCorrelator {
             )
           );
 
-          // make plot
+          // configure plot and load spectra
           m_maker.GetPlotRatios1D().Configure(in_dens, in_nums, canvas, opt);
-          m_maker.GetPlotRatios1D().Plot(ofile);
+          params.push_back( m_maker.GetPlotRatios1D().GetParams() );
+          for (std::size_t ilvl = 0; ilvl < engines.size(); ++ilvl) {
+            engines[ilvl].Load(spins[isp].first, in_nums[ilvl], params.back().options);
+            engines[ilvl].Load(spins[isp].second, in_dens[ilvl], params.back().options);
+          }
+        }
+
+        // then calculate all ratios at once
+        for (std::size_t ilvl = 0; ilvl < engines.size(); ++ilvl) {
+          engines[ilvl].Compute(spins);
+        }
+        std::cout << "    Calculated " << spins.size() << " spin ratios for each level." << std::endl;
+
+        // and finally make plots from shared results
+        for (std::size_t isp = 0; isp < spins.size(); ++isp) {
+
+          std::vector<Hist1D> nums;
+          std::vector<Hist1D> dens;
+          std::vector<Hist1D> rats;
+          for (std::size_t ilvl = 0; ilvl < engines.size(); ++ilvl) {
+            nums.push_back( engines[ilvl].GetState(spins[isp].first) );
+            dens.push_back( engines[ilvl].GetState(spins[isp].second) );
+            rats.push_back( engines[ilvl].GetRatio(isp) );
+          }
+
+          m_maker.GetPlotRatios1D().SetParams( params[isp] );
+          m_maker.GetPlotRatios1D().PlotNative(dens, nums, rats, ofile);
         }
         return;
 
@@ -0,0 +1,176 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorSystematicVariations.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to evaluate systematic variations
+ *  of corrected spectra
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORSYSTEMATICVARIATIONS_H
+#define PHCORRELATORSYSTEMATICVARIATIONS_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+#include "../maker/PHCorrelatorPlotMaker.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Systematic Variations Output Wiring
+  // ==========================================================================
+  /*! Wiring to rerun the bin-by-bin correction chain (see
+   *  CorrectionChain) on the nominal inputs and on every
+   *  variation declared in the shared variation engine
+   *  (VariationEngine::Global()) in one pass. Variations
+   *  override files of the nominal FileInput, and inputs
+   *  common to several variations are only read once.
+   */
+  class SystematicVariations : public BaseOutput {
+
+    private:
+
+      // ----------------------------------------------------------------------
+      //! Helper method to collect inputs of a variation
+      // ----------------------------------------------------------------------
+      /*! \param ivar    index of variation (-1 for nominal)
+       *  \param indices (data, reco, truth) indices to load
+       *  \param hists   names of (data, reco, truth) spectra
+       *  \param nrebin  number of bins to merge if rebinning
+       */
+      std::vector<Hist1D> Collect(
+        const int ivar,
+        const std::vector<Type::PlotIndex>& indices,
+        const std::vector<std::string>& hists,
+        const int nrebin
+      ) {
+
+        VariationEngine& engine = VariationEngine::Global();
+
+        std::vector<Hist1D> inputs;
+        for (std::size_t iin = 0; iin < indices.size(); ++iin) {
+          const std::string nominal = m_input.GetFiles().GetFile(indices[iin]);
+          const std::string file    = (ivar < 0)
+                                    ? nominal
+                                    : engine.ResolveFile(ivar, indices[iin].species, indices[iin].level, nominal);
+          inputs.push_back( engine.Load(file, hists[iin], nrebin) );
+        }
+        return inputs;
+
+      }  // end 'Collect(int, std::vector<Type::PlotIndex>&, std::vector<std::string>&, int)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Evaluate variations of 1D corrected spectra
+      // ----------------------------------------------------------------------
+      /*! For each jet pt bin, writes the nominal corrected
+       *  spectrum, its delta for each variation, and the
+       *  envelope of the deltas.
+       *
+       *  \param variable what variable (spectra) is being corrected
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        VariationEngine& engine = VariationEngine::Global();
+
+        // normalize like CorrectSpectra1D
+        PlotOpts options;
+        options.norm_range = Default::NormRange(opt);
+
+        // jet pt bins to correct
+        const std::vector<int> pts = GetPtBins();
+
+        // make tag
+        const std::string tag = m_input.MakeSpeciesTag("Syst1D", m_index.species) + "_";
+
+        const CorrectionChain chain(options);
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          // constrain level, pt indices
+          const LevelIndices levels = MakeLevelIndices(pts[ipt]);
+
+          std::vector<Type::PlotIndex> indices;
+          indices.push_back(levels.data);
+          indices.push_back(levels.reco);
+          indices.push_back(levels.truth);
+
+          std::vector<std::string> hists;
+          for (std::size_t iin = 0; iin < indices.size(); ++iin) {
+            hists.push_back( m_input.MakeHistName(variable, indices[iin]) );
+          }
+
+          // load nominal & variations (shared inputs are only read once)
+          const int nmerge = GetNMerge(nrebin, opt, pts[ipt]);
+          const std::string name = m_input.MakeHistName(variable, indices[0], tag);
+
+          std::vector<Hist1D> nominal = Collect(-1, indices, hists, nmerge);
+          nominal[0].SetName(name);
+
+          std::vector<std::vector<Hist1D> > varied;
+          for (std::size_t ivar = 0; ivar < engine.GetNVariations(); ++ivar) {
+            varied.push_back( Collect(ivar, indices, hists, nmerge) );
+            varied.back()[0].SetName(name);
+          }
+
+          // evaluate everything & save
+          const VariationResult result = engine.Run(chain, nominal, varied);
+
+          std::vector<const Hist1D*> outputs;
+          outputs.push_back(&result.nominal);
+          outputs.push_back(&result.envelope);
+          for (std::size_t ivar = 0; ivar < result.deltas.size(); ++ivar) {
+            outputs.push_back(&result.deltas[ivar]);
+          }
+
+          ofile -> cd();
+          for (std::size_t iout = 0; iout < outputs.size(); ++iout) {
+            TH1* hist = HistPool::Global().Acquire( *outputs[iout], PlotOpts::DefaultPrecision() );
+            hist -> Write();
+            HistPool::Global().Release(hist);
+          }
+        }
+        std::cout << "    Evaluated " << engine.GetNVariations() << " variations for " << variable
+                  << " (" << engine.GetNLoads() << " spectra loaded so far)."
+                  << std::endl;
+
+        // spectra aren't reused by the next index
+        engine.ClearLoaded();
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      SystematicVariations()  {};
+      ~SystematicVariations() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      SystematicVariations(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end SystematicVariations
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
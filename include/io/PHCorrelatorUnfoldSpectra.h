@@ -0,0 +1,132 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorUnfoldSpectra.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  Output wiring to unfold spectra
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORUNFOLDSPECTRA_H
+#define PHCORRELATORUNFOLDSPECTRA_H
+
+// c++ utilities
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+// plotting utilities
+#include "PHCorrelatorBaseOutput.h"
+#include "PHCorrelatorIOTypes.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! Unfolded Spectra Output Wiring
+  // ==========================================================================
+  /*! Wiring to unfold data spectra with the shared
+   *  iterative unfolder (Unfolder::Global()), as an
+   *  alternative to bin-by-bin corrections.
+   *
+   *  The response of a variable is expected in the reco-
+   *  level file under the name of the reco-level spectrum
+   *  with the variable suffixed by "Response" (e.g.
+   *  "hRecoJetEECResponseStat_pt0"), with reco on x and
+   *  truth on y. Which spin state's response is used is set
+   *  by the correction store's key policy, and responses
+   *  are only loaded once per sweep.
+   */
+  class UnfoldSpectra : public BaseOutput {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Unfold 1D spectra
+      // ----------------------------------------------------------------------
+      /*! Unfolds the data spectrum of each jet pt bin of the
+       *  current index in one batch and writes them out.
+       *
+       *  \param variable what variable (spectra) is being unfolded
+       *  \param opt      what axis option to use
+       *  \param ofile    what file to write output to
+       *  \param nrebin   what number of bins to merge if rebinning
+       */
+      void MakePlot1D(const std::string& variable, const int opt, TFile* ofile, const int nrebin = 1) {
+
+        // jet pt bins to unfold
+        const std::vector<int> pts = GetPtBins();
+
+        // make tag
+        const std::string tag = m_input.MakeSpeciesTag("Unfold1D", m_index.species) + "_";
+
+        // drop anything left over from a call which failed
+        // part way (e.g. when collecting errors)
+        Unfolder& unfolder = Unfolder::Global();
+        unfolder.Clear();
+        for (std::size_t ipt = 0; ipt < pts.size(); ++ipt) {
+
+          // constrain level, pt indices
+          const LevelIndices     levels = MakeLevelIndices(pts[ipt]);
+          const Type::PlotIndex& iData  = levels.data;
+          const Type::PlotIndex& iReco  = levels.reco;
+          const Type::PlotIndex& iTrue  = levels.truth;
+
+          // determine rebinning
+          const int nmerge = GetNMerge(nrebin, opt, pts[ipt]);
+
+          // register response if need be
+          const std::string rfile = m_input.GetFiles().GetFile(iReco);
+          const std::string rhist = m_input.MakeHistName(variable + "Response", iReco);
+          const std::string key   = rfile + ":" + rhist + ":" + Tools::StringifyIndex(nmerge);
+          if (!unfolder.HasResponse(key)) {
+
+            const Hist2D response = Load2D(variable + "Response", iReco, nmerge);
+            const Hist1D truth    = Load1D(variable, iTrue, nmerge);
+            unfolder.AddResponse(key, response, truth);
+            std::cout << "      Response = " << rfile << ":" << rhist << std::endl;
+          }
+
+          // grab data spectrum & queue it
+          unfolder.Add(m_input.MakeHistName(variable, iData, tag), Load1D(variable, iData, nmerge), key);
+        }
+
+        // unfold everything at once and save
+        const std::size_t first = unfolder.Unfold();
+        ofile -> cd();
+        for (std::size_t ires = first; ires < unfolder.GetNResults(); ++ires) {
+          TH1* hist = HistPool::Global().Acquire( unfolder.GetResult(ires), PlotOpts::DefaultPrecision() );
+          hist -> Write();
+          HistPool::Global().Release(hist);
+        }
+
+        // results are written, so no need to keep them
+        unfolder.Clear();
+        return;
+
+      }  // end 'MakePlot1D(std::string&, int, TFile*, int)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      UnfoldSpectra()  {};
+      ~UnfoldSpectra() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      UnfoldSpectra(const Type::PlotIndex& index, const PlotMaker& maker, const Input& input)
+        : BaseOutput(index, maker, input) {};
+
+  };  // end UnfoldSpectra
+
+}  // end PHEnergyCorrelator namesapce
+
+#endif
+
+/// end =======================================================================
@@ -13,6 +13,12 @@
 
 // c++ utilities
 #include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
 // plotting utilities
 #include "PHCorrelatorPlotMakerTypes.h"
 #include "../elements/PHCorrelatorPlotterElements.h"
@@ -53,6 +59,125 @@ namespace PHEnergyCorrelator {
 
       }  // end 'GenerateStyles(Type::Inputs&)'
 
+      // ----------------------------------------------------------------------
+      //! Load (rebin, and normalize) a 1D input
+      // ----------------------------------------------------------------------
+      /*! Takes the spectrum from the shared comparison tensor
+       *  if it already holds it (with the same normalization),
+       *  otherwise loads it from the shared-memory store (see
+       *  SharedStore) or, failing that, from file.
+       *
+       *  \param input   where to find the spectrum
+       *  \param options normalization options to apply
+       *  \param role    what the input is (for messages)
+       */
+      Hist1D Load1D(const PlotInput& input, const PlotOpts& options, const std::string& role) const {
+
+        const Hist1D* shared = ComparisonTensor::Global().Find(input, options);
+        if (shared) {
+          Hist1D native = *shared;
+          native.SetName( input.rename );
+          std::cout << "      Hist (" << role << ") = " << input.object << " [shared]" << std::endl;
+          return native;
+        }
+
+        // grab spectrum from shared memory or file
+        Hist1D native = Tools::LoadHist1D(input.file, input.object, 1, role);
+        native.SetName( input.rename );
+
+        // rebin if need be (adaptive rebinning
+        // is done by RebinCommon)
+        if (input.rebin.GetRebin() && !input.rebin.IsAdaptive()) {
+          input.rebin.Apply(native);
+          std::cout << "    Rebinned " << native.GetName() << std::endl;
+        }
+
+        // normalize if need be
+        if (options.do_norm) {
+          Tools::NormalizeByIntegral(
+            native,
+            options.norm_to,
+            options.norm_range.GetX().first,
+            options.norm_range.GetX().second
+          );
+          std::cout << "    Normalized " << native.GetName() << std::endl;
+        }
+        return native;
+
+      }  // end 'Load1D(PlotInput&, PlotOpts&, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Adaptively rebin all 1D spectra of a comparison together
+      // ----------------------------------------------------------------------
+      /*! If any input asks for adaptive rebinning, finds the
+       *  edges where every spectrum meets the (tightest)
+       *  target relative uncertainty, and rebins them all to
+       *  those edges. Merging sums bins, so spectra are then
+       *  normalized again like in `Load1D(...)`. Otherwise (or
+       *  if the spectra don't share a binning) does nothing.
+       *
+       *  \param inputs  inputs of the comparison
+       *  \param spectra loaded spectra of the comparison
+       *  \param options normalization options to reapply
+       */
+      void RebinCommon(
+        const Type::Inputs& inputs,
+        std::vector<Hist1D*> spectra,
+        const PlotOpts& options
+      ) const {
+
+        double target = 0.;
+        for (std::size_t iin = 0; iin < inputs.size(); ++iin) {
+          if (!inputs[iin].rebin.IsAdaptive()) continue;
+          const double intarget = inputs[iin].rebin.GetTarget();
+          target = (target > 0.) ? std::min(target, intarget) : intarget;
+        }
+        if ((target <= 0.) || spectra.empty()) return;
+
+        if (!AdaptiveRebin::Global().Apply(spectra, target)) return;
+        if (options.do_norm) {
+          for (std::size_t ispc = 0; ispc < spectra.size(); ++ispc) {
+            Tools::NormalizeByIntegral(
+              *spectra[ispc],
+              options.norm_to,
+              options.norm_range.GetX().first,
+              options.norm_range.GetX().second
+            );
+          }
+        }
+        std::cout << "    Adaptively rebinned " << spectra.size() << " spectra to "
+                  << spectra.front() -> GetNbins() << " bins (target = "
+                  << target << ")"
+                  << std::endl;
+        return;
+
+      }  // end 'RebinCommon(Type::Inputs&, std::vector<Hist1D*>, PlotOpts&)'
+
+      // ----------------------------------------------------------------------
+      //! Take the ratio of two 1D inputs
+      // ----------------------------------------------------------------------
+      /*! Takes the ratio from the shared comparison tensor if
+       *  it was computed there (with the same binning), otherwise
+       *  divides the spectra.
+       *  The pair is also handed to the metrics engine (if it's
+       *  collecting). Naming is left to the caller.
+       */
+      Hist1D Ratio1D(
+        const PlotInput& in_numer,
+        const Hist1D& numer,
+        const PlotInput& in_denom,
+        const Hist1D& denom,
+        const PlotOpts& options
+      ) const {
+
+        MetricsEngine::Global().Add(numer.GetName() + " vs. " + denom.GetName(), denom, numer);
+
+        const Hist1D* shared = ComparisonTensor::Global().FindRatio(in_numer, in_denom, options);
+
+        return (shared && shared -> IsCompatible(numer)) ? *shared : Tools::DivideHist1D(numer, denom);
+
+      }  // end 'Ratio1D(PlotInput&, Hist1D&, PlotInput&, Hist1D&, PlotOpts&)'
+
     public:
 
       // ----------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <vector>
 // root libraries
 #include <TCanvas.h>
 #include <TFile.h>
@@ -59,6 +60,9 @@ namespace PHEnergyCorrelator {
         Type::Shapes shapes;   ///!< additional shapes (e.g. lines) to draw
         PlotOpts     options;  ///!< auxilliary plot options
 
+        ///! keys to cache correction factors under (one per reco/truth pair, optional)
+        std::vector<CorrectionStore::Key> keys;
+
         // --------------------------------------------------------------------
         //! default ctor
         // --------------------------------------------------------------------
@@ -69,6 +73,7 @@ namespace PHEnergyCorrelator {
           unity   = PlotShape();
           shapes  = Type::Shapes();
           options = PlotOpts();
+          keys    = std::vector<CorrectionStore::Key>();
         }
 
         // --------------------------------------------------------------------
@@ -114,6 +119,15 @@ namespace PHEnergyCorrelator {
       // ----------------------------------------------------------------------
       void SetParams(const Params& params) {m_params = params;}
 
+      // ----------------------------------------------------------------------
+      //! Set keys to look up/store correction factors with
+      // ----------------------------------------------------------------------
+      /*! If set, correction factors are taken from (or added to)
+       *  CorrectionStore::Global() rather than being recomputed.
+       *  Call after Configure(...), which clears them.
+       */
+      void SetCorrectionKeys(const std::vector<CorrectionStore::Key>& keys) {m_params.keys = keys;}
+
       // ----------------------------------------------------------------------
       //! Configure routine
       // ----------------------------------------------------------------------
@@ -168,6 +182,7 @@ namespace PHEnergyCorrelator {
         m_params.truth   = in_true;
         m_params.options = plot_opts;
         m_params.unity   = Default::Unity(range_opt);
+        m_params.keys.clear();
         return;
 
       }  // end 'Configure(Inputs& x 3, std::string&, int)'
@@ -196,6 +211,7 @@ namespace PHEnergyCorrelator {
                     << "       reco inputs = " << m_params.recon.size() << "\n"
                     << "       true inputs = " << m_params.truth.size()
                     << std::endl;
+          Error::Raise("number of reconstructed and truth inputs should be the same");
           assert(m_params.recon.size() == m_params.truth.size());
         }
 
@@ -205,152 +221,183 @@ namespace PHEnergyCorrelator {
                     << "       data inputs = " << m_params.data.size() << "\n"
                     << "       reco inputs = " << m_params.recon.size()
                     << std::endl;
+          Error::Raise("number of raw and reconstructed inputs should be the same");
           assert(m_params.data.size() == m_params.recon.size());
         }
 
-        // open data inputs
-        std::vector<TFile*> dfiles;
-        std::vector<TH1*>   dhists;
+        // throw error if keys are set but don't match reco inputs
+        if (!m_params.keys.empty() && (m_params.keys.size() != m_params.recon.size())) {
+          std::cerr << "PANIC: number of correction keys and reconstructed inputs should be the same!\n"
+                    << "       keys        = " << m_params.keys.size() << "\n"
+                    << "       reco inputs = " << m_params.recon.size()
+                    << std::endl;
+          Error::Raise("number of correction keys and reconstructed inputs should be the same");
+          assert(m_params.keys.size() == m_params.recon.size());
+        }
+
+        // check which corrections have already been computed
+        CorrectionStore&                           store = CorrectionStore::Global();
+        std::vector<const CorrectionStore::Entry*> cached(m_params.recon.size(), NULL);
+        for (std::size_t ikey = 0; ikey < m_params.keys.size(); ++ikey) {
+          cached[ikey] = store.Find( m_params.keys[ikey] );
+        }
+
+        // load data inputs
+        std::vector<Hist1D> dnative;
         for (std::size_t idat = 0; idat < m_params.data.size(); ++idat) {
 
-          dfiles.push_back(
-            Tools::OpenFile(m_params.data[idat].file, "read")
-          );
-          dhists.push_back(
-            (TH1*) Tools::GrabObject( m_params.data[idat].object, dfiles.back() )
+          dnative.push_back(
+            Tools::LoadHist1D( m_params.data[idat].file, m_params.data[idat].object, 1, "data" )
           );
-          dhists.back() -> SetName( m_params.data[idat].rename.data() );
-          std::cout << "      File (data) = " << m_params.data[idat].file << "\n"
-                    << "      Hist (data) = " << m_params.data[idat].object
-                    << std::endl;
+          dnative.back().SetName( m_params.data[idat].rename );
 
           // rebin if need be
           if (m_params.data[idat].rebin.GetRebin()) {
-            m_params.data[idat].rebin.Apply(dhists.back());
-            std::cout << "    Rebinned " << dhists.back() -> GetName() << std::endl;
+            m_params.data[idat].rebin.Apply(dnative.back());
+            std::cout << "    Rebinned " << dnative.back().GetName() << std::endl;
           }
         }  // end data loop
 
-        // open reco inputs
-        std::vector<TFile*> rfiles;
-        std::vector<TH1*>   rhists;
+        // load reco inputs
+        std::vector<Hist1D> rnative;
         for (std::size_t irec = 0; irec < m_params.recon.size(); ++irec) {
 
-          rfiles.push_back(
-            Tools::OpenFile(m_params.recon[irec].file, "read")
-          );
-          rhists.push_back(
-            (TH1*) Tools::GrabObject( m_params.recon[irec].object, rfiles.back() )
+          // reuse stored reco if possible
+          if (cached[irec]) {
+            rnative.push_back( cached[irec] -> recon );
+            std::cout << "      Reusing stored correction for " << rnative.back().GetName() << std::endl;
+            continue;
+          }
+
+          rnative.push_back(
+            Tools::LoadHist1D( m_params.recon[irec].file, m_params.recon[irec].object, 1, "recon" )
           );
-          rhists.back() -> SetName( m_params.recon[irec].rename.data() );
-          std::cout << "      File (recon) = " << m_params.recon[irec].file << "\n"
-                    << "      Hist (recon) = " << m_params.recon[irec].object
-                    << std::endl;
+          rnative.back().SetName( m_params.recon[irec].rename );
 
           // rebin if need be
           if (m_params.recon[irec].rebin.GetRebin()) {
-            m_params.recon[irec].rebin.Apply(rhists.back());
-            std::cout << "    Rebinned " << rhists.back() -> GetName() << std::endl;
+            m_params.recon[irec].rebin.Apply(rnative.back());
+            std::cout << "    Rebinned " << rnative.back().GetName() << std::endl;
           }
 
           // normalize reco if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              rhists.back(),
+              rnative.back(),
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
             );
-            std::cout << "    Normalized " << rhists.back() -> GetName() << std::endl;
+            std::cout << "    Normalized " << rnative.back().GetName() << std::endl;
           }
         }  // end reco loop
 
-        // open true inputs
-        std::vector<TFile*> tfiles;
-        std::vector<TH1*>   thists;
+        // load true inputs
+        std::vector<Hist1D> tnative;
         for (std::size_t itru = 0; itru < m_params.truth.size(); ++itru) {
 
-          tfiles.push_back(
-            Tools::OpenFile(m_params.truth[itru].file, "read")
-          );
-          thists.push_back(
-            (TH1*) Tools::GrabObject( m_params.truth[itru].object, tfiles.back() )
+          // reuse stored truth if possible
+          if (cached[itru]) {
+            tnative.push_back( cached[itru] -> truth );
+            continue;
+          }
+
+          tnative.push_back(
+            Tools::LoadHist1D( m_params.truth[itru].file, m_params.truth[itru].object, 1, "truth" )
           );
-          thists.back() -> SetName( m_params.truth[itru].rename.data() );
-          std::cout << "      File (truth) = " << m_params.truth[itru].file << "\n"
-                    << "      Hist (truth) = " << m_params.truth[itru].object
-                    << std::endl;
+          tnative.back().SetName( m_params.truth[itru].rename );
 
           // rebin if need be
           if (m_params.truth[itru].rebin.GetRebin()) {
-            m_params.truth[itru].rebin.Apply(thists.back());
-            std::cout << "    Rebinned " << thists.back() -> GetName() << std::endl;
+            m_params.truth[itru].rebin.Apply(tnative.back());
+            std::cout << "    Rebinned " << tnative.back().GetName() << std::endl;
           }
 
           // normalize true if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              thists.back(),
+              tnative.back(),
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
             );
-            std::cout << "    Normalized " << thists.back() -> GetName() << std::endl;
+            std::cout << "    Normalized " << tnative.back().GetName() << std::endl;
           }
         }  // end true loop
 
         // calculate correction factors
-        std::vector<TH1*> chists;
-        for (std::size_t itru = 0; itru < thists.size(); ++itru) {
+        std::vector<Hist1D> cnative;
+        for (std::size_t itru = 0; itru < tnative.size(); ++itru) {
 
-          // create name
-          std::string name( thists[itru] -> GetName() );
-          name += "_CorrectionFactor";
+          // reuse stored factor if possible
+          if (cached[itru]) {
+            cnative.push_back( cached[itru] -> factor );
+            continue;
+          }
 
-          // do division
-          chists.push_back( Tools::DivideHist1D(rhists[itru], thists[itru]) );
-          chists.back() -> SetName( name.data() );
+          cnative.push_back( Tools::DivideHist1D(rnative[itru], tnative[itru]) );
+          cnative.back().SetName( tnative[itru].GetName() + "_CorrectionFactor" );
+
+          // and store for later if need be
+          if (!m_params.keys.empty()) {
+            store.Store(
+              m_params.keys[itru],
+              CorrectionStore::Entry(rnative[itru], tnative[itru], cnative.back())
+            );
+          }
         }
         std::cout << "    Calculated correction factors." << std::endl;
 
         // apply correction factors
-        for (std::size_t idat = 0; idat < dhists.size(); ++idat) {
-
-          // create name
-          std::string name( dhists[idat] -> GetName() );
-          name += "_Corrected";
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
 
           // divide by (reco / true)
-          dhists[idat] = Tools::DivideHist1D( dhists[idat], chists[idat] );
-          dhists[idat] -> SetName( name.data() );
+          const std::string name = dnative[idat].GetName() + "_Corrected";
+          dnative[idat] = Tools::DivideHist1D( dnative[idat], cnative[idat] );
+          dnative[idat].SetName( name );
 
           // normalize corrected spectrum if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              dhists[idat],
+              dnative[idat],
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
             );
-            std::cout << "    Normalized " << dhists[idat] -> GetName() << std::endl;
+            std::cout << "    Normalized " << dnative[idat].GetName() << std::endl;
           }
         }
         std::cout << "    Applied correction factors." << std::endl;
 
         // calculate corrected / truth ratios ('f' for "fraction")
-        std::vector<TH1*> fhists;
-        for (std::size_t idat = 0; idat < dhists.size(); ++idat) {
+        std::vector<Hist1D> fnative;
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
 
-          // create name
-          std::string name( m_params.data[idat].rename );
-          name += "_CorrectOverTruth";
-
-          // do division
-          fhists.push_back( Tools::DivideHist1D(dhists[idat], thists[idat]) );
-          fhists.back() -> SetName( name.data() );
+          fnative.push_back( Tools::DivideHist1D(dnative[idat], tnative[idat]) );
+          fnative.back().SetName( m_params.data[idat].rename + "_CorrectOverTruth" );
         }
         std::cout << "    Calculated corrected / truth ratios." << std::endl;
 
+        // get ROOT histograms for drawing
+        std::vector<TH1*> dhists;
+        std::vector<TH1*> rhists;
+        std::vector<TH1*> thists;
+        std::vector<TH1*> chists;
+        std::vector<TH1*> fhists;
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(dhists);
+        guard.Watch(rhists);
+        guard.Watch(thists);
+        guard.Watch(chists);
+        guard.Watch(fhists);
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
+          dhists.push_back( HistPool::Global().Acquire(dnative[idat], m_params.options.precision) );
+          rhists.push_back( HistPool::Global().Acquire(rnative[idat], m_params.options.precision) );
+          thists.push_back( HistPool::Global().Acquire(tnative[idat], m_params.options.precision) );
+          chists.push_back( HistPool::Global().Acquire(cnative[idat], m_params.options.precision) );
+          fhists.push_back( HistPool::Global().Acquire(fnative[idat], m_params.options.precision) );
+        }
+
         // determine no. of legend lines
         const std::size_t nlines = !m_params.options.header.empty()
                                  ? dhists.size() + thists.size() + 1
@@ -486,17 +533,25 @@ namespace PHEnergyCorrelator {
         text   -> Draw();
         std:: cout << "    Made plot." << std::endl;
 
-        // save output
+        // save output (reused corrections were already
+        // written when they were first computed)
         ofile -> cd();
         for (std::size_t idat = 0; idat < dhists.size(); ++idat) {
           dhists[idat] -> Write();
-          rhists[idat] -> Write();
-          thists[idat] -> Write();
-          chists[idat] -> Write();
+          if (!cached[idat]) {
+            rhists[idat] -> Write();
+            thists[idat] -> Write();
+            chists[idat] -> Write();
+          }
           fhists[idat] -> Write();
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(dhists);
+        HistPool::Global().Release(rhists);
+        HistPool::Global().Release(thists);
+        HistPool::Global().Release(chists);
+        HistPool::Global().Release(fhists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -505,9 +560,6 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(dfiles);
-        Tools::CloseFiles(rfiles);
-        Tools::CloseFiles(tfiles);
         return;
 
       }  // end 'Plot(TFile*)'
@@ -14,10 +14,13 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <vector>
 // root libraries
 #include <TCanvas.h>
 #include <TFile.h>
 #include <TH1.h>
+#include <TH2.h>
 #include <TLegend.h>
 #include <TPaveText.h>
 // plotting utilities
@@ -54,6 +57,109 @@ namespace PHEnergyCorrelator {
       // members
       Params m_params;
 
+      // ----------------------------------------------------------------------
+      //! Helper method to spill a 2D input into a tile store
+      // ----------------------------------------------------------------------
+      /*! The input file is closed by a guard when leaving, so
+       *  it's closed even if grabbing or spilling the input
+       *  throws. The grabbed histogram belongs to the file, so
+       *  it's only used before then.
+       */
+      std::size_t SpillInput(TileStore& store, const PlotInput& input, const std::string& role) const {
+
+        std::vector<TFile*> files(1, Tools::OpenFile(input.file, "read"));
+        Tools::FileCloser   close_files(files);
+
+        TH2*              hist  = (TH2*) Tools::GrabObject(input.object, files.front());
+        const std::size_t islot = store.Spill(hist, input.rename, input.legend);
+        Tools::AnnounceLoad(input.file, input.object, role, false);
+        return islot;
+
+      }  // end 'SpillInput(TileStore&, PlotInput&, std::string&)'
+
+      // ----------------------------------------------------------------------
+      //! Correct 2D spectra tile by tile
+      // ----------------------------------------------------------------------
+      /*! Same calculation as `Plot(...)`, but inputs are
+       *  streamed into a disk-backed tile store one at a time
+       *  and normalizations and ratios are computed tile by
+       *  tile, so that at most one full histogram is held in
+       *  memory at once. Outputs are written one at a time,
+       *  and no canvases are drawn.
+       *
+       *  \param[out] ofile file to write to
+       */
+      void PlotTiled(TFile* ofile) const {
+
+        TileStore store( TileStore::DefaultTileCells() );
+        std::cout << "    Processing in tiles of " << store.GetTileCells() << " cells." << std::endl;
+
+        // normalization range
+        const double startx = m_params.options.norm_range.GetX().first;
+        const double stopx  = m_params.options.norm_range.GetX().second;
+        const double starty = Tools::MinDouble();
+        const double stopy  = Tools::MaxDouble();
+
+        std::vector<std::size_t> outputs;
+        for (std::size_t idat = 0; idat < m_params.data.size(); ++idat) {
+
+          // stream inputs to disk
+          const std::size_t idata = SpillInput(store, m_params.data[idat], "data");
+          const std::size_t irec  = SpillInput(store, m_params.recon[idat], "recon");
+          const std::size_t itru  = SpillInput(store, m_params.truth[idat], "truth");
+          if (m_params.options.do_norm) {
+            store.Normalize(irec, m_params.options.norm_to, startx, stopx, starty, stopy);
+            store.Normalize(itru, m_params.options.norm_to, startx, stopx, starty, stopy);
+          }
+
+          // calculate & apply correction factors
+          const std::size_t icor = store.Divide(
+            irec,
+            itru,
+            store.GetName(itru) + "_CorrectionFactor",
+            "Correction Factors"
+          );
+          const std::size_t icrd = store.Divide(
+            idata,
+            icor,
+            store.GetName(idata) + "_Corrected",
+            m_params.data[idat].legend
+          );
+          if (m_params.options.do_norm) {
+            store.Normalize(icrd, m_params.options.norm_to, startx, stopx, starty, stopy);
+          }
+
+          // calculate corrected / truth ratio
+          const std::size_t ifrc = store.Divide(
+            icrd,
+            itru,
+            m_params.data[idat].rename + "_CorrectOverTruth",
+            "Corrected / Truth"
+          );
+
+          outputs.push_back(icrd);
+          outputs.push_back(irec);
+          outputs.push_back(itru);
+          outputs.push_back(icor);
+          outputs.push_back(ifrc);
+        }
+        std::cout << "    Calculated and applied correction factors ("
+                  << store.GetNBytes() << " bytes on disk)."
+                  << std::endl;
+
+        // write outputs one at a time
+        ofile -> cd();
+        for (std::size_t iout = 0; iout < outputs.size(); ++iout) {
+          TH1* hist = store.MakeTH(outputs[iout], m_params.options.precision);
+          m_basePlotStyle.Apply( hist );
+          hist -> Write();
+          delete hist;
+        }
+        std::cout << "    Saved output." << std::endl;
+        return;
+
+      }  // end 'PlotTiled(TFile*)'
+
     public:
 
       // ----------------------------------------------------------------------
@@ -74,6 +180,9 @@ namespace PHEnergyCorrelator {
        *  panel shows corrected spectra vs truth, and lwer panel shows
        *  correction factors.
        *
+       *  If `TileStore::DefaultTileCells()` is nonzero, the spectra
+       *  are instead processed out of core (see `PlotTiled(...)`).
+       *
        *  \param[out] ofile file to write to
        */
       void Plot(TFile* ofile) const {
@@ -90,6 +199,7 @@ namespace PHEnergyCorrelator {
                     << "       reco inputs = " << m_params.recon.size() << "\n"
                     << "       true inputs = " << m_params.truth.size()
                     << std::endl;
+          Error::Raise("number of reconstructed and truth inputs should be the same");
           assert(m_params.recon.size() == m_params.truth.size());
         }
 
@@ -99,48 +209,44 @@ namespace PHEnergyCorrelator {
                     << "       data inputs = " << m_params.data.size() << "\n"
                     << "       reco inputs = " << m_params.recon.size()
                     << std::endl;
+          Error::Raise("number of raw and reconstructed inputs should be the same");
           assert(m_params.data.size() == m_params.recon.size());
         }
 
-        // open data inputs
-        std::vector<TFile*> dfiles;
-        std::vector<TH2*>   dhists;
+        // process out of core if need be
+        if (TileStore::DefaultTileCells() > 0) {
+          PlotTiled(ofile);
+          std::cout << "  Finished 2D spectra correction!\n"
+                    << " -------------------------------- \n"
+                    << std::endl;
+          return;
+        }
+
+        // load data inputs
+        std::vector<Hist2D> dnative;
         for (std::size_t idat = 0; idat < m_params.data.size(); ++idat) {
 
-          dfiles.push_back(
-            Tools::OpenFile(m_params.data[idat].file, "read")
+          dnative.push_back(
+            Tools::LoadHist2D( m_params.data[idat].file, m_params.data[idat].object, 1, 1, "data" )
           );
-          dhists.push_back(
-            (TH2*) Tools::GrabObject( m_params.data[idat].object, dfiles.back() )
-          );
-          dhists.back() -> SetName( m_params.data[idat].rename.data() );
-          dhists.back() -> SetTitle( m_params.data[idat].legend.data() );
-          std::cout << "      File (data) = " << m_params.data[idat].file << "\n"
-                    << "      Hist (data) = " << m_params.data[idat].object
-                    << std::endl;
+          dnative.back().SetName( m_params.data[idat].rename );
+          dnative.back().SetTitle( m_params.data[idat].legend );
         }  // end data loop
 
-        // open reco inputs
-        std::vector<TFile*> rfiles;
-        std::vector<TH2*>   rhists;
+        // load reco inputs
+        std::vector<Hist2D> rnative;
         for (std::size_t irec = 0; irec < m_params.recon.size(); ++irec) {
 
-          rfiles.push_back(
-            Tools::OpenFile(m_params.recon[irec].file, "read")
-          );
-          rhists.push_back(
-            (TH2*) Tools::GrabObject( m_params.recon[irec].object, rfiles.back() )
+          rnative.push_back(
+            Tools::LoadHist2D( m_params.recon[irec].file, m_params.recon[irec].object, 1, 1, "recon" )
           );
-          rhists.back() -> SetName( m_params.recon[irec].rename.data() );
-          rhists.back() -> SetTitle( m_params.recon[irec].legend.data() );
-          std::cout << "      File (recon) = " << m_params.recon[irec].file << "\n"
-                    << "      Hist (recon) = " << m_params.recon[irec].object
-                    << std::endl;
+          rnative.back().SetName( m_params.recon[irec].rename );
+          rnative.back().SetTitle( m_params.recon[irec].legend );
 
           // normalize reco if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              rhists.back(),
+              rnative.back(),
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
@@ -148,27 +254,20 @@ namespace PHEnergyCorrelator {
           }
         }  // end reco loop
 
-        // open true inputs
-        std::vector<TFile*> tfiles;
-        std::vector<TH2*>   thists;
+        // load true inputs
+        std::vector<Hist2D> tnative;
         for (std::size_t itru = 0; itru < m_params.truth.size(); ++itru) {
 
-          tfiles.push_back(
-            Tools::OpenFile(m_params.truth[itru].file, "read")
-          );
-          thists.push_back(
-            (TH2*) Tools::GrabObject( m_params.truth[itru].object, tfiles.back() )
+          tnative.push_back(
+            Tools::LoadHist2D( m_params.truth[itru].file, m_params.truth[itru].object, 1, 1, "truth" )
           );
-          thists.back() -> SetName( m_params.truth[itru].rename.data() );
-          thists.back() -> SetTitle( m_params.truth[itru].legend.data() );
-          std::cout << "      File (truth) = " << m_params.truth[itru].file << "\n"
-                    << "      Hist (truth) = " << m_params.truth[itru].object
-                    << std::endl;
+          tnative.back().SetName( m_params.truth[itru].rename );
+          tnative.back().SetTitle( m_params.truth[itru].legend );
 
           // normalize true if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              thists.back(),
+              tnative.back(),
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
@@ -177,36 +276,28 @@ namespace PHEnergyCorrelator {
         }  // end true loop
 
         // calculate correction factors
-        std::vector<TH2*> chists;
-        for (std::size_t itru = 0; itru < thists.size(); ++itru) {
+        std::vector<Hist2D> cnative;
+        for (std::size_t itru = 0; itru < tnative.size(); ++itru) {
 
-          // create name
-          std::string name( thists[itru] -> GetName() );
-          name += "_CorrectionFactor";
-
-          // do division
-          chists.push_back( Tools::DivideHist2D(rhists[itru], thists[itru]) );
-          chists.back() -> SetName( name.data() );
-          chists.back() -> SetTitle( "Correction Factors" );
+          cnative.push_back( Tools::DivideHist2D(rnative[itru], tnative[itru]) );
+          cnative.back().SetName( tnative[itru].GetName() + "_CorrectionFactor" );
+          cnative.back().SetTitle( "Correction Factors" );
         }
         std::cout << "    Calculated correction factors." << std::endl;
 
         // apply correction factors
-        for (std::size_t idat = 0; idat < dhists.size(); ++idat) {
-
-          // create name
-          std::string name( dhists[idat] -> GetName() );
-          name += "_Corrected";
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
 
           // divide by (reco / true)
-          dhists[idat] = Tools::DivideHist2D( dhists[idat], chists[idat] );
-          dhists[idat] -> SetName( name.data() );
-          dhists[idat] -> SetTitle( m_params.data[idat].legend.data() );
+          const std::string name = dnative[idat].GetName() + "_Corrected";
+          dnative[idat] = Tools::DivideHist2D( dnative[idat], cnative[idat] );
+          dnative[idat].SetName( name );
+          dnative[idat].SetTitle( m_params.data[idat].legend );
 
           // normalize corrected spectrum if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              dhists[idat],
+              dnative[idat],
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second
@@ -216,20 +307,35 @@ namespace PHEnergyCorrelator {
         std::cout << "    Applied correction factors." << std::endl;
 
         // calculate corrected / truth ratios ('f' for "fraction")
-        std::vector<TH2*> fhists;
-        for (std::size_t idat = 0; idat < dhists.size(); ++idat) {
+        std::vector<Hist2D> fnative;
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
 
-          // create name
-          std::string name( m_params.data[idat].rename );
-          name += "_CorrectOverTruth";
-
-          // do division
-          fhists.push_back( Tools::DivideHist2D(dhists[idat], thists[idat]) );
-          fhists.back() -> SetName( name.data() );
-          fhists.back() -> SetTitle( "Corrected / Truth" );
+          fnative.push_back( Tools::DivideHist2D(dnative[idat], tnative[idat]) );
+          fnative.back().SetName( m_params.data[idat].rename + "_CorrectOverTruth" );
+          fnative.back().SetTitle( "Corrected / Truth" );
         }
         std::cout << "    Calculated corrected / truth ratios." << std::endl;
 
+        // get ROOT histograms for drawing
+        std::vector<TH2*> dhists;
+        std::vector<TH2*> rhists;
+        std::vector<TH2*> thists;
+        std::vector<TH2*> chists;
+        std::vector<TH2*> fhists;
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(dhists);
+        guard.Watch(rhists);
+        guard.Watch(thists);
+        guard.Watch(chists);
+        guard.Watch(fhists);
+        for (std::size_t idat = 0; idat < dnative.size(); ++idat) {
+          dhists.push_back( HistPool::Global().Acquire(dnative[idat], m_params.options.precision) );
+          rhists.push_back( HistPool::Global().Acquire(rnative[idat], m_params.options.precision) );
+          thists.push_back( HistPool::Global().Acquire(tnative[idat], m_params.options.precision) );
+          chists.push_back( HistPool::Global().Acquire(cnative[idat], m_params.options.precision) );
+          fhists.push_back( HistPool::Global().Acquire(fnative[idat], m_params.options.precision) );
+        }
+
         // determine no. of legend lines
         const std::size_t nlines = !m_params.options.header.empty()
                                  ? dhists.size() + thists.size() + 1
@@ -276,6 +382,7 @@ namespace PHEnergyCorrelator {
         // throw error if not enough pads are present for histograms
         if (manager.GetTPads().size() < (3 * dhists.size())) {
           std::cerr << "PANIC: more histograms to draw than pads in " << manager.GetTCanvas() -> GetName() << "!" << std::endl;
+          Error::Raise("more histograms to draw than pads");
           assert(manager.GetTPads().size() >= (3 * dhists.size()));
         }
 
@@ -311,6 +418,11 @@ namespace PHEnergyCorrelator {
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(dhists);
+        HistPool::Global().Release(rhists);
+        HistPool::Global().Release(thists);
+        HistPool::Global().Release(chists);
+        HistPool::Global().Release(fhists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -319,9 +431,6 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(dfiles);
-        Tools::CloseFiles(rfiles);
-        Tools::CloseFiles(tfiles);
         return;
 
       }  // end 'Plot(TFile*)'
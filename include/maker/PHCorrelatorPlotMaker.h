@@ -23,6 +23,7 @@
 #include "PHCorrelatorBaseRoutine.h"
 #include "PHCorrelatorCorrectSpectra1D.h"
 #include "PHCorrelatorCorrectSpectra2D.h"
+#include "PHCorrelatorPlotPulls2D.h"
 #include "PHCorrelatorPlotRatios1D.h"
 #include "PHCorrelatorPlotRatios2D.h"
 #include "PHCorrelatorPlotSpectra1D.h"
@@ -53,6 +54,7 @@ namespace PHEnergyCorrelator {
       // routines
       CorrectSpectra1D m_corrSpec1D;
       CorrectSpectra2D m_corrSpec2D;
+      PlotPulls2D      m_plotPull2D;
       PlotRatios1D     m_plotRatio1D;
       PlotRatios2D     m_plotRatio2D;
       PlotSpectra1D    m_plotSpec1D;
@@ -67,6 +69,7 @@ namespace PHEnergyCorrelator {
 
         m_corrSpec1D   = CorrectSpectra1D(m_basePlotStyle, m_baseTextStyle, m_textBox);
         m_corrSpec2D   = CorrectSpectra2D(m_basePlotStyle, m_baseTextStyle, m_textBox);
+        m_plotPull2D   = PlotPulls2D(m_basePlotStyle, m_baseTextStyle, m_textBox);
         m_plotRatio1D  = PlotRatios1D(m_basePlotStyle, m_baseTextStyle, m_textBox);
         m_plotRatio2D  = PlotRatios2D(m_basePlotStyle, m_baseTextStyle, m_textBox);
         m_plotSpec1D   = PlotSpectra1D(m_basePlotStyle, m_baseTextStyle, m_textBox);
@@ -98,6 +101,7 @@ namespace PHEnergyCorrelator {
       // ----------------------------------------------------------------------
       CorrectSpectra1D& GetCorrectSpectra1D() {return m_corrSpec1D;}
       CorrectSpectra2D& GetCorrectSpectra2D() {return m_corrSpec2D;}
+      PlotPulls2D&      GetPlotPulls2D()      {return m_plotPull2D;}
       PlotRatios1D&     GetPlotRatios1D()     {return m_plotRatio1D;}
       PlotRatios2D&     GetPlotRatios2D()     {return m_plotRatio2D;}
       PlotSpectra1D&    GetPlotSpectra1D()    {return m_plotSpec1D;}
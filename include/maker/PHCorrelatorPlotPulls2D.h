@@ -0,0 +1,276 @@
+/// ===========================================================================
+/*! \file    PHCorrelatorPlotPulls2D.h
+ *  \authors Derek Anderson
+ *  \date    10.17.2026
+ *
+ *  PlotMaker routine to plot pull (significance)
+ *  maps of pairs of 2D spectra.
+ */
+/// ===========================================================================
+
+#ifndef PHCORRELATORPLOTPULLS2D_H
+#define PHCORRELATORPLOTPULLS2D_H
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+// root libraries
+#include <TCanvas.h>
+#include <TFile.h>
+#include <TH2.h>
+#include <TPaveText.h>
+// plotting utilities
+#include "PHCorrelatorBaseRoutine.h"
+#include "PHCorrelatorPlotMakerDefault.h"
+#include "PHCorrelatorPlotMakerTools.h"
+#include "PHCorrelatorPlotMakerTypes.h"
+#include "PHCorrelatorPlotRatios1D.h"
+#include "../elements/PHCorrelatorPlotterElements.h"
+
+
+
+namespace PHEnergyCorrelator {
+
+  // ==========================================================================
+  //! 2D Pull Plotting Routine
+  // ==========================================================================
+  /*! Routine to plot the bin-by-bin pulls between
+   *  pairs of 2D spectra, one pair per pad. Pulls are
+   *  computed by the shared pull map (PullMap::Global()),
+   *  which also records the most significant cells of
+   *  each pair.
+   */
+  class PlotPulls2D : public BaseRoutine {
+
+    public:
+
+      // ======================================================================
+      //! Parameters for plotting 2D pulls (same as 1D ratios)
+      // ======================================================================
+      typedef PlotRatios1D::Params Params;
+
+    private:
+
+      // members
+      Params m_params;
+
+      // ----------------------------------------------------------------------
+      //! Helper method to load a 2D input
+      // ----------------------------------------------------------------------
+      Hist2D Load2D(const PlotInput& input) const {
+
+        Hist2D native = Tools::LoadHist2D(input.file, input.object);
+        native.SetName( input.rename );
+
+        // normalize input if need be
+        if (m_params.options.do_norm) {
+          Tools::NormalizeByIntegral(
+            native,
+            m_params.options.norm_to,
+            m_params.options.norm_range.GetX().first,
+            m_params.options.norm_range.GetX().second,
+            m_params.options.norm_range.GetY().first,
+            m_params.options.norm_range.GetY().second
+          );
+        }
+        return native;
+
+      }  // end 'Load2D(PlotInput&)'
+
+    public:
+
+      // ----------------------------------------------------------------------
+      //! Getters
+      // ----------------------------------------------------------------------
+      Params GetParams() const {return m_params;}
+
+      // ----------------------------------------------------------------------
+      //! Setters
+      // ----------------------------------------------------------------------
+      void SetParams(const Params& params) {m_params = params;}
+
+      // ----------------------------------------------------------------------
+      //! Configure routine
+      // ----------------------------------------------------------------------
+      /*! Sets routine parameters with reasonable default values
+       *  based on provided inputs. Pulls are drawn in [-5, 5].
+       */
+      void Configure(
+        const Type::Inputs& in_denoms,
+        const Type::Inputs& in_numers,
+        const std::string& canvas_name = "cPulls2D",
+        const std::size_t ncolumn = 2
+      ) {
+
+        // grab default pad options, and
+        // turn on log x
+        PadOpts pad_opts = PadOpts();
+        pad_opts.logx = 1;
+
+        // set pad margins
+        Type::Margins pad_margins;
+        pad_margins.push_back(0.15);
+        pad_margins.push_back(0.15);
+        pad_margins.push_back(0.15);
+        pad_margins.push_back(0.15);
+
+        // generate grid canvas
+        Canvas canvas = Tools::MakeGridCanvas(
+          canvas_name,
+          "pPad",
+          in_numers.size(),
+          ncolumn,
+          pad_margins,
+          pad_opts
+        );
+
+        // set ranges
+        const Range plot_range = Range(
+          Default::PlotRange(Type::Side).GetX(),
+          Default::PlotRange(Type::Angle).GetX(),
+          std::make_pair(-5., 5.)
+        );
+        const Range norm_range = Range(
+          Default::PlotRange(Type::Side).GetX(),
+          Default::PlotRange(Type::Angle).GetX(),
+          Default::PlotRange(Type::Side).GetZ()
+        );
+
+        // set auxilliary options
+        PlotOpts plot_opts;
+        plot_opts.plot_range = plot_range;
+        plot_opts.norm_range = norm_range;
+        plot_opts.canvas     = canvas;
+
+        // bundle parameters
+        m_params.denominators = in_denoms;
+        m_params.numerators   = in_numers;
+        m_params.options      = plot_opts;
+        return;
+
+      }  // end 'Configure(Inputs& x 2, std::string&, std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Plot pull maps of pairs of 2D spectra
+      // ----------------------------------------------------------------------
+      /*! Each map is named after its numerator with "_Pull"
+       *  appended.
+       *
+       *  \param[out] ofile file to write to
+       */
+      void Plot(TFile* ofile) const {
+
+        // announce start
+        std::cout << "\n -------------------------------- \n"
+                  << "  Beginning 2D pull plotting!\n"
+                  << "    Opening inputs:"
+                  << std::endl;
+
+        // throw error if no. of denominators and numerators don't match
+        if (m_params.denominators.size() != m_params.numerators.size()) {
+          std::cerr << "PANIC: number of denominators and numerators should be the same!\n"
+                    << "       denominators = " << m_params.denominators.size() << "\n"
+                    << "       numerators   = " << m_params.numerators.size()
+                    << std::endl;
+          Error::Raise("number of denominators and numerators should be the same");
+          assert(m_params.denominators.size() == m_params.numerators.size());
+        }
+
+        // load pairs & compute pulls
+        std::vector<Hist2D> pnative;
+        for (std::size_t ipair = 0; ipair < m_params.numerators.size(); ++ipair) {
+          const Hist2D numer = Load2D(m_params.numerators[ipair]);
+          const Hist2D denom = Load2D(m_params.denominators[ipair]);
+          pnative.push_back(
+            PullMap::Global().Compute(numer, denom, numer.GetName() + "_Pull")
+          );
+          pnative.back().SetTitle( m_params.numerators[ipair].legend + " vs. " + m_params.denominators[ipair].legend );
+        }
+        std::cout << "    Calculated pulls." << std::endl;
+
+        // get ROOT histograms for drawing
+        std::vector<TH2*> phists;
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(phists);
+        for (std::size_t ipul = 0; ipul < pnative.size(); ++ipul) {
+          phists.push_back( HistPool::Global().Acquire(pnative[ipul], m_params.options.precision) );
+        }
+
+        // create text box
+        TPaveText* text = m_textBox.MakeTPaveText();
+        m_baseTextStyle.Apply( text );
+        std::cout << "    Created text box." << std::endl;
+
+        // set hist styles
+        for (std::size_t ipul = 0; ipul < phists.size(); ++ipul) {
+          m_basePlotStyle.Apply( phists[ipul] );
+          m_params.options.plot_range.Apply(Range::X, phists[ipul] -> GetXaxis());
+          m_params.options.plot_range.Apply(Range::Y, phists[ipul] -> GetYaxis());
+          m_params.options.plot_range.Apply(Range::Z, phists[ipul] -> GetZaxis());
+          phists[ipul] -> SetMinimum( m_params.options.plot_range.GetZ().first );
+          phists[ipul] -> SetMaximum( m_params.options.plot_range.GetZ().second );
+        }
+        std::cout << "    Set styles." << std::endl;
+
+        // draw plot
+        CanvasManager manager = CanvasManager( m_params.options.canvas );
+        manager.MakePlot();
+        manager.Draw();
+
+        // throw error if not enough pads are present for histograms
+        if (manager.GetTPads().size() < phists.size()) {
+          std::cerr << "PANIC: more histograms to draw than pads in " << manager.GetTCanvas() -> GetName() << "!" << std::endl;
+          Error::Raise("more histograms to draw than pads");
+          assert(manager.GetTPads().size() >= phists.size());
+        }
+
+        // draw 1 map per pad and text box on last pad
+        for (std::size_t ipul = 0; ipul < phists.size(); ++ipul) {
+          manager.GetTPad(ipul) -> cd();
+          phists[ipul] -> Draw("colz");
+        }
+        manager.GetTPads().back() -> cd();
+        text -> Draw();
+        std:: cout << "    Made plot." << std::endl;
+
+        // save output
+        ofile -> cd();
+        for (std::size_t ipul = 0; ipul < phists.size(); ++ipul) {
+          phists[ipul] -> Write();
+        }
+        manager.Write();
+        manager.Close();
+        HistPool::Global().Release(phists);
+        std::cout << "    Saved output." << std::endl;
+
+        // announce end
+        std::cout << "  Finished 2D pull plotting!\n"
+                  << " -------------------------------- \n"
+                  << std::endl;
+
+        // exit routine
+        return;
+
+      }  // end 'Plot(TFile*)'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      PlotPulls2D()  {};
+      ~PlotPulls2D() {};
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting arguments
+      // ----------------------------------------------------------------------
+      explicit PlotPulls2D(const Style& plot, const Style& text, const TextBox& box)
+        : BaseRoutine(plot, text, box) {};
+
+  };  // end PlotPulls2D
+
+}    // end PHEnergyCorrelator namespace
+
+#endif
+
+/// end =======================================================================
@@ -158,112 +158,65 @@ namespace PHEnergyCorrelator {
       }  // end 'Configure(Inputs& x 2, std::string&, int)'
 
       // ----------------------------------------------------------------------
-      //! Plot various pairs of 1D ENC (or otherwise) spectra and their ratios
+      //! Plot pairs of already-computed 1D spectra and their ratios
       // ----------------------------------------------------------------------
-      /*! Compares a variety of pairs of 1D ENC (or otherwise) spectra from
-       *  different sources and their ratios. Upper panel shows spectra,
-       *  lower panel shows ratios.
+      /*! Draws and saves spectra/ratios which have already been
+       *  loaded, normalized, and divided (e.g. by SpinRatioEngine)
+       *  using the styles, legends, and names of the configured
+       *  inputs. Files named in the inputs aren't opened.
        *
-       *  \param[out] ofile file to write to
+       *  \param[in]  in_denoms denominator spectra, one per input
+       *  \param[in]  in_numers numerator spectra, one per input
+       *  \param[in]  in_ratios ratios, one per input
+       *  \param[out] ofile     file to write to
        */
-      void Plot(TFile* ofile) const {
-
-        // announce start
-        std::cout << "\n -------------------------------- \n"
-                  << "  Beginning ratio comparison plotting!\n"
-                  << "    Opening inputs:"
-                  << std::endl;
-
-        // throw error if no. of denominators and numerators don't match
-        if (m_params.denominators.size() != m_params.numerators.size()) {
-          std::cerr << "PANIC: number of denominators and numerators should be the same!\n"
-                    << "       denominators = " << m_params.denominators.size() << "\n"
-                    << "       numerators   = " << m_params.numerators.size()
+      void PlotNative(
+        const std::vector<Hist1D>& in_denoms,
+        const std::vector<Hist1D>& in_numers,
+        const std::vector<Hist1D>& in_ratios,
+        TFile* ofile
+      ) const {
+
+        // throw error if no. of spectra and inputs don't match
+        const std::size_t ninput = m_params.denominators.size();
+        if (
+          (m_params.numerators.size() != ninput) ||
+          (in_denoms.size() != ninput) ||
+          (in_numers.size() != ninput) ||
+          (in_ratios.size() != ninput)
+        ) {
+          std::cerr << "PANIC: number of spectra and inputs should be the same!\n"
+                    << "       denominators = " << m_params.denominators.size() << " (" << in_denoms.size() << " spectra)\n"
+                    << "       numerators   = " << m_params.numerators.size() << " (" << in_numers.size() << " spectra)\n"
+                    << "       ratios       = " << in_ratios.size()
                     << std::endl;
-          assert(m_params.denominators.size() == m_params.numerators.size());
+          Error::Raise("number of spectra and inputs should be the same");
+          assert(in_denoms.size() == ninput);
         }
 
-        // open denominator inputs
-        std::vector<TFile*> dfiles;
-        std::vector<TH1*>   dhists;
-        for (std::size_t iden = 0; iden < m_params.denominators.size(); ++iden) {
-
-          dfiles.push_back(
-            Tools::OpenFile(m_params.denominators[iden].file, "read")
-          );
-          dhists.push_back(
-            (TH1*) Tools::GrabObject( m_params.denominators[iden].object, dfiles.back() )
-          );
-          dhists.back() -> SetName( m_params.denominators[iden].rename.data() );
-          std::cout << "      File (denom) = " << m_params.denominators[iden].file << "\n"
-                    << "      Hist (denom) = " << m_params.denominators[iden].object
-                    << std::endl;
-
-          // rebin if need be
-          if (m_params.denominators[iden].rebin.GetRebin()) {
-            m_params.denominators[iden].rebin.Apply(dhists.back());
-            std::cout << "    Rebinned " << dhists.back() -> GetName() << std::endl;
-          }
-
-          // normalize denominaotr if need be
-          if (m_params.options.do_norm) {
-            Tools::NormalizeByIntegral(
-              dhists.back(),
-              m_params.options.norm_to,
-              m_params.options.norm_range.GetX().first,
-              m_params.options.norm_range.GetX().second
-            );
-            std::cout << "    Normalized " << dhists.back() -> GetName() << std::endl;
-          }
-        }  // end denominator loop
-
-        // open numerator inputs
-        std::vector<TFile*> nfiles;
-        std::vector<TH1*>   nhists;
-        for (std::size_t inum = 0; inum < m_params.numerators.size(); ++inum) {
-
-          nfiles.push_back(
-            Tools::OpenFile(m_params.numerators[inum].file, "read")
-          );
-          nhists.push_back(
-            (TH1*) Tools::GrabObject( m_params.numerators[inum].object, nfiles.back() )
-          );
-          nhists.back() -> SetName( m_params.numerators[inum].rename.data() );
-          std::cout << "      File (numer) = " << m_params.numerators[inum].file << "\n"
-                    << "      Hist (numer) = " << m_params.numerators[inum].object
-                    << std::endl;
-
-          // rebin if need be
-          if (m_params.numerators[inum].rebin.GetRebin()) {
-            m_params.numerators[inum].rebin.Apply(nhists.back());
-            std::cout << "    Rebinned " << nhists.back() -> GetName() << std::endl;
-          }
-
-          // normalize numerator if need be
-          if (m_params.options.do_norm) {
-            Tools::NormalizeByIntegral(
-              nhists.back(),
-              m_params.options.norm_to,
-              m_params.options.norm_range.GetX().first,
-              m_params.options.norm_range.GetX().second
-            );
-            std::cout << "    Normalized " << nhists.back() -> GetName() << std::endl;
-          }
-        }  // end numerator loop
+        // name spectra after inputs
+        std::vector<Hist1D> dnative = in_denoms;
+        std::vector<Hist1D> nnative = in_numers;
+        std::vector<Hist1D> rnative = in_ratios;
+        for (std::size_t iden = 0; iden < ninput; ++iden) {
+          dnative[iden].SetName( m_params.denominators[iden].rename );
+          nnative[iden].SetName( m_params.numerators[iden].rename );
+          rnative[iden].SetName( m_params.denominators[iden].rename + "_Ratio" );
+        }
 
-        // take ratios
+        // get ROOT histograms for drawing
+        std::vector<TH1*> dhists;
+        std::vector<TH1*> nhists;
         std::vector<TH1*> rhists;
-        for (std::size_t iden = 0; iden < nhists.size(); ++iden) {
-
-          // create name
-          std::string name( dhists[iden] -> GetName() );
-          name += "_Ratio";
-
-          // do division
-          rhists.push_back( Tools::DivideHist1D( nhists[iden], dhists[iden]) );
-          rhists.back() -> SetName( name.data() );
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(dhists);
+        guard.Watch(nhists);
+        guard.Watch(rhists);
+        for (std::size_t iden = 0; iden < dnative.size(); ++iden) {
+          dhists.push_back( HistPool::Global().Acquire(dnative[iden], m_params.options.precision) );
+          nhists.push_back( HistPool::Global().Acquire(nnative[iden], m_params.options.precision) );
+          rhists.push_back( HistPool::Global().Acquire(rnative[iden], m_params.options.precision) );
         }
-        std::cout << "    Calculated ratios." << std::endl;
 
         // determine no. of legend lines
         const std::size_t nlines = !m_params.options.header.empty()
@@ -380,6 +333,9 @@ namespace PHEnergyCorrelator {
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(dhists);
+        HistPool::Global().Release(nhists);
+        HistPool::Global().Release(rhists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -388,8 +344,75 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(dfiles);
-        Tools::CloseFiles(nfiles);
+        return;
+
+      }  // end 'PlotNative(std::vector<Hist1D>& x 3, TFile*)'
+
+      // ----------------------------------------------------------------------
+      //! Plot various pairs of 1D ENC (or otherwise) spectra and their ratios
+      // ----------------------------------------------------------------------
+      /*! Compares a variety of pairs of 1D ENC (or otherwise) spectra from
+       *  different sources and their ratios. Upper panel shows spectra,
+       *  lower panel shows ratios.
+       *
+       *  \param[out] ofile file to write to
+       */
+      void Plot(TFile* ofile) const {
+
+        // announce start
+        std::cout << "\n -------------------------------- \n"
+                  << "  Beginning ratio comparison plotting!\n"
+                  << "    Opening inputs:"
+                  << std::endl;
+
+        // throw error if no. of denominators and numerators don't match
+        if (m_params.denominators.size() != m_params.numerators.size()) {
+          std::cerr << "PANIC: number of denominators and numerators should be the same!\n"
+                    << "       denominators = " << m_params.denominators.size() << "\n"
+                    << "       numerators   = " << m_params.numerators.size()
+                    << std::endl;
+          Error::Raise("number of denominators and numerators should be the same");
+          assert(m_params.denominators.size() == m_params.numerators.size());
+        }
+
+        // load denominator inputs
+        std::vector<Hist1D> dnative;
+        for (std::size_t iden = 0; iden < m_params.denominators.size(); ++iden) {
+          dnative.push_back( Load1D(m_params.denominators[iden], m_params.options, "denom") );
+        }
+
+        // load numerator inputs
+        std::vector<Hist1D> nnative;
+        for (std::size_t inum = 0; inum < m_params.numerators.size(); ++inum) {
+          nnative.push_back( Load1D(m_params.numerators[inum], m_params.options, "numer") );
+        }
+
+        // put all spectra on a common binning if need be
+        Type::Inputs         inputs = m_params.denominators;
+        std::vector<Hist1D*> pnatives;
+        inputs.insert(inputs.end(), m_params.numerators.begin(), m_params.numerators.end());
+        for (std::size_t iden = 0; iden < dnative.size(); ++iden) {
+          pnatives.push_back( &dnative[iden] );
+        }
+        for (std::size_t inum = 0; inum < nnative.size(); ++inum) {
+          pnatives.push_back( &nnative[inum] );
+        }
+        RebinCommon(inputs, pnatives, m_params.options);
+
+        // take ratios
+        std::vector<Hist1D> rnative;
+        for (std::size_t iden = 0; iden < nnative.size(); ++iden) {
+          rnative.push_back(
+            Ratio1D(m_params.numerators[iden], nnative[iden], m_params.denominators[iden], dnative[iden], m_params.options)
+          );
+          rnative.back().SetName( dnative[iden].GetName() + "_Ratio" );
+        }
+        std::cout << "    Calculated ratios." << std::endl;
+
+        // draw and save
+        PlotNative(dnative, nnative, rnative, ofile);
+
+        // exit routine
         return;
 
       }  // end 'Plot(TFile*)'
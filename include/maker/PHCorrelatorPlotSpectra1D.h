@@ -165,39 +165,26 @@ namespace PHEnergyCorrelator {
                   << "    Opening inputs:"
                   << std::endl;
 
-        // open inputs
-        std::vector<TFile*> ifiles;
-        std::vector<TH1*>   ihists;
+        // load inputs
+        std::vector<Hist1D> inative;
         for (std::size_t iin = 0; iin < m_params.inputs.size(); ++iin) {
+          inative.push_back( Load1D(m_params.inputs[iin], m_params.options, "input") );
+        }
 
-          ifiles.push_back(
-            Tools::OpenFile(m_params.inputs[iin].file, "read")
-          );
-          ihists.push_back(
-            (TH1*) Tools::GrabObject( m_params.inputs[iin].object, ifiles.back() )
-          );
-          ihists.back() -> SetName( m_params.inputs[iin].rename.data() );
-          std::cout << "      File = " << m_params.inputs[iin].file << "\n"
-                    << "      Hist = " << m_params.inputs[iin].object
-                    << std::endl;
-
-          // rebin if need be
-          if (m_params.inputs[iin].rebin.GetRebin()) {
-            m_params.inputs[iin].rebin.Apply(ihists.back());
-            std::cout << "    Rebinned " << ihists.back() -> GetName() << std::endl;
-          }
-
-          // normalize input if need be
-          if (m_params.options.do_norm) {
-            Tools::NormalizeByIntegral(
-              ihists.back(),
-              m_params.options.norm_to,
-              m_params.options.norm_range.GetX().first,
-              m_params.options.norm_range.GetX().second
-            );
-            std::cout << "    Normalized " << ihists.back() -> GetName() << std::endl;
-          }
-        }  // end input loop
+        // put all spectra on a common binning if need be
+        std::vector<Hist1D*> pnatives;
+        for (std::size_t iin = 0; iin < inative.size(); ++iin) {
+          pnatives.push_back( &inative[iin] );
+        }
+        RebinCommon(m_params.inputs, pnatives, m_params.options);
+
+        // get ROOT histograms for drawing
+        std::vector<TH1*> ihists;
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(ihists);
+        for (std::size_t iin = 0; iin < inative.size(); ++iin) {
+          ihists.push_back( HistPool::Global().Acquire(inative[iin], m_params.options.precision) );
+        }
 
         // determine no. of legend lines
         const std::size_t nlines = !m_params.options.header.empty()
@@ -264,6 +251,7 @@ namespace PHEnergyCorrelator {
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(ihists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -272,7 +260,6 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(ifiles);
         return;
 
       }  // end 'Plot(TFile*)'
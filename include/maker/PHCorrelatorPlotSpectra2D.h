@@ -136,27 +136,20 @@ namespace PHEnergyCorrelator {
                   << "    Opening inputs:"
                   << std::endl;
 
-        // open inputs
-        std::vector<TFile*> ifiles;
-        std::vector<TH2*>   ihists;
+        // load inputs
+        std::vector<Hist2D> inative;
         for (std::size_t iin = 0; iin < m_params.inputs.size(); ++iin) {
 
-          ifiles.push_back(
-            Tools::OpenFile(m_params.inputs[iin].file, "read")
+          inative.push_back(
+            Tools::LoadHist2D( m_params.inputs[iin].file, m_params.inputs[iin].object )
           );
-          ihists.push_back(
-            (TH2*) Tools::GrabObject( m_params.inputs[iin].object, ifiles.back() )
-          );
-          ihists.back() -> SetName( m_params.inputs[iin].rename.data() );
-          ihists.back() -> SetTitle( m_params.inputs[iin].legend.data() );
-          std::cout << "      File = " << m_params.inputs[iin].file << "\n"
-                    << "      Hist = " << m_params.inputs[iin].object
-                    << std::endl;
+          inative.back().SetName( m_params.inputs[iin].rename );
+          inative.back().SetTitle( m_params.inputs[iin].legend );
 
           // normalize input if need be
           if (m_params.options.do_norm) {
             Tools::NormalizeByIntegral(
-              ihists.back(),
+              inative.back(),
               m_params.options.norm_to,
               m_params.options.norm_range.GetX().first,
               m_params.options.norm_range.GetX().second,
@@ -166,6 +159,14 @@ namespace PHEnergyCorrelator {
           }
         }  // end input loop
 
+        // get ROOT histograms for drawing
+        std::vector<TH2*> ihists;
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(ihists);
+        for (std::size_t iin = 0; iin < inative.size(); ++iin) {
+          ihists.push_back( HistPool::Global().Acquire(inative[iin], m_params.options.precision) );
+        }
+
         // create text box
         TPaveText* text = m_textBox.MakeTPaveText();
         m_baseTextStyle.Apply( text );
@@ -190,6 +191,7 @@ namespace PHEnergyCorrelator {
         // throw error if not enough pads are present for histograms
         if (manager.GetTPads().size() < ihists.size()) {
           std::cerr << "PANIC: more histograms to draw than pads in " << manager.GetTCanvas() -> GetName() << "!" << std::endl;
+          Error::Raise("more histograms to draw than pads");
           assert(manager.GetTPads().size() >= ihists.size());
         }
 
@@ -211,6 +213,7 @@ namespace PHEnergyCorrelator {
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(ihists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -219,7 +222,6 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(ifiles);
         return;
 
       }  // end 'Plot(TFile*)'
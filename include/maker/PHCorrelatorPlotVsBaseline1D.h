@@ -176,78 +176,46 @@ namespace PHEnergyCorrelator {
                   << "    Opening inputs:"
                   << std::endl;
 
-        // open denominator input
-        TFile* dfile = Tools::OpenFile( m_params.denominator.file, "read" );
-        TH1*   dhist = (TH1*) Tools::GrabObject( m_params.denominator.object, dfile );
-        dhist -> SetName( m_params.denominator.rename.data() );
-        std::cout << "      File (denom) = " << m_params.denominator.file << "\n"
-                  << "      Hist (denom) = " << m_params.denominator.object
-                  << std::endl;
+        // load denominator input
+        Hist1D dnative = Load1D(m_params.denominator, m_params.options, "denom");
 
-          // rebin if need be
-          if (m_params.denominator.rebin.GetRebin()) {
-            m_params.denominator.rebin.Apply(dhist);
-            std::cout << "    Rebinned " << dhist -> GetName() << std::endl;
-          }
-
-        // normalize denominator if need be
-        if (m_params.options.do_norm) {
-          Tools::NormalizeByIntegral(
-            dhist,
-            m_params.options.norm_to,
-            m_params.options.norm_range.GetX().first,
-            m_params.options.norm_range.GetX().second
-          );
-          std::cout << "    Normalized " << dhist -> GetName() << std::endl;
+        // load numerator inputs
+        std::vector<Hist1D> nnative;
+        for (std::size_t inum = 0; inum < m_params.numerators.size(); ++inum) {
+          nnative.push_back( Load1D(m_params.numerators[inum], m_params.options, "numer") );
         }
 
-        // open numerator inputs
-        std::vector<TFile*> nfiles;
-        std::vector<TH1*>   nhists;
-        for (std::size_t inum = 0; inum < m_params.numerators.size(); ++inum) {
+        // put all spectra on a common binning if need be
+        Type::Inputs         inputs   = m_params.numerators;
+        std::vector<Hist1D*> pnatives = std::vector<Hist1D*>(1, &dnative);
+        inputs.push_back( m_params.denominator );
+        for (std::size_t inum = 0; inum < nnative.size(); ++inum) {
+          pnatives.push_back( &nnative[inum] );
+        }
+        RebinCommon(inputs, pnatives, m_params.options);
 
-          nfiles.push_back(
-            Tools::OpenFile(m_params.numerators[inum].file, "read")
-          );
-          nhists.push_back(
-            (TH1*) Tools::GrabObject( m_params.numerators[inum].object, nfiles.back() )
+        // take ratios
+        std::vector<Hist1D> rnative;
+        for (std::size_t inum = 0; inum < nnative.size(); ++inum) {
+          rnative.push_back(
+            Ratio1D(m_params.numerators[inum], nnative[inum], m_params.denominator, dnative, m_params.options)
           );
-          nhists.back() -> SetName( m_params.numerators[inum].rename.data() );
-          std::cout << "      File (numer) = " << m_params.numerators[inum].file << "\n"
-                    << "      Hist (numer) = " << m_params.numerators[inum].object
-                    << std::endl;
-
-          // rebin if need be
-          if (m_params.numerators[inum].rebin.GetRebin()) {
-            m_params.numerators[inum].rebin.Apply(nhists.back());
-            std::cout << "    Rebinned " << nhists.back() -> GetName() << std::endl;
-          }
-
-          // normalize numerator if need be
-          if (m_params.options.do_norm) {
-            Tools::NormalizeByIntegral(
-              nhists.back(),
-              m_params.options.norm_to,
-              m_params.options.norm_range.GetX().first,
-              m_params.options.norm_range.GetX().second
-            );
-            std::cout << "    Normalized " << nhists.back() -> GetName() << std::endl;
-          }
-        }  // end numerator loop
+          rnative.back().SetName( nnative[inum].GetName() + "_Ratio" );
+        }
+        std::cout << "    Calculated ratios." << std::endl;
 
-        // take ratios
+        // get ROOT histograms for drawing
+        TH1*              dhist = HistPool::Global().Acquire(dnative, m_params.options.precision);
+        std::vector<TH1*> nhists;
         std::vector<TH1*> rhists;
-        for (std::size_t inum = 0; inum < nhists.size(); ++inum) {
-
-          // create name
-          std::string name( nhists[inum] -> GetName() );
-          name += "_Ratio";
-
-          // do division
-          rhists.push_back( Tools::DivideHist1D( nhists[inum], dhist) );
-          rhists.back() -> SetName( name.data() );
+        HistPool::Guard   guard(HistPool::Global());
+        guard.Watch(dhist);
+        guard.Watch(nhists);
+        guard.Watch(rhists);
+        for (std::size_t inum = 0; inum < nnative.size(); ++inum) {
+          nhists.push_back( HistPool::Global().Acquire(nnative[inum], m_params.options.precision) );
+          rhists.push_back( HistPool::Global().Acquire(rnative[inum], m_params.options.precision) );
         }
-        std::cout << "    Calculated ratios." << std::endl;
 
         // determine no. of legend lines
         const std::size_t nlines = !m_params.options.header.empty()
@@ -358,6 +326,10 @@ namespace PHEnergyCorrelator {
         }
         manager.Write();
         manager.Close();
+        HistPool::Global().Release(dhist);
+        dhist = NULL;
+        HistPool::Global().Release(nhists);
+        HistPool::Global().Release(rhists);
         std::cout << "    Saved output." << std::endl;
 
         // announce end
@@ -366,8 +338,6 @@ namespace PHEnergyCorrelator {
                   << std::endl;
 
         // exit routine
-        Tools::CloseFiles(nfiles);
-        dfile -> Close();
         return;
 
       }  // end 'Plot(TFile*)'
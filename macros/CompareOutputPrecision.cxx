@@ -0,0 +1,135 @@
+// ============================================================================
+//! \file   CompareOutputPrecision.cxx
+//! \author Derek Anderson
+//! \date   10.17.2026
+// ----------------------------------------------------------------------------
+//! A short macro to compare every histogram in two plotter
+//! outputs bin-by-bin, e.g. to check the accuracy of outputs
+//! stored in single precision against double precision ones.
+//!
+//! Usage:
+//!   root -b -q "macros/CompareOutputPrecision.cxx(\"double.root\", \"float.root\")"
+// ============================================================================
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "../include/elements/PHCorrelatorHistCompare.h"
+
+namespace PHEC = PHEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Compare histograms in a directory (and its subdirectories)
+// ============================================================================
+void CompareDirectory(
+  TDirectory* ref,
+  TDirectory* test,
+  const std::string& path,
+  PHEC::HistCompare::Result& worst,
+  std::size_t& ncompared,
+  std::size_t& nmissing
+) {
+
+  TIter next(ref -> GetListOfKeys());
+  while (TKey* key = (TKey*) next()) {
+
+    TObject*          object = key -> ReadObj();
+    const std::string name   = path.empty() ? key -> GetName() : path + "/" + key -> GetName();
+
+    // recurse into subdirectories
+    if (object -> InheritsFrom("TDirectory")) {
+      TDirectory* sub = (TDirectory*) test -> Get(key -> GetName());
+      if (!sub) {
+        std::cout << "      " << name << ": missing from test file" << std::endl;
+        ++nmissing;
+      } else {
+        CompareDirectory((TDirectory*) object, sub, name, worst, ncompared, nmissing);
+      }
+      delete object;
+      continue;
+    }
+
+    // only compare histograms
+    if (!object -> InheritsFrom("TH1")) {
+      delete object;
+      continue;
+    }
+
+    TH1* hist = (TH1*) test -> Get(key -> GetName());
+    if (!hist) {
+      std::cout << "      " << name << ": missing from test file" << std::endl;
+      ++nmissing;
+      delete object;
+      continue;
+    }
+
+    const PHEC::HistCompare::Result result = PHEC::HistCompare::Compare((TH1*) object, hist);
+    PHEC::HistCompare::Print(name, result);
+    ++ncompared;
+    delete object;
+
+    // keep track of largest deviations
+    worst.compatible  = worst.compatible && result.compatible;
+    worst.ncells     += result.ncells;
+    worst.max_abs     = std::max(worst.max_abs, result.max_abs);
+    worst.max_rel     = std::max(worst.max_rel, result.max_rel);
+    worst.max_abs_err = std::max(worst.max_abs_err, result.max_abs_err);
+    worst.max_rel_err = std::max(worst.max_rel_err, result.max_rel_err);
+  }
+  return;
+
+}  // end 'CompareDirectory(...)'
+
+
+
+// ============================================================================
+//! Compare histograms in two output files
+// ============================================================================
+void CompareOutputPrecision(
+  const std::string sRef = "double.root",
+  const std::string sTest = "float.root",
+  const double tolerance = std::pow(2., -24)
+) {
+
+  std::cout << "\n  Comparing plotter outputs:\n"
+            << "    reference = " << sRef << "\n"
+            << "    test      = " << sTest
+            << std::endl;
+
+  TFile* fRef  = TFile::Open(sRef.data(), "read");
+  TFile* fTest = TFile::Open(sTest.data(), "read");
+  if (!fRef || !fTest) {
+    std::cerr << "PANIC: couldn't open input files!" << std::endl;
+    return;
+  }
+
+  // compare everything in reference file
+  PHEC::HistCompare::Result worst;
+  std::size_t               ncompared = 0;
+  std::size_t               nmissing  = 0;
+  CompareDirectory(fRef, fTest, "", worst, ncompared, nmissing);
+
+  // and summarize
+  std::cout << "    Compared " << ncompared << " histograms (" << nmissing << " missing)." << std::endl;
+  PHEC::HistCompare::Print("overall", worst);
+  if (worst.IsWithin(tolerance) && (nmissing == 0)) {
+    std::cout << "    All deviations within tolerance (" << tolerance << ")." << std::endl;
+  } else {
+    std::cout << "    WARNING: some deviations exceed tolerance (" << tolerance << ")!" << std::endl;
+  }
+
+  fRef  -> Close();
+  fTest -> Close();
+  std::cout << "  Comparison complete!\n" << std::endl;
+  return;
+
+}
+
+// end ========================================================================
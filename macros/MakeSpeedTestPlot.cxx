@@ -4,7 +4,13 @@
 //! \date   03.06.2025
 // ----------------------------------------------------------------------------
 //! A tiny macro to plot the results of the PHEnergyCorrelator
-//! speed test.
+//! speed test. By default, plots the times recorded for the
+//! upstream correlator; if given the output of
+//! RunPairLoopBenchmark.cxx, plots the benchmarked times for
+//! the requested no. of constituents per jet instead.
+//!
+//! Usage:
+//!   root -b -q "macros/MakeSpeedTestPlot.cxx(\"speedTestResults.pairLoop.txt\", 3)"
 // ============================================================================
 
 #include <TCanvas.h>
@@ -12,6 +18,11 @@
 #include <TFile.h>
 #include <TLegend.h>
 #include <TMultiGraph.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
 #include <vector>
 #include <utility>
 
@@ -20,16 +31,18 @@
 // ============================================================================
 //! Make plot of speed test results
 // ============================================================================
-void MakeSpeedTestPlot() {
+void MakeSpeedTestPlot(const std::string& sInput = "", const uint32_t nCst = 3) {
 
   // output file name
-  const std::string sOutName = "speedTestResults_withFactorizedAngleCalc.d10m8y2025.root";
+  const std::string sOutName = sInput.empty()
+                             ? "speedTestResults_withFactorizedAngleCalc.d10m8y2025.root"
+                             : "speedTestResults_pairLoopBenchmark.nCst" + std::to_string(nCst) + ".root";
 
   // legend header (description of parameters)
-  const std::string sHeader = "#bf{N_{jet/evt} = 1, N_{cst/jet} = 3}";
+  const std::string sHeader = "#bf{N_{jet/evt} = 1, N_{cst/jet} = " + std::to_string(nCst) + "}";
 
   // no. of iterations for each test
-  const std::vector<float> vecNumIter = {
+  std::vector<float> vecNumIter = {
     100.,
     1000.,
     10000.,
@@ -43,7 +56,7 @@ void MakeSpeedTestPlot() {
   //   <2> = graph color
   //   <3> = graph marker
   //   <4> = y-values
-  const std::vector<
+  std::vector<
     std::tuple<
       std::string,
       std::string,
@@ -92,12 +105,68 @@ void MakeSpeedTestPlot() {
       "grChange5",
       879,
       27,
-      {0.07, 0.72, 7.26, 72.51, 730,45}
+      {0.07, 0.72, 7.26, 72.51, 730.45}
     }
   };
 
   // --------------------------------------------------------------------------
 
+  // if provided, read benchmark results instead
+  //   columns: description, graph, color, marker, ncst, niter, cpu_s
+  if (!sInput.empty()) {
+
+    std::ifstream input(sInput.data());
+    if (!input) {
+      std::cerr << "PANIC: couldn't open benchmark results " << sInput << "!" << std::endl;
+      return;
+    }
+
+    vecNumIter.clear();
+    vecDescripts.clear();
+
+    std::string line;
+    while (std::getline(input, line)) {
+      if (line.empty() || (line.compare(0, 2, "# ") == 0)) continue;
+
+      // split line on tabs
+      std::vector<std::string> fields;
+      std::stringstream stream(line);
+      std::string field;
+      while (std::getline(stream, field, '\t')) {
+        fields.push_back(field);
+      }
+      if (fields.size() != 7) continue;
+      if (std::stoul(fields[4]) != nCst) continue;
+
+      // add a graph for each new test
+      const std::string graph = fields[1];
+      if (vecDescripts.empty() || (std::get<1>(vecDescripts.back()) != graph)) {
+        vecDescripts.push_back(
+          std::make_tuple(
+            fields[0],
+            graph,
+            (uint32_t) std::stoul(fields[2]),
+            (uint32_t) std::stoul(fields[3]),
+            std::vector<float>()
+          )
+        );
+      }
+      std::get<4>(vecDescripts.back()).push_back( std::stof(fields[6]) );
+
+      // collect iterations of first test
+      if (vecDescripts.size() == 1) {
+        vecNumIter.push_back( std::stof(fields[5]) );
+      }
+    }
+
+    if (vecDescripts.empty()) {
+      std::cerr << "PANIC: no results for N_cst = " << nCst << " in " << sInput << "!" << std::endl;
+      return;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+
   // open file
   TFile* fOut = new TFile(sOutName.data(), "recreate");
   if (!fOut) return;
@@ -0,0 +1,432 @@
+// ============================================================================
+//! \file   RunPairLoopBenchmark.cxx
+//! \author Derek Anderson
+//! \date   10.17.2026
+// ----------------------------------------------------------------------------
+//! A small benchmark of the EEC/Collins pair loop of the
+//! PHEnergyCorrelator. Times the reference kernel in a few
+//! variants (all pairs, unique pairs, and unique pairs with
+//! factorized angle calculation over a structure-of-arrays
+//! constituent layout) for a sweep of N_iter and N_cst/jet,
+//! with 1 jet per event, and writes the CPU times to a
+//! tab-separated file that MakeSpeedTestPlot.cxx reads.
+//!
+//! Usage:
+//!   root -b -q "macros/RunPairLoopBenchmark.cxx+"
+//!   root -b -q "macros/MakeSpeedTestPlot.cxx(\"speedTestResults.pairLoop.txt\", 3)"
+// ============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+
+// ============================================================================
+//! A jet, with constituents laid out as arrays
+// ============================================================================
+struct BenchJet {
+
+  // constituents
+  std::vector<double> pt;
+  std::vector<double> eta;
+  std::vector<double> phi;
+  std::vector<double> px;
+  std::vector<double> py;
+  std::vector<double> pz;
+
+  // jet & spin
+  double ptJet;
+  double axis[3];
+  double spin[3];
+
+};  // end BenchJet
+
+
+
+// ============================================================================
+//! Histograms filled by the pair loop
+// ============================================================================
+struct BenchHists {
+
+  // binning
+  static const std::size_t nRL    = 75;
+  static const std::size_t nAngle = 32;
+
+  // contents
+  std::vector<double> eec;
+  std::vector<double> collins;
+
+  BenchHists() : eec(nRL + 2, 0.), collins(nAngle + 2, 0.) {}
+
+  // --------------------------------------------------------------------------
+  //! Fill a pair (log bins in RL from 1e-5 to 1, uniform in angle)
+  // --------------------------------------------------------------------------
+  void Fill(const double rl, const double angle, const double weight) {
+
+    const double lrl  = (std::log10(rl) + 5.) * (nRL / 5.);
+    const double lang = (angle + M_PI) * (nAngle / (2. * M_PI));
+    const std::size_t irl  = (lrl < 0.) ? 0 : ((lrl >= nRL) ? nRL + 1 : (std::size_t) lrl + 1);
+    const std::size_t iang = (lang < 0.) ? 0 : ((lang >= nAngle) ? nAngle + 1 : (std::size_t) lang + 1);
+    eec[irl]      += weight;
+    collins[iang] += weight;
+
+  }  // end 'Fill(double, double, double)'
+
+  // --------------------------------------------------------------------------
+  //! Sum of contents
+  // --------------------------------------------------------------------------
+  double Sum() const {
+
+    double sum = 0.;
+    for (std::size_t ibin = 0; ibin < eec.size(); ++ibin) sum += eec[ibin];
+    for (std::size_t ibin = 0; ibin < collins.size(); ++ibin) sum += collins[ibin];
+    return sum;
+
+  }  // end 'Sum()'
+
+  // --------------------------------------------------------------------------
+  //! Count bins differing from another set by more than a relative tolerance
+  // --------------------------------------------------------------------------
+  std::size_t CountMismatches(const BenchHists& other, const double tol) const {
+
+    std::size_t nbad = 0;
+    for (std::size_t ibin = 0; ibin < eec.size(); ++ibin) {
+      const double scale = std::max(std::fabs(eec[ibin]), std::fabs(other.eec[ibin]));
+      if (std::fabs(eec[ibin] - other.eec[ibin]) > tol * scale) ++nbad;
+    }
+    for (std::size_t ibin = 0; ibin < collins.size(); ++ibin) {
+      const double scale = std::max(std::fabs(collins[ibin]), std::fabs(other.collins[ibin]));
+      if (std::fabs(collins[ibin] - other.collins[ibin]) > tol * scale) ++nbad;
+    }
+    return nbad;
+
+  }  // end 'CountMismatches(BenchHists&, double)'
+
+};  // end BenchHists
+
+
+
+// ============================================================================
+//! Per-constituent scratch arrays, reused across jets
+// ============================================================================
+struct BenchScratch {
+
+  std::vector<double> a1;
+  std::vector<double> a2;
+  std::vector<double> z;
+
+};  // end BenchScratch
+
+
+
+// ============================================================================
+//! Helpers for the pair loop
+// ============================================================================
+namespace BenchKernel {
+
+  // --------------------------------------------------------------------------
+  //! Wrap an angle into (-pi, pi]
+  // --------------------------------------------------------------------------
+  inline double Wrap(double angle) {
+
+    while (angle >  M_PI) angle -= 2. * M_PI;
+    while (angle <= -M_PI) angle += 2. * M_PI;
+    return angle;
+
+  }  // end 'Wrap(double)'
+
+  // --------------------------------------------------------------------------
+  //! Unit jet axis n, and basis (e1, e2) of the plane transverse to it
+  // --------------------------------------------------------------------------
+  /*! e1 is along (beam x n), so angles in the transverse
+   *  plane are measured relative to the beam-jet plane.
+   */
+  inline void MakeFrame(const BenchJet& jet, double* n, double* e1, double* e2) {
+
+    n[0] = jet.axis[0]; n[1] = jet.axis[1]; n[2] = jet.axis[2];
+    const double nnorm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    n[0] /= nnorm; n[1] /= nnorm; n[2] /= nnorm;
+
+    // beam x n, beam along z
+    e1[0] = -n[1]; e1[1] = n[0]; e1[2] = 0.;
+    const double enorm = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1]);
+    e1[0] /= enorm; e1[1] /= enorm;
+
+    // n x e1
+    e2[0] = n[1] * e1[2] - n[2] * e1[1];
+    e2[1] = n[2] * e1[0] - n[0] * e1[2];
+    e2[2] = n[0] * e1[1] - n[1] * e1[0];
+
+  }  // end 'MakeFrame(BenchJet&, double* x 3)'
+
+  // --------------------------------------------------------------------------
+  //! Compute & fill one pair from scratch
+  // --------------------------------------------------------------------------
+  /*! This is the reference calculation: the frame and the
+   *  spin's azimuth in it are rebuilt for every pair.
+   */
+  inline void FillPair(const BenchJet& jet, const std::size_t i, const std::size_t j, BenchHists& hists) {
+
+    double n[3], e1[3], e2[3];
+    MakeFrame(jet, n, e1, e2);
+
+    // distance between constituents
+    const double deta = jet.eta[i] - jet.eta[j];
+    const double dphi = Wrap(jet.phi[i] - jet.phi[j]);
+    const double rl   = std::sqrt(deta * deta + dphi * dphi);
+
+    // relative momentum transverse to jet
+    const double r[3]  = {0.5 * (jet.px[i] - jet.px[j]), 0.5 * (jet.py[i] - jet.py[j]), 0.5 * (jet.pz[i] - jet.pz[j])};
+    const double phiR  = std::atan2(r[0] * e2[0] + r[1] * e2[1] + r[2] * e2[2], r[0] * e1[0] + r[1] * e1[1] + r[2] * e1[2]);
+    const double phiS  = std::atan2(
+      jet.spin[0] * e2[0] + jet.spin[1] * e2[1] + jet.spin[2] * e2[2],
+      jet.spin[0] * e1[0] + jet.spin[1] * e1[1] + jet.spin[2] * e1[2]
+    );
+
+    const double weight = (jet.pt[i] * jet.pt[j]) / (jet.ptJet * jet.ptJet);
+    hists.Fill(rl, Wrap(phiS - phiR), weight);
+
+  }  // end 'FillPair(BenchJet&, std::size_t x 2, BenchHists&)'
+
+  // --------------------------------------------------------------------------
+  //! Kernel 1: all ordered pairs
+  // --------------------------------------------------------------------------
+  void AllPairs(const BenchJet& jet, BenchHists& hists, BenchScratch& /*scratch*/) {
+
+    const std::size_t ncst = jet.pt.size();
+    for (std::size_t i = 0; i < ncst; ++i) {
+      for (std::size_t j = 0; j < ncst; ++j) {
+        if (i == j) continue;
+        FillPair(jet, i, j, hists);
+      }
+    }
+
+  }  // end 'AllPairs(BenchJet&, BenchHists&, BenchScratch&)'
+
+  // --------------------------------------------------------------------------
+  //! Kernel 2: unique pairs only
+  // --------------------------------------------------------------------------
+  void UniquePairs(const BenchJet& jet, BenchHists& hists, BenchScratch& /*scratch*/) {
+
+    const std::size_t ncst = jet.pt.size();
+    for (std::size_t i = 0; i < ncst; ++i) {
+      for (std::size_t j = i + 1; j < ncst; ++j) {
+        FillPair(jet, i, j, hists);
+      }
+    }
+
+  }  // end 'UniquePairs(BenchJet&, BenchHists&, BenchScratch&)'
+
+  // --------------------------------------------------------------------------
+  //! Kernel 3: unique pairs with factorized angle calculation
+  // --------------------------------------------------------------------------
+  /*! The frame and spin azimuth are built once per jet, and
+   *  each constituent is projected onto the frame once; since
+   *  e1 and e2 are transverse to the jet, the projections of
+   *  a pair's relative momentum are just differences of its
+   *  constituents' projections. Per-constituent quantities
+   *  sit in contiguous arrays so the inner loop streams
+   *  through them; the arrays are reused across jets, so
+   *  nothing is allocated once they've grown to N_cst.
+   */
+  void Factorized(const BenchJet& jet, BenchHists& hists, BenchScratch& scratch) {
+
+    double n[3], e1[3], e2[3];
+    MakeFrame(jet, n, e1, e2);
+    const double phiS = std::atan2(
+      jet.spin[0] * e2[0] + jet.spin[1] * e2[1] + jet.spin[2] * e2[2],
+      jet.spin[0] * e1[0] + jet.spin[1] * e1[1] + jet.spin[2] * e1[2]
+    );
+
+    const std::size_t ncst = jet.pt.size();
+    const double      norm = 1. / (jet.ptJet * jet.ptJet);
+    scratch.a1.resize(ncst);
+    scratch.a2.resize(ncst);
+    scratch.z.resize(ncst);
+
+    double* a1 = &scratch.a1[0];
+    double* a2 = &scratch.a2[0];
+    double* z  = &scratch.z[0];
+    for (std::size_t icst = 0; icst < ncst; ++icst) {
+      a1[icst] = jet.px[icst] * e1[0] + jet.py[icst] * e1[1] + jet.pz[icst] * e1[2];
+      a2[icst] = jet.px[icst] * e2[0] + jet.py[icst] * e2[1] + jet.pz[icst] * e2[2];
+      z[icst]  = jet.pt[icst];
+    }
+
+    for (std::size_t i = 0; i < ncst; ++i) {
+      for (std::size_t j = i + 1; j < ncst; ++j) {
+        const double deta = jet.eta[i] - jet.eta[j];
+        const double dphi = Wrap(jet.phi[i] - jet.phi[j]);
+        const double phiR = std::atan2(0.5 * (a2[i] - a2[j]), 0.5 * (a1[i] - a1[j]));
+        hists.Fill(std::sqrt(deta * deta + dphi * dphi), Wrap(phiS - phiR), z[i] * z[j] * norm);
+      }
+    }
+
+  }  // end 'Factorized(BenchJet&, BenchHists&, BenchScratch&)'
+
+}  // end BenchKernel namespace
+
+
+
+// ============================================================================
+//! Generate a pool of random jets
+// ============================================================================
+/*! Uses a fixed linear congruential generator so every
+ *  run sees the same events.
+ */
+std::vector<BenchJet> MakeJets(const std::size_t njet, const std::size_t ncst) {
+
+  unsigned long state = 12345UL + ncst;
+  struct Uniform {
+    static double Next(unsigned long& s) {
+      s = (1103515245UL * s + 12345UL) & 0x7fffffffUL;
+      return s / 2147483648.;
+    }
+  };
+
+  std::vector<BenchJet> jets(njet);
+  for (std::size_t ijet = 0; ijet < njet; ++ijet) {
+
+    BenchJet& jet = jets[ijet];
+    const double etaJet = -0.7 + 1.4 * Uniform::Next(state);
+    const double phiJet = -M_PI + 2. * M_PI * Uniform::Next(state);
+
+    jet.ptJet   = 0.;
+    jet.axis[0] = 0.;
+    jet.axis[1] = 0.;
+    jet.axis[2] = 0.;
+    for (std::size_t icst = 0; icst < ncst; ++icst) {
+      const double pt  = 0.2 + 5. * Uniform::Next(state);
+      const double eta = etaJet + 0.4 * (Uniform::Next(state) - 0.5);
+      const double phi = BenchKernel::Wrap(phiJet + 0.4 * (Uniform::Next(state) - 0.5));
+      jet.pt.push_back(pt);
+      jet.eta.push_back(eta);
+      jet.phi.push_back(phi);
+      jet.px.push_back(pt * std::cos(phi));
+      jet.py.push_back(pt * std::sin(phi));
+      jet.pz.push_back(pt * std::sinh(eta));
+      jet.ptJet   += pt;
+      jet.axis[0] += jet.px.back();
+      jet.axis[1] += jet.py.back();
+      jet.axis[2] += jet.pz.back();
+    }
+
+    // transverse spin, up or down
+    const double sign = (Uniform::Next(state) < 0.5) ? 1. : -1.;
+    jet.spin[0] = 0.;
+    jet.spin[1] = sign;
+    jet.spin[2] = 0.;
+  }
+  return jets;
+
+}  // end 'MakeJets(std::size_t, std::size_t)'
+
+
+
+// ============================================================================
+//! Run benchmark
+// ============================================================================
+void RunPairLoopBenchmark(const std::string& sOutName = "speedTestResults.pairLoop.txt") {
+
+  // no. of iterations (events) for each test
+  const std::vector<std::size_t> vecNumIter = {
+    100,
+    1000,
+    10000,
+    100000,
+    1000000
+  };
+
+  // no. of constituents per jet to test
+  const std::vector<std::size_t> vecNumCst = {3, 10, 30};
+
+  // no. of distinct events to cycle through
+  const std::size_t nPool = 1000;
+
+  // max relative difference allowed between kernels' bins
+  const double tolerance = 1e-9;
+
+  // kernel description, graph name, color, marker, and kernel
+  typedef void (*Kernel)(const BenchJet&, BenchHists&, BenchScratch&);
+  struct Test {
+    std::string description;
+    std::string graph;
+    unsigned    color;
+    unsigned    marker;
+    Kernel      kernel;
+  };
+  const std::vector<Test> vecTests = {
+    {"#bf{Reference:} all pairs", "grAllPairs", 923, 20, &BenchKernel::AllPairs},
+    {"#bf{Change 1:} look at only unique pairs", "grUniquePairs", 908, 32, &BenchKernel::UniquePairs},
+    {"#bf{Change 2:} factorize angle calculations", "grFactorized", 879, 27, &BenchKernel::Factorized}
+  };
+
+  // --------------------------------------------------------------------------
+
+  std::ofstream out(sOutName.data());
+  if (!out) {
+    std::cerr << "PANIC: couldn't open output file " << sOutName << "!" << std::endl;
+    return;
+  }
+  out << "# description\tgraph\tcolor\tmarker\tncst\tniter\tcpu_s\n";
+
+  std::cout << "\n  Beginning pair loop benchmark..." << std::endl;
+  for (const std::size_t ncst : vecNumCst) {
+
+    const std::vector<BenchJet> jets = MakeJets(nPool, ncst);
+
+    // check kernels agree (all pairs double count)
+    BenchHists   hAll, hUnique, hFactor;
+    BenchScratch check;
+    for (const BenchJet& jet : jets) {
+      BenchKernel::AllPairs(jet, hAll, check);
+      BenchKernel::UniquePairs(jet, hUnique, check);
+      BenchKernel::Factorized(jet, hFactor, check);
+    }
+    std::cout << "    N_cst = " << ncst << ": sum(all) / 2 = " << hAll.Sum() / 2.
+              << ", sum(unique) = " << hUnique.Sum()
+              << ", sum(factorized) = " << hFactor.Sum()
+              << std::endl;
+
+    // and that factorizing doesn't change any bin
+    const std::size_t nbad = hUnique.CountMismatches(hFactor, tolerance);
+    if (nbad > 0) {
+      std::cerr << "PANIC: factorized kernel differs from unique pairs in "
+                << nbad << " bins (N_cst = " << ncst << ")!"
+                << std::endl;
+      std::exit(1);
+    }
+
+    for (const Test& test : vecTests) {
+      for (const std::size_t niter : vecNumIter) {
+
+        BenchHists   hists;
+        BenchScratch scratch;
+        const std::clock_t start = std::clock();
+        for (std::size_t iter = 0; iter < niter; ++iter) {
+          test.kernel(jets[iter % nPool], hists, scratch);
+        }
+        const double cpu = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+        out << test.description << "\t" << test.graph << "\t"
+            << test.color << "\t" << test.marker << "\t"
+            << ncst << "\t" << niter << "\t" << cpu
+            << "\n";
+        std::cout << "      " << test.graph << ", N_iter = " << niter
+                  << ": " << cpu << " s (checksum " << hists.Sum() << ")"
+                  << std::endl;
+      }
+    }
+  }
+  std::cout << "  Finished benchmark! Results written to " << sOutName << ".\n" << std::endl;
+
+}
+
+// end ========================================================================
@@ -0,0 +1,290 @@
+# =============================================================================
+# @file   PHCorrelatorPlotter.py
+# @author Derek Anderson
+# @date   10.17.2026
+#
+# Python bindings for the PHCorrelatorPlotter library.
+#
+# The library is header-only, so it's bound through PyROOT (cppyy):
+# the headers are JIT-ed once on import and every class/function in
+# the PHEnergyCorrelator namespace (Input, PlotIndexVector, Tools,
+# Hist1D/Hist2D, etc.) is then available as is. On top of that, this
+# module exposes bin contents, squared errors, and edges of native
+# (Hist1D/Hist2D) and ROOT (TH1/TH2/TH3) histograms as zero-copy NumPy
+# views, so spectra can be consumed without calling GetBinContent(...)
+# bin by bin.
+#
+# Views point straight into the histogram's storage: writes through
+# them change the histogram. Each view keeps its histogram alive, but
+# is only valid as long as the histogram isn't rebinned. Edges of
+# native histograms are shared between histograms, so their views are
+# read-only.
+#
+# Usage:
+#   import PHCorrelatorPlotter as phec
+#   hist = phec.PHEC.Hist1D(th1)
+#   cont = phec.content(hist)
+# =============================================================================
+
+import os
+
+import numpy as np
+import ROOT
+
+# path to library headers (can be overridden before import)
+INCLUDE = os.environ.get(
+    "PHEC_INCLUDE",
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include")
+)
+
+# JIT library and grab namespace
+if not hasattr(ROOT, "PHEnergyCorrelator"):
+    ROOT.gInterpreter.Declare(
+        '#include "' + os.path.join(INCLUDE, "PHCorrelatorPlotter.h") + '"'
+    )
+PHEC = ROOT.PHEnergyCorrelator
+
+
+
+# -----------------------------------------------------------------------------
+#! NumPy view which keeps the owner of its memory alive
+# -----------------------------------------------------------------------------
+class _View(np.ndarray):
+    """Array holding a reference to the object owning its memory
+
+    The reference is passed on to any array derived from it
+    (e.g. by reshape or slicing).
+    """
+    def __array_finalize__(self, obj):
+        self._owner = getattr(obj, "_owner", None)
+
+# end '_View'
+
+
+
+# -----------------------------------------------------------------------------
+#! Wrap a C++ array as a NumPy view
+# -----------------------------------------------------------------------------
+def _view(ptr, size, owner, dtype = np.float64, writeable = True):
+    """Returns a NumPy array sharing memory with a C++ array
+
+    Arguments:
+      ptr:       pointer to first element (cppyy low-level view)
+      size:      number of elements
+      owner:     object owning the array (kept alive by the view)
+      dtype:     element type
+      writeable: if False, view is read-only
+    """
+    if size == 0:
+        return np.empty(0, dtype = dtype)
+    ptr.reshape((size,))
+    arr = np.frombuffer(ptr, dtype = dtype, count = size).view(_View)
+    arr._owner = owner
+    arr.flags.writeable = writeable
+    return arr
+
+# end '_view(ptr, int, object, dtype, bool)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Check if a histogram is a native (Hist1D/Hist2D) one
+# -----------------------------------------------------------------------------
+def _is_native(hist):
+    return isinstance(hist, (PHEC.Hist1D, PHEC.Hist2D))
+
+# end '_is_native(hist)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Get shape of a histogram's cells (incl. under/overflow)
+# -----------------------------------------------------------------------------
+def shape(hist):
+    """Returns shape of cells, ordered like ROOT's global bins
+
+    ROOT (and Hist2D) global bins run fastest in x, so a
+    2D histogram has shape (ny + 2, nx + 2) and cell [iy, ix]
+    is bin (ix, iy). Native histograms without any bins
+    have no storage, and so have no cells.
+    """
+    if isinstance(hist, PHEC.Hist1D):
+        if hist.GetEdges().empty():
+            return (0,)
+        return (hist.GetNbins() + 2,)
+    if isinstance(hist, PHEC.Hist2D):
+        if hist.GetXEdges().empty() or hist.GetYEdges().empty():
+            return (0, 0)
+        return (hist.GetNbinsY() + 2, hist.GetNbinsX() + 2)
+
+    ndim = hist.GetDimension()
+    dims = [hist.GetNbinsX() + 2, hist.GetNbinsY() + 2, hist.GetNbinsZ() + 2]
+    return tuple(reversed(dims[:ndim]))
+
+# end 'shape(hist)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Get bin contents as a view
+# -----------------------------------------------------------------------------
+def content(hist):
+    """Returns bin contents (incl. under/overflow) as a view
+
+    TH1F/TH2F/TH3F contents are viewed as float32, TH1D/TH2D/TH3D
+    (and native histograms) as float64.
+    """
+    size = int(np.prod(shape(hist)))
+    if _is_native(hist):
+        return _view(hist.Content(), size, hist).reshape(shape(hist))
+
+    if isinstance(hist, ROOT.TArrayF):
+        return _view(hist.GetArray(), size, hist, np.float32).reshape(shape(hist))
+    if isinstance(hist, ROOT.TArrayD):
+        return _view(hist.GetArray(), size, hist).reshape(shape(hist))
+    raise TypeError("can't view contents of " + type(hist).__name__)
+
+# end 'content(hist)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Get sum of squared weights as a view
+# -----------------------------------------------------------------------------
+def sumw2(hist):
+    """Returns sum of squared weights per bin as a view
+
+    ROOT histograms without Sumw2() set don't store squared
+    weights (their errors are sqrt(content)), so for them this
+    returns None.
+    """
+    if _is_native(hist):
+        size = int(np.prod(shape(hist)))
+        return _view(hist.Sumw2(), size, hist).reshape(shape(hist))
+
+    if hist.GetSumw2N() == 0:
+        return None
+    return _view(hist.GetSumw2().GetArray(), hist.GetSumw2N(), hist).reshape(shape(hist))
+
+# end 'sumw2(hist)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Get bin errors
+# -----------------------------------------------------------------------------
+def errors(hist):
+    """Returns bin errors (a new array, since they're computed)"""
+    sw2 = sumw2(hist)
+    if sw2 is None:
+        return np.sqrt(np.abs(content(hist)))
+    return np.sqrt(sw2)
+
+# end 'errors(hist)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Get bin edges of an axis
+# -----------------------------------------------------------------------------
+def edges(hist, axis = 0):
+    """Returns bin edges along an axis (0 = x, 1 = y, 2 = z)
+
+    Native histograms and variable-width ROOT axes store
+    their edges, so those are views. Native binnings are
+    shared between histograms, so their views are read-only.
+    Fixed-width ROOT axes only store their limits, so those
+    are computed.
+    """
+    if isinstance(hist, PHEC.Hist1D):
+        vec = hist.GetEdges()
+        return _view(vec.data(), vec.size(), hist, writeable = False)
+    if isinstance(hist, PHEC.Hist2D):
+        vec = hist.GetXEdges() if axis == 0 else hist.GetYEdges()
+        return _view(vec.data(), vec.size(), hist, writeable = False)
+
+    tax = [hist.GetXaxis, hist.GetYaxis, hist.GetZaxis][axis]()
+    arr = tax.GetXbins()
+    if arr.GetSize() > 0:
+        return _view(arr.GetArray(), arr.GetSize(), hist)
+    return np.linspace(tax.GetXmin(), tax.GetXmax(), tax.GetNbins() + 1)
+
+# end 'edges(hist, int)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Expand a PlotIndexVector into an array of indices
+# -----------------------------------------------------------------------------
+def indices(vec):
+    """Returns the indices of a PlotIndexVector
+
+    Indices are returned as an (n, 6) integer array with
+    columns (level, species, pt, cf, chrg, spin), along with
+    the underlying std::vector<PlotIndex> to hand back to C++.
+    """
+    idxs = ROOT.std.vector(PHEC.Type.PlotIndex)()
+    vec.GetVector(idxs)
+
+    arr = np.empty((idxs.size(), 6), dtype = np.int32)
+    for iidx, idx in enumerate(idxs):
+        arr[iidx] = (idx.level, idx.species, idx.pt, idx.cf, idx.chrg, idx.spin)
+    return arr, idxs
+
+# end 'indices(PlotIndexVector)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Load a sweep of spectra
+# -----------------------------------------------------------------------------
+def sweep(inputs, variable, vec, tag = ""):
+    """Loads a spectrum for each index of a PlotIndexVector
+
+    Uses the Input name builders to find each spectrum and
+    returns a list of dicts with its index, name, legend,
+    and native histogram; contents/errors/edges can then be
+    viewed with the functions above.
+
+    Arguments:
+      inputs:   PHEC.Input to build names with
+      variable: variable to load (e.g. "EEC")
+      vec:      PHEC.PlotIndexVector to sweep over
+      tag:      optional histogram name tag
+    """
+    arr, idxs = indices(vec)
+
+    spectra = []
+    for iidx in range(idxs.size()):
+        idx  = idxs[iidx]
+        name = str(inputs.MakeHistName(variable, idx, tag))
+        path = str(inputs.GetFiles().GetFile(idx))
+
+        tfile = ROOT.TFile.Open(path, "read")
+        if not tfile or tfile.IsZombie():
+            raise IOError("couldn't open file '" + path + "'")
+        thist = tfile.Get(name)
+        if not thist:
+            raise KeyError("couldn't grab '" + name + "' from '" + path + "'")
+
+        # copy into a native histogram so file can be closed
+        ndim = thist.GetDimension()
+        if ndim == 1:
+            hist = PHEC.Hist1D(thist)
+        elif ndim == 2:
+            hist = PHEC.Hist2D(thist)
+        tfile.Close()
+        if ndim > 2:
+            raise TypeError("can't load '" + name + "': only 1D and 2D spectra are supported")
+
+        spectra.append({
+            "index":  arr[iidx],
+            "name":   name,
+            "legend": str(inputs.MakeLegend(idx)),
+            "hist":   hist
+        })
+    return spectra
+
+# end 'sweep(Input, str, PlotIndexVector, str)'
+
+# end =========================================================================
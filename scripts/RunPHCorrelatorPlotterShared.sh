@@ -0,0 +1,46 @@
+#!/bin/bash
+# =============================================================================
+# @file   RunPHCorrelatorPlotterShared.sh
+# @author Derek Anderson
+# @date   10.17.2026
+#
+# Short script to run the driver macro for plotting,
+# RunPHCorrelatorPlotter.C, as several processes at
+# once which share one copy of the inputs in shared
+# memory. The segment is removed on exit, even if a
+# step fails.
+# =============================================================================
+
+set -e
+
+SEGMENT="/phec"
+
+# compile driver and publisher once before running them
+# (later steps load them with .C+, which reuses the
+# compiled libraries instead of recompiling)
+root -b -l -q -e ".L RunPHCorrelatorPlotter.C++"
+root -b -l -q -e ".L PublishPHCorrelatorInputs.C++"
+
+# remove any segment left behind by an earlier run, and
+# make sure this run's segment is removed however it ends
+root -b -q "PublishPHCorrelatorInputs.C+(\"$SEGMENT\", true)"
+trap 'root -b -q "PublishPHCorrelatorInputs.C+(\"$SEGMENT\", true)"' EXIT
+
+# publish inputs (stops here if this fails)
+root -b -q "PublishPHCorrelatorInputs.C+(\"$SEGMENT\")"
+
+# run plotting routines in parallel
+pids=()
+for plot in 0 1 2 3; do
+  root -b -q "RunPHCorrelatorPlotter.C+($plot, true, false, 0., \"$SEGMENT\")" &
+  pids+=($!)
+done
+
+# and collect their exit statuses
+status=0
+for pid in "${pids[@]}"; do
+  wait "$pid" || status=1
+done
+exit $status
+
+# end =========================================================================
@@ -0,0 +1,407 @@
+# =============================================================================
+# @file   PHCorrelatorViewer.py
+# @author Derek Anderson
+# @date   10.17.2026
+#
+# Local HTTP viewer for the outputs of the plotter.
+#
+# Serves the viewer page (index.html), the JSROOT installed with ROOT,
+# and the output files themselves from this machine only. Files are
+# served with HTTP range requests, so JSROOT reads each object on
+# demand by byte range rather than opening whole files.
+#
+# Each file gets an index of its objects (name, class, key position,
+# and the wiring/index parsed from its name), built once with PyROOT
+# and cached next to the thumbnails until the file changes. Thumbnails
+# are rendered by JSROOT in the browser the first time an object
+# scrolls into view, then stored here so later views just load images.
+#
+# Usage:
+#   python3 viewer/PHCorrelatorViewer.py simVsDataEEC.*.root [--port 8080]
+# =============================================================================
+
+import argparse
+import hashlib
+import json
+import mimetypes
+import os
+import re
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, unquote, urlparse
+
+# where viewer page lives
+VIEWER = os.path.dirname(os.path.abspath(__file__))
+
+# where JSROOT lives (shipped with ROOT under $ROOTSYS/js)
+JSROOT = os.environ.get(
+    "JSROOTSYS",
+    os.path.join(os.environ.get("ROOTSYS", ""), "js")
+)
+
+# biggest thumbnail accepted (bytes)
+MAX_THUMB = 4 << 20
+
+
+
+# -----------------------------------------------------------------------------
+#! Hash a string
+# -----------------------------------------------------------------------------
+def _hash(text):
+    return hashlib.sha1(text.encode("utf-8")).hexdigest()
+
+# end '_hash(str)'
+
+
+
+# -----------------------------------------------------------------------------
+#! Split an object name into wiring group and index
+# -----------------------------------------------------------------------------
+def split_name(name):
+    """Splits e.g. "cEECSimVsData_PPData_ptJet10" into
+    ("cEECSimVsData", "PPData_ptJet10"): canvas and histogram
+    names are built as a base followed by index tags (see
+    `Input::MakeCanvasName(...)` and `Input::MakeHistName(...)`).
+    """
+    leaf  = name.rsplit("/", 1)[-1]
+    parts = re.split(r"_+", leaf, maxsplit = 1)
+    if len(parts) == 1:
+        return leaf, ""
+    return parts[0], parts[1]
+
+# end 'split_name(str)'
+
+
+
+# =============================================================================
+#! Per-file index of objects
+# =============================================================================
+class FileIndex:
+    """Builds (once) and caches the index of each output file
+
+    An index is rebuilt only if its file's size or
+    modification time changed since it was built.
+    """
+
+    def __init__(self, cache):
+        self.cache = os.path.join(cache, "index")
+        self.lock  = threading.Lock()
+        os.makedirs(self.cache, exist_ok = True)
+
+    # -------------------------------------------------------------------------
+    #! Stamp identifying a version of a file
+    # -------------------------------------------------------------------------
+    @staticmethod
+    def stamp(path):
+        info = os.stat(path)
+        return "%d:%d" % (info.st_size, info.st_mtime_ns)
+
+    # -------------------------------------------------------------------------
+    #! Get index of a file (building it if need be)
+    # -------------------------------------------------------------------------
+    def get(self, path):
+        stamp = self.stamp(path)
+        ipath = os.path.join(self.cache, _hash(path) + ".json")
+        with self.lock:
+            if os.path.exists(ipath):
+                with open(ipath) as ifile:
+                    index = json.load(ifile)
+                if index.get("file") == path and index.get("stamp") == stamp:
+                    return index
+
+            index = {"file": path, "stamp": stamp, "objects": self.build(path, stamp)}
+            with open(ipath + ".tmp", "w") as ifile:
+                json.dump(index, ifile)
+            os.replace(ipath + ".tmp", ipath)
+            return index
+
+    # -------------------------------------------------------------------------
+    #! Build index of a file
+    # -------------------------------------------------------------------------
+    def build(self, path, stamp):
+        """Walks the keys of a file (and its directories)
+
+        Only keys are read, not objects; if a name has
+        several cycles only the latest is kept.
+        """
+        import ROOT
+
+        tfile = ROOT.TFile.Open(path, "read")
+        if not tfile or tfile.IsZombie():
+            raise IOError("couldn't open '" + path + "'")
+
+        objects = []
+        def walk(tdir, prefix):
+            seen = set()
+            for key in tdir.GetListOfKeys():
+                name = prefix + key.GetName()
+                if name in seen:
+                    continue
+                seen.add(name)
+
+                cls = key.GetClassName()
+                if ROOT.TClass.GetClass(cls).InheritsFrom("TDirectory"):
+                    walk(key.ReadObj(), name + "/")
+                    continue
+
+                group, index = split_name(name)
+                objects.append({
+                    "name":   name,
+                    "cycle":  key.GetCycle(),
+                    "class":  cls,
+                    "title":  key.GetTitle(),
+                    "seek":   int(key.GetSeekKey()),
+                    "nbytes": key.GetNbytes(),
+                    "group":  group,
+                    "index":  index,
+                    "thumb":  _hash(path + "|" + stamp + "|" + name + ";" + str(key.GetCycle()))
+                })
+
+        walk(tfile, "")
+        tfile.Close()
+        return objects
+
+# end FileIndex
+
+
+
+# =============================================================================
+#! Request handler
+# =============================================================================
+class Handler(BaseHTTPRequestHandler):
+    """Serves the page, JSROOT, file indices, file byte
+    ranges, and thumbnails
+    """
+
+    # set by Serve(...)
+    files  = []
+    index  = None
+    thumbs = ""
+
+    # -------------------------------------------------------------------------
+    #! Quieter logging
+    # -------------------------------------------------------------------------
+    def log_message(self, fmt, *args):
+        pass
+
+    # -------------------------------------------------------------------------
+    #! Send a small response
+    # -------------------------------------------------------------------------
+    def reply(self, code, body = b"", ctype = "text/plain", head = False, keep = False):
+        self.send_response(code)
+        self.send_header("Content-Type", ctype)
+        if keep:
+            self.send_header("Cache-Control", "max-age=31536000, immutable")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        if not head:
+            self.wfile.write(body)
+
+    # -------------------------------------------------------------------------
+    #! Send a static file from under a root directory
+    # -------------------------------------------------------------------------
+    def static(self, root, rel, head = False, keep = False):
+        path = os.path.realpath(os.path.join(root, rel))
+        if not path.startswith(os.path.realpath(root) + os.sep) or not os.path.isfile(path):
+            return self.reply(404, b"not found")
+
+        ctype = mimetypes.guess_type(path)[0] or "application/octet-stream"
+        if path.endswith(".mjs"):
+            ctype = "application/javascript"
+        with open(path, "rb") as sfile:
+            self.reply(200, sfile.read(), ctype, head, keep)
+
+    # -------------------------------------------------------------------------
+    #! Send byte range(s) of an output file
+    # -------------------------------------------------------------------------
+    def ranges(self, path, head = False):
+        """Answers HEAD/GET with Range: bytes=a-b[,c-d...], as
+        JSROOT reads files; several ranges are sent back as
+        multipart/byteranges. Malformed ranges are answered
+        with 400, and ranges starting past the end of the
+        file with 416.
+        """
+        size  = os.path.getsize(path)
+        spec  = self.headers.get("Range", "")
+        parts = []
+        if spec.startswith("bytes="):
+            try:
+                for item in spec[len("bytes="):].split(","):
+                    start, dash, stop = item.strip().partition("-")
+                    if not dash or not (start + stop).isdigit():
+                        raise ValueError(item)
+                    if start == "":
+                        # suffix range (last n bytes, at most whole file)
+                        start, stop = size - min(int(stop), size), size - 1
+                    else:
+                        if stop and int(stop) < int(start):
+                            raise ValueError(item)
+                        start, stop = int(start), (int(stop) if stop else size - 1)
+                    parts.append((start, min(stop, size - 1)))
+            except ValueError:
+                return self.reply(400, b"bad range", head = head)
+
+            # nothing to send for a range past the end
+            if any(start >= size for start, stop in parts):
+                self.send_response(416)
+                self.send_header("Content-Range", "bytes */%d" % size)
+                self.send_header("Content-Length", "0")
+                self.end_headers()
+                return
+
+        # no range: whole file
+        if not parts:
+            self.send_response(200)
+            self.send_header("Accept-Ranges", "bytes")
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Length", str(size))
+            self.end_headers()
+            if not head:
+                with open(path, "rb") as rfile:
+                    while True:
+                        chunk = rfile.read(1 << 20)
+                        if not chunk:
+                            break
+                        self.wfile.write(chunk)
+            return
+
+        with open(path, "rb") as rfile:
+            blocks = []
+            for start, stop in parts:
+                rfile.seek(start)
+                blocks.append((start, stop, rfile.read(stop - start + 1)))
+
+        self.send_response(206)
+        self.send_header("Accept-Ranges", "bytes")
+        if len(blocks) == 1:
+            start, stop, data = blocks[0]
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Range", "bytes %d-%d/%d" % (start, stop, size))
+            body = data
+        else:
+            boundary = "phecviewer" + _hash(spec)[:16]
+            self.send_header("Content-Type", "multipart/byteranges; boundary=" + boundary)
+            body = b""
+            for start, stop, data in blocks:
+                body += ("--%s\r\nContent-Type: application/octet-stream\r\n"
+                         "Content-Range: bytes %d-%d/%d\r\n\r\n" % (boundary, start, stop, size)).encode()
+                body += data + b"\r\n"
+            body += ("--%s--\r\n" % boundary).encode()
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        if not head:
+            self.wfile.write(body)
+
+    # -------------------------------------------------------------------------
+    #! Look up a served output file by id
+    # -------------------------------------------------------------------------
+    def output(self, fid):
+        try:
+            return self.files[int(fid)]
+        except (ValueError, IndexError):
+            return None
+
+    # -------------------------------------------------------------------------
+    #! Handle GET/HEAD
+    # -------------------------------------------------------------------------
+    def do_GET(self, head = False):
+        url   = urlparse(self.path)
+        route = unquote(url.path)
+        query = parse_qs(url.query)
+
+        if route in ("/", "/index.html"):
+            return self.static(VIEWER, "index.html", head)
+
+        if route.startswith("/jsroot/"):
+            return self.static(JSROOT, route[len("/jsroot/"):], head)
+
+        if route == "/api/files":
+            files = [{"id": ifile, "name": os.path.basename(path)} for ifile, path in enumerate(self.files)]
+            return self.reply(200, json.dumps(files).encode(), "application/json", head)
+
+        if route == "/api/index":
+            path = self.output(query.get("file", [""])[0])
+            if path is None:
+                return self.reply(404, b"no such file")
+            index = self.index.get(path)
+            return self.reply(200, json.dumps(index["objects"]).encode(), "application/json", head)
+
+        if route.startswith("/files/"):
+            path = self.output(route[len("/files/"):])
+            if path is None:
+                return self.reply(404, b"no such file")
+            return self.ranges(path, head)
+
+        if re.fullmatch(r"/thumbs/[0-9a-f]{40}\.svg", route):
+            # thumbnail names change with their file, so they can be kept
+            return self.static(self.thumbs, route[len("/thumbs/"):], head, keep = True)
+
+        return self.reply(404, b"not found")
+
+    def do_HEAD(self):
+        return self.do_GET(head = True)
+
+    # -------------------------------------------------------------------------
+    #! Handle PUT (thumbnails rendered by the page)
+    # -------------------------------------------------------------------------
+    def do_PUT(self):
+        route  = unquote(urlparse(self.path).path)
+        length = int(self.headers.get("Content-Length", "0"))
+        if not re.fullmatch(r"/thumbs/[0-9a-f]{40}\.svg", route) or length > MAX_THUMB:
+            return self.reply(400, b"bad thumbnail")
+
+        path = os.path.join(self.thumbs, route[len("/thumbs/"):])
+        with open(path + ".tmp", "wb") as tfile:
+            tfile.write(self.rfile.read(length))
+        os.replace(path + ".tmp", path)
+        return self.reply(204)
+
+# end Handler
+
+
+
+# -----------------------------------------------------------------------------
+#! Serve outputs
+# -----------------------------------------------------------------------------
+def Serve(files, port = 8080, cache = ".phec-viewer"):
+    """Serves files on localhost until interrupted
+
+    Arguments:
+      files: output files to browse
+      port:  port to serve on
+      cache: where to keep indices and thumbnails
+    """
+    Handler.files  = [os.path.abspath(path) for path in files]
+    Handler.index  = FileIndex(cache)
+    Handler.thumbs = os.path.join(cache, "thumbs")
+    os.makedirs(Handler.thumbs, exist_ok = True)
+
+    if not os.path.isfile(os.path.join(JSROOT, "modules", "main.mjs")):
+        sys.stderr.write("WARNING: no JSROOT found in '" + JSROOT + "', set $JSROOTSYS or $ROOTSYS\n")
+
+    server = ThreadingHTTPServer(("127.0.0.1", port), Handler)
+    print("  Serving " + str(len(files)) + " files at http://localhost:" + str(port) + "/")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    server.server_close()
+
+# end 'Serve(list, int, str)'
+
+
+
+# main ========================================================================
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser(description = "Browse plotter outputs in a local browser")
+    parser.add_argument("files", nargs = "+", help = "output files to browse")
+    parser.add_argument("--port", type = int, default = 8080, help = "port to serve on")
+    parser.add_argument("--cache", default = ".phec-viewer", help = "where to keep indices and thumbnails")
+    args = parser.parse_args()
+
+    Serve(args.files, args.port, args.cache)
+
+# end =========================================================================